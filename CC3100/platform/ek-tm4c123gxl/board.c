@@ -45,6 +45,7 @@
 #include "driverlib/sysctl.h"
 #include "driverlib/fpu.h"
 #include "driverlib/uart.h"
+#include "driverlib/interrupt.h"
 #include "board.h"
 
 
@@ -117,6 +118,19 @@ void UnMaskIntHdlr()
 	IntIsMasked = FALSE;
 }
 
+unsigned char MaskAllInt(void)
+{
+	return IntMasterDisable() ? 1 : 0;
+}
+
+void RestoreAllInt(unsigned char Masked)
+{
+	if(!Masked)
+	{
+		IntMasterEnable();
+	}
+}
+
 void Delay(unsigned long interval)
 {
 	ROM_SysCtlDelay( (ROM_SysCtlClockGet()/(3*1000))*interval );
@@ -175,6 +175,28 @@ void MaskIntHdlr(void);
 */
 void UnMaskIntHdlr(void);
 
+/*!
+    \brief      Masks the processor interrupts
+
+	\param[in]      none
+
+    \return         non-zero if the interrupts were already masked
+
+    \warning
+*/
+unsigned char MaskAllInt(void);
+
+/*!
+    \brief      Restores the processor interrupt mask saved by MaskAllInt
+
+	\param[in]      Masked - value returned by MaskAllInt
+
+    \return         none
+
+    \warning
+*/
+void RestoreAllInt(unsigned char Masked);
+
 /*!
     \brief          GPIOB interrupt handler
 
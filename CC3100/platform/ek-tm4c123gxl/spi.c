@@ -49,12 +49,63 @@
 #include "driverlib/gpio.h"
 #include "driverlib/sysctl.h"
 #include "driverlib/interrupt.h"
+#include "driverlib/udma.h"
 
 
 
 #define ASSERT_CS()         GPIOPinWrite(GPIO_PORTE_BASE,GPIO_PIN_0, PIN_LOW)
 #define DEASSERT_CS()       GPIOPinWrite(GPIO_PORTE_BASE,GPIO_PIN_0, PIN_HIGH)
 
+/*
+ * Transfers of at least SPI_DMA_THRESHOLD bytes are moved by a uDMA TX/RX
+ * channel pair; shorter ones are moved by the CPU, keeping the SSI FIFO
+ * full.  Setting the threshold to 0 disables the uDMA path.
+ */
+#ifndef SPI_DMA_THRESHOLD
+#define SPI_DMA_THRESHOLD   64
+#endif
+
+/* Depth of the SSI transmit and receive FIFOs */
+#define SPI_FIFO_DEPTH      8
+
+/* Largest number of items in a single uDMA transfer */
+#define SPI_DMA_MAX_ITEMS   1024
+
+#define SPI_DMA_RX_CHANNEL  UDMA_CH12_SSI2RX
+#define SPI_DMA_TX_CHANNEL  UDMA_CH13_SSI2TX
+
+/* Start of SRAM, the only memory the uDMA controller can read */
+#define SPI_SRAM_BASE       0x20000000
+
+#define SPI_SR              HWREG(SSI2_BASE + SSI_O_SR)
+#define SPI_DR              HWREG(SSI2_BASE + SSI_O_DR)
+
+#if SPI_DMA_THRESHOLD
+/*
+ * uDMA control table, used only if the application has not already given
+ * the uDMA controller one.  The SSI2 channels are 12 and 13, so only the
+ * first 16 primary entries are needed.  No alternate entries are allocated:
+ * an application that uses other channels, or ping-pong or scatter-gather
+ * modes, must set up its own full table before spi_Open().
+ */
+#if defined(ewarm)
+#pragma data_alignment=1024
+static tDMAControlTable spi_DmaTable[16];
+#elif defined(ccs)
+#pragma DATA_ALIGN(spi_DmaTable, 1024)
+static tDMAControlTable spi_DmaTable[16];
+#else
+static tDMAControlTable spi_DmaTable[16] __attribute__ ((aligned(1024)));
+#endif
+
+/*
+ * Source of the idle bytes clocked out on reads, and sink for writes.  Both
+ * must be in SRAM since the uDMA controller cannot read flash.
+ */
+static unsigned char spi_DmaIdle = 0xFF;
+static unsigned char spi_DmaDummy;
+#endif
+
 
 int spi_Close(Fd_t fd)
 {
@@ -90,6 +141,23 @@ Fd_t spi_Open(char *ifName, unsigned long flags)
 
     SSIEnable(SSI2_BASE);
 
+#if SPI_DMA_THRESHOLD
+    /* Route uDMA channels 12 and 13 to SSI2 */
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+    uDMAEnable();
+    if(uDMAControlBaseGet() == 0)
+    {
+        uDMAControlBaseSet(spi_DmaTable);
+    }
+    uDMAChannelAssign(SPI_DMA_RX_CHANNEL);
+    uDMAChannelAssign(SPI_DMA_TX_CHANNEL);
+    uDMAChannelAttributeDisable(SPI_DMA_RX_CHANNEL, UDMA_ATTR_ALL);
+    uDMAChannelAttributeDisable(SPI_DMA_TX_CHANNEL, UDMA_ATTR_ALL);
+
+    /* Receive must win arbitration so the RX FIFO can never overflow */
+    uDMAChannelAttributeEnable(SPI_DMA_RX_CHANNEL, UDMA_ATTR_HIGH_PRIORITY);
+#endif
+
     /* configure host IRQ line */
     GPIOPinTypeGPIOInput(GPIO_PORTB_BASE, GPIO_PIN_2);
     GPIOPadConfigSet(GPIO_PORTB_BASE, GPIO_PIN_2, GPIO_STRENGTH_2MA,
@@ -110,41 +178,164 @@ Fd_t spi_Open(char *ifName, unsigned long flags)
 }
 
 
-int spi_Write(Fd_t fd, unsigned char *pBuff, int len)
+/*
+ * Discard anything left in the receive FIFO so that it stays in step with
+ * the bytes this transfer sends.
+ */
+static void spi_FlushRx(void)
 {
-    int len_to_return = len;
-    unsigned long ulDummy;
+    while(SPI_SR & SSI_SR_RNE)
+    {
+        (void)SPI_DR;
+    }
+}
 
-    ASSERT_CS();
+/*
+ * Move len bytes with the CPU.  Bytes are sent from pTx, or 0xFF if it is
+ * NULL, and received into pRx unless it is NULL.  Up to SPI_FIFO_DEPTH bytes
+ * are kept in flight, so the transmit FIFO never runs dry and the receive
+ * FIFO never overflows.
+ */
+static void spi_Burst(const unsigned char *pTx, unsigned char *pRx, int len)
+{
+    int tx = 0, rx = 0;
+    unsigned long ulData;
+
+    while(rx < len)
+    {
+        while((tx < len) && ((tx - rx) < SPI_FIFO_DEPTH) &&
+              (SPI_SR & SSI_SR_TNF))
+        {
+            SPI_DR = pTx ? pTx[tx] : 0xFF;
+            tx++;
+        }
+        while((rx < tx) && (SPI_SR & SSI_SR_RNE))
+        {
+            ulData = SPI_DR;
+            if(pRx)
+            {
+                pRx[rx] = (unsigned char)ulData;
+            }
+            rx++;
+        }
+    }
+}
+
+#if SPI_DMA_THRESHOLD
+/*
+ * Move len bytes with the uDMA controller, in the same way as spi_Burst().
+ * The receive channel completing means every byte has been clocked, so it is
+ * used as the completion signal.  pTx and pRx must be in SRAM.  Returns 0, or
+ * -1 if the uDMA controller reported a bus error.
+ */
+static int spi_Dma(const unsigned char *pTx, unsigned char *pRx, int len)
+{
+    int chunk;
+
+    SSIDMAEnable(SSI2_BASE, SSI_DMA_TX | SSI_DMA_RX);
 
     while(len)
     {
-        while(SSIDataPutNonBlocking(SSI2_BASE, (unsigned long)*pBuff) != TRUE);
-        while(SSIDataGetNonBlocking(SSI2_BASE, &ulDummy) != TRUE);
-        pBuff++;
-        len--;
+        chunk = (len > SPI_DMA_MAX_ITEMS) ? SPI_DMA_MAX_ITEMS : len;
+
+        uDMAChannelControlSet(SPI_DMA_RX_CHANNEL | UDMA_PRI_SELECT,
+                              UDMA_SIZE_8 | UDMA_SRC_INC_NONE |
+                              (pRx ? UDMA_DST_INC_8 : UDMA_DST_INC_NONE) |
+                              UDMA_ARB_4);
+        uDMAChannelTransferSet(SPI_DMA_RX_CHANNEL | UDMA_PRI_SELECT,
+                               UDMA_MODE_BASIC, (void *)(SSI2_BASE + SSI_O_DR),
+                               pRx ? (void *)pRx : (void *)&spi_DmaDummy,
+                               chunk);
+        uDMAChannelControlSet(SPI_DMA_TX_CHANNEL | UDMA_PRI_SELECT,
+                              UDMA_SIZE_8 |
+                              (pTx ? UDMA_SRC_INC_8 : UDMA_SRC_INC_NONE) |
+                              UDMA_DST_INC_NONE | UDMA_ARB_4);
+        uDMAChannelTransferSet(SPI_DMA_TX_CHANNEL | UDMA_PRI_SELECT,
+                               UDMA_MODE_BASIC,
+                               pTx ? (void *)pTx : (void *)&spi_DmaIdle,
+                               (void *)(SSI2_BASE + SSI_O_DR), chunk);
+
+        /* Arm receive first so that no incoming byte can be missed */
+        uDMAChannelEnable(SPI_DMA_RX_CHANNEL);
+        uDMAChannelEnable(SPI_DMA_TX_CHANNEL);
+
+        while(uDMAChannelIsEnabled(SPI_DMA_RX_CHANNEL))
+        {
+            /*
+             * A bus error stops the failing channel, which would leave the
+             * receive channel waiting forever.
+             */
+            if(uDMAErrorStatusGet())
+            {
+                uDMAErrorStatusClear();
+                uDMAChannelDisable(SPI_DMA_TX_CHANNEL);
+                uDMAChannelDisable(SPI_DMA_RX_CHANNEL);
+                SSIDMADisable(SSI2_BASE, SSI_DMA_TX | SSI_DMA_RX);
+                while(SPI_SR & SSI_SR_BSY);
+                spi_FlushRx();
+                return -1;
+            }
+        }
+
+        if(pTx)
+        {
+            pTx += chunk;
+        }
+        if(pRx)
+        {
+            pRx += chunk;
+        }
+        len -= chunk;
     }
-    DEASSERT_CS();
 
-    return len_to_return;
-}
+    SSIDMADisable(SSI2_BASE, SSI_DMA_TX | SSI_DMA_RX);
 
+    return 0;
+}
+#endif
 
-int spi_Read(Fd_t fd, unsigned char *pBuff, int len)
+/*
+ * Perform one chip-select framed transfer, choosing the CPU or the uDMA
+ * path by size.  Data to send from outside SRAM (a const buffer in flash)
+ * always goes through the CPU.  Returns len, or -1 on a uDMA error.
+ */
+static int spi_Transfer(const unsigned char *pTx, unsigned char *pRx, int len)
 {
-    int i = 0;
-    unsigned long ulBuff;
+    int ret = len;
 
     ASSERT_CS();
 
-    for(i=0; i< len; i++)
+    spi_FlushRx();
+
+#if SPI_DMA_THRESHOLD
+    if((len >= SPI_DMA_THRESHOLD) &&
+       ((pTx == NULL) || ((unsigned long)pTx >= SPI_SRAM_BASE)))
     {
-        while(SSIDataPutNonBlocking(SSI2_BASE, 0xFF) != TRUE);
-        while(SSIDataGetNonBlocking(SSI2_BASE, &ulBuff) != TRUE);
-        pBuff[i] = (unsigned char)ulBuff;
+        if(spi_Dma(pTx, pRx, len) != 0)
+        {
+            ret = -1;
+        }
     }
+    else
+#endif
+    {
+        spi_Burst(pTx, pRx, len);
+    }
+
     DEASSERT_CS();
 
-    return len;
+    return ret;
+}
+
+
+int spi_Write(Fd_t fd, unsigned char *pBuff, int len)
+{
+    return spi_Transfer(pBuff, NULL, len);
+}
+
+
+int spi_Read(Fd_t fd, unsigned char *pBuff, int len)
+{
+    return spi_Transfer(NULL, pBuff, len);
 }
 #endif /* SL_IF_TYPE_UART */
@@ -303,6 +303,52 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
 */
 #define SL_INC_SOCK_RECV_API
 
+/*!
+    \brief      Defines whether to include sl_RecvRingBuf in SimpleLink 
+                driver or not
+    
+                When defined, the SimpleLink driver will include also the 
+                receive API that reads socket data straight into a 
+                utils/ringbuf ring buffer
+
+    \sa         sl_RecvRingBuf
+
+    \note       belongs to \ref porting_sec
+
+    \warning    utils/ringbuf.c must be linked with the application
+*/
+/* #define SL_INC_RINGBUF_RECV */
+
+/*!
+    \brief      Defines whether sl_NetAppDnsGetHostByName answers repeated 
+                lookups from a host side cache or not
+    
+                When defined, resolved names (and names the DNS server 
+                failed to resolve) are kept for a time and are refreshed 
+                in the background before they expire. The cache size and 
+                times can be set with SL_DNS_CACHE_SIZE, SL_DNS_CACHE_TTL, 
+                SL_DNS_CACHE_NEG_TTL and SL_DNS_CACHE_REFRESH
+
+    \sa         sl_NetAppDnsGetHostByName, sl_DnsCacheTime
+
+    \note       belongs to \ref porting_sec
+
+    \warning    sl_DnsCacheTime must be defined as well
+*/
+/* #define SL_INC_DNS_CACHE */
+
+/*!
+    \brief      Returns a free running count of seconds, used for the 
+                expiry of DNS cache entries
+
+    \sa         SL_INC_DNS_CACHE
+
+    \note       belongs to \ref porting_sec
+
+    \warning    Only needed when SL_INC_DNS_CACHE is defined
+*/
+/* #define sl_DnsCacheTime()          (g_ulSeconds) */
+
 /*!
     \brief      Defines whether to include socket send APIs in SimpleLink 
                 driver or not
@@ -576,6 +622,34 @@ typedef P_EVENT_HANDLER                         SL_P_EVENT_HANDLER;
 #else
 #define sl_IfUnMaskIntHdlr     UnMaskIntHdlr
 #endif
+
+/*!
+    \brief 		Masks the interrupts that may call sl_Spawn (the Host IRQ)
+
+    \return		non-zero if the interrupts were already masked, to be
+                passed to sl_NonOsIntRestore
+
+    \sa		sl_NonOsIntRestore
+
+    \note       belongs to \ref porting_sec
+
+    \warning    Only used by the non-OS spawn queue, which is filled both
+                from the Host IRQ and from the main context
+*/
+#define sl_NonOsIntMask         MaskAllInt
+
+/*!
+    \brief 		Restores the interrupt mask saved by sl_NonOsIntMask
+
+    \param		Masked	-	value returned by sl_NonOsIntMask
+
+    \sa		sl_NonOsIntMask
+
+    \note       belongs to \ref porting_sec
+
+    \warning
+*/
+#define sl_NonOsIntRestore      RestoreAllInt
  
 /*!
     \brief 		Write Handers for statistics debug on write 
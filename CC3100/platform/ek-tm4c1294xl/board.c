@@ -48,6 +48,7 @@ uint32_t g_ui32SysClock;
 #include "driverlib/sysctl.h"
 #include "driverlib/fpu.h"
 #include "driverlib/uart.h"
+#include "driverlib/interrupt.h"
 //#include "board.h"
 
 
@@ -134,6 +135,19 @@ void UnMaskIntHdlr()
 	IntIsMasked = FALSE;
 }
 
+unsigned char MaskAllInt(void)
+{
+	return IntMasterDisable() ? 1 : 0;
+}
+
+void RestoreAllInt(unsigned char Masked)
+{
+	if(!Masked)
+	{
+		IntMasterEnable();
+	}
+}
+
 void Delay(unsigned long interval)
 {
 	ROM_SysCtlDelay( ( g_ui32SysClock / (3*1000) ) * interval );
@@ -255,6 +255,16 @@ typedef struct
 /********************************************************************************************************/
 
 
+/* sl_NetAppDnsGetHostByName cache counters, see SL_INC_DNS_CACHE */
+typedef struct
+{
+    unsigned long   Hits;           /* answered from the cache with an address          */
+    unsigned long   NegativeHits;   /* answered from the cache with a DNS error         */
+    unsigned long   Misses;         /* sent to the DNS server                           */
+    unsigned long   Refreshes;      /* entries renewed in the background before expiry  */
+    unsigned long   Evictions;      /* live entries replaced by another name            */
+}SlDnsCacheStats_t;
+
 /* NetApp application IDs */
 #define SL_NET_APP_HTTP_SERVER_ID                (1)
 #define SL_NET_APP_DHCP_SERVER_ID                (2)
@@ -382,6 +392,10 @@ int sl_NetAppStop(unsigned long AppBitMap);
             2. There are not enough resources and POOL_IS_EMPTY error will return. 
             In this case, MAX_CONCURRENT_ACTIONS can be increased (result in memory increase) or try
             again later to issue the command.
+            When SL_INC_DNS_CACHE is defined, resolved names are kept for SL_DNS_CACHE_TTL seconds
+            and names the server failed to resolve (SL_NET_APP_DNS_QUERY_FAILED) for
+            SL_DNS_CACHE_NEG_TTL seconds, and repeated lookups are answered without a command
+            to the device. A hit close to expiry starts a refresh in the background.
     \warning
     \par  Example:
     \code
@@ -399,6 +413,40 @@ int sl_NetAppStop(unsigned long AppBitMap);
 int sl_NetAppDnsGetHostByName(char * hostname, unsigned short usNameLen, unsigned long* out_ip_addr,unsigned char family );
 #endif
 
+#ifdef SL_INC_DNS_CACHE
+/*!
+    \brief Flush the DNS cache
+
+    Drop all names cached by sl_NetAppDnsGetHostByName, so the next lookup
+    of each name is sent to the DNS server
+
+    \return                     None
+
+    \sa                         sl_NetAppDnsGetHostByName
+    \note                       A background refresh in flight still completes,
+                                but its answer is not cached
+    \warning
+*/
+#if _SL_INCLUDE_FUNC(sl_NetAppDnsCacheFlush)
+void sl_NetAppDnsCacheFlush(void);
+#endif
+
+/*!
+    \brief Get the DNS cache counters
+
+    \param[out] pStats          filled in with the cache counters since sl_Start
+
+    \return                     None
+
+    \sa                         sl_NetAppDnsGetHostByName
+    \note
+    \warning
+*/
+#if _SL_INCLUDE_FUNC(sl_NetAppDnsCacheStatsGet)
+void sl_NetAppDnsCacheStatsGet(SlDnsCacheStats_t *pStats);
+#endif
+#endif
+
 
 /*!
         \brief Return service attributes like IP address, port and text according to service name
@@ -40,6 +40,10 @@
 #ifndef __SL_SOCKET_H__
 #define __SL_SOCKET_H__
 
+#ifdef SL_INC_RINGBUF_RECV
+#include "utils/ringbuf.h"
+#endif
+
 #ifdef    __cplusplus
 extern "C" {
 #endif
@@ -256,6 +260,7 @@ extern "C" {
 #define SL_SEC_MASK_SECURE_DEFAULT                         ((SEC_MASK_TLS_ECDHE_RSA_WITH_RC4_128_SHA  <<  1)  -  1)
 
 #define SL_MSG_DONTWAIT         0x00000008  /* Nonblocking IO */
+#define SL_MSG_MORE             0x00000100  /* sl_Send: more data follows, hold it to send with the next write */
 
 #define SL_NETAPP_IPV4_ACQUIRED    1
 #define SL_NETAPP_IPV6_ACQUIRED    2
@@ -442,6 +447,24 @@ typedef struct
     SlInAddr_t imr_interface;     /* The interface to use for this group. */
 } SlSockIpMreq;
 
+/* sl_Poll events */
+#define SL_POLLIN                              (0x01)                    /* Read (or accept) returns without delay                              */
+#define SL_POLLOUT                             (0x02)                    /* Write returns without delay                                         */
+#define SL_POLLERR                             (0x04)                    /* A previous send on the socket failed                                */
+
+typedef struct
+{
+    short               sd;               /* socket handle                       */
+    unsigned short      Events;           /* SL_POLLIN | SL_POLLOUT | SL_POLLERR  */
+}SlPollEvent_t;
+
+/* receive scatter segment, filled in order by sl_RecvVec */
+typedef struct
+{
+    unsigned char       *pBuf;            /* start of the segment                */
+    unsigned short      Len;              /* segment length in bytes (may be 0)  */
+}SlRecvSeg_t;
+
 
 /* sockopt */
 
@@ -878,6 +901,66 @@ int  SL_FD_ISSET(int fd, SlFdSet_t *fdset);
 */
 void SL_FD_ZERO(SlFdSet_t *fdset);
 
+/*!
+    \brief Register socket events for sl_Poll
+   
+    Sets the events sl_Poll watches on a socket, replacing the previous ones.
+    The current state of the socket is reported again on the next sl_Poll.
+   
+    \param[in]  sd          socket handle
+    \param[in]  Events      SL_POLLIN and/or SL_POLLOUT, 0 stops watching the socket.
+                            SL_POLLERR is always watched on a watched socket.
+   
+    \return                 Zero on success, or negative error code on failure
+   
+    \sa     sl_Poll
+    \note   sl_Close stops watching the socket
+            belongs to \ref basic_api
+*/
+int sl_PollCtl(int sd, unsigned short Events);
+
+/*!
+    \brief Wait for socket events
+   
+    Returns the watched sockets that became ready since the last sl_Poll
+    (edge triggered, as EPOLLET). Readiness known to the host is returned 
+    without any transaction with the device: sockets reported ready by a
+    previous select stay ready until they are read, accepted on, sent on or closed,
+    and send failures are known from every message of the device. Only 
+    when nothing new is known, one sl_Select is issued for all the watched
+    sockets that are not ready yet.
+   
+    \param[out] pEvents     array filled with the sockets that became ready
+    \param[in]  MaxEvents   size of the pEvents array
+    \param[in]  timeout     timeout of the sl_Select, if one is needed.
+                            Null means infinity timeout.
+   
+    \return                 number of entries filled in pEvents, zero on timeout,
+                            or a negative error code
+   
+    \sa     sl_PollCtl sl_Select
+    \note   belongs to \ref basic_api
+    \par        Example:
+    \code       A gateway serving several connections:
+    
+                SlPollEvent_t Ev[4];
+                int n, i;
+
+                sl_PollCtl(SockA, SL_POLLIN);
+                sl_PollCtl(SockB, SL_POLLIN);
+                while(1)
+                {
+                    n = sl_Poll(Ev, 4, NULL);
+                    for(i = 0; i < n; i++)
+                    {
+                        sl_Recv(Ev[i].sd, Buf, sizeof(Buf), 0);
+                    }
+                }
+
+    \endcode
+*/
+int sl_Poll(SlPollEvent_t *pEvents, int MaxEvents, struct SlTimeval_t *timeout);
+
 
 
 #endif
@@ -1190,6 +1273,78 @@ int sl_GetSockOpt(int sd, int level, int optname, void *optval, SlSocklen_t *opt
 int sl_Recv(int sd, void *buf, int Len, int flags);
 #endif
 
+/*!
+    \brief read data from TCP socket into a list of buffers
+     
+    function receives a message from a connection-mode socket, like
+    sl_Recv, but the data is read from the device straight into the
+    given segments, filling them in order. This allows receiving into
+    a ring buffer (whose free space is made of up to two contiguous
+    areas) or into separate header and body buffers with no extra copy.
+     
+    \param[in]  sd              socket handle
+    \param[in]  pSegs           Points to an array of segments where the
+                                message should be stored.
+    \param[in]  NumSegs         Number of segments in the array.
+                                Range: 1-255
+    \param[in]  flags           Specifies the type of message 
+                                reception. On this version, this parameter is not
+                                supported.
+    
+    \return                     return the number of bytes received, 
+                                or a negative value if an error occurred.
+                                using a non-blocking recv a possible negative value is SL_EAGAIN.
+                                SL_POOL_IS_EMPTY may be return in case there are no resources in the system
+                                 In this case try again later or increase MAX_CONCURRENT_ACTIONS
+    
+    \sa     sl_Recv
+    \note                       belongs to \ref recv_api
+    \warning
+    \par        Example:
+    \code       Receiving a header and a body into separate buffers:
+    
+                SlRecvSeg_t Segs[2];
+
+                Segs[0].pBuf = Hdr;
+                Segs[0].Len = sizeof(Hdr);
+                Segs[1].pBuf = Body;
+                Segs[1].Len = sizeof(Body);
+                Status = sl_RecvVec(SockID, Segs, 2, 0);
+
+    \endcode
+*/
+#if _SL_INCLUDE_FUNC(sl_RecvVec)
+int sl_RecvVec(int sd, SlRecvSeg_t *pSegs, int NumSegs, int flags);
+#endif
+
+#ifdef SL_INC_RINGBUF_RECV
+/*!
+    \brief read data from TCP socket into a ring buffer
+     
+    function receives a message from a connection-mode socket straight
+    into the free space of a utils/ringbuf ring buffer, and advances the
+    ring's write index by the number of bytes received.
+     
+    \param[in]  sd              socket handle
+    \param[in]  psRingBuf       Points to the ring buffer to fill.
+    \param[in]  flags           Specifies the type of message 
+                                reception. On this version, this parameter is not
+                                supported.
+    
+    \return                     return the number of bytes received, 
+                                or a negative value if an error occurred.
+                                If the ring buffer is full, SL_RET_CODE_INVALID_INPUT
+                                is returned and the socket is not read.
+    
+    \sa     sl_RecvVec
+    \note                       belongs to \ref recv_api
+    \warning
+*/
+#if _SL_INCLUDE_FUNC(sl_RecvVec)
+int sl_RecvRingBuf(int sd, tRingBufObject *psRingBuf, int flags);
+#endif
+#endif
+
 /*!
     \brief read data from socket
     
@@ -1268,6 +1423,10 @@ int sl_RecvFrom(int sd, void *buf, int Len, int flags, SlSockAddr_t *from, SlSoc
                                 supported for TCP.
                                 For transceiver mode, the SL_RAW_RF_TX_PARAMS macro can be used to determine
                                 transmission parameters (channel,rate,tx_power,preamble)
+                                With SL_MSG_MORE, a short message is only copied to the 
+                                driver and sent together with the next sl_Send on this 
+                                socket that has no SL_MSG_MORE (or by sl_Close), as a 
+                                single message to the device.
     
     
     \return                     Return the number of bytes transmitted, 
@@ -1294,6 +1453,13 @@ int sl_RecvFrom(int sd, void *buf, int Len, int flags, SlSockAddr_t *from, SlSoc
                 Status = sl_Send(SockID, Buf, 1460, 0 );
  
     \endcode
+    \code       Coalescing small writes into one message:
+
+                sl_Send(SockID, Hdr, HdrLen, SL_MSG_MORE);
+                sl_Send(SockID, Sample, SampleLen, SL_MSG_MORE);
+                sl_Send(SockID, Trailer, TrailerLen, 0);
+
+    \endcode
  */ 
 #if _SL_INCLUDE_FUNC(sl_Send )
 int sl_Send(int sd, const void *buf, int Len, int flags);
@@ -163,12 +163,69 @@ extern "C" {
 
 //#define SL_DBG_CNT_ENABLE
 #ifdef SL_DBG_CNT_ENABLE
-#define _SL_DBG_CNT_INC(Cnt)            g_DbgCnt. ## Cnt++
+#define SL_DBG_SYNC_LOG_SIZE            (16)
+
+typedef struct
+{
+    struct
+    {
+        UINT32 Write;
+        UINT32 Read;
+    }MsgCnt;
+
+    struct
+    {
+        UINT32 DoubleSyncPattern;
+    }Work;
+
+    /* N2H sync pattern scanning in _SlDrvRxHdrRead */
+    struct
+    {
+        UINT32 Headers;         /* response headers read */
+        UINT32 Scans;           /* headers whose sync was not in the first 4 bytes */
+        UINT32 ScanReads;       /* extra interface reads made while scanning */
+        UINT32 SkippedBytes;    /* bytes discarded ahead of the sync pattern */
+    }Sync;
+
+    /* pool objects, _SlDrvWaitForPoolObj / _SlDrvReleasePoolObj */
+    struct
+    {
+        UINT32 Empty;           /* requests refused, no free object */
+        UINT32 Waits;           /* times an action queued behind another one on its socket/action */
+        UINT32 Wakeups;         /* queued actions woken on release */
+        UINT32 LockHolds;       /* ProtectionLockObj holds measured */
+        UINT32 LockHoldTotal;   /* sum of hold times, in sl_DbgTimestamp() ticks */
+        UINT32 LockHoldMax;
+        UINT32 LockStart;
+    }Pool;
+
+    UINT32 SyncLog[SL_DBG_SYNC_LOG_SIZE];
+}_SlDbgCnt_t;
+
+extern _SlDbgCnt_t g_DbgCnt;
+
+#define _SL_DBG_CNT_INC(Cnt)            g_DbgCnt.Cnt++
+#define _SL_DBG_CNT_ADD(Cnt,Val)        g_DbgCnt.Cnt += (Val)
 #define _SL_DBG_SYNC_LOG(index,value)   {if(index < SL_DBG_SYNC_LOG_SIZE){*(UINT32 *)&g_DbgCnt.SyncLog[index] = *(UINT32 *)(value);}}
 
+/* free running counter for the lock hold times, may be defined in user.h */
+#ifndef sl_DbgTimestamp
+#define sl_DbgTimestamp()               (0)
+#endif
+
+/* to be used right after taking and right before giving ProtectionLockObj */
+#define _SL_DBG_LOCK_TAKEN()            g_DbgCnt.Pool.LockStart = sl_DbgTimestamp()
+#define _SL_DBG_LOCK_GIVING()           { UINT32 _Hold = sl_DbgTimestamp() - g_DbgCnt.Pool.LockStart; \
+                                          g_DbgCnt.Pool.LockHolds++; \
+                                          g_DbgCnt.Pool.LockHoldTotal += _Hold; \
+                                          if(_Hold > g_DbgCnt.Pool.LockHoldMax){g_DbgCnt.Pool.LockHoldMax = _Hold;} }
+
 #else
 #define _SL_DBG_CNT_INC(Cnt)
+#define _SL_DBG_CNT_ADD(Cnt,Val)
 #define _SL_DBG_SYNC_LOG(index,value)
+#define _SL_DBG_LOCK_TAKEN()
+#define _SL_DBG_LOCK_GIVING()
 #endif
 
 #define SL_DBG_LEVEL_1                  1
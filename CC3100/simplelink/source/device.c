@@ -89,6 +89,11 @@ int sl_Start(const void* pIfHdl, char* pDevName, const P_INIT_CALLBACK pInitCall
   
     /* callback init */
     _SlDrvDriverCBInit();
+    _sl_SocketReset();
+#if (defined(SL_INC_DNS_CACHE)) && _SL_INCLUDE_FUNC(sl_NetAppDnsGetHostByName)
+    /* the cache and its statistics start empty with every sl_Start */
+    _sl_DnsCacheReset();
+#endif
 
     /* open the interface: usually SPI or UART */
     if (NULL == pIfHdl)
@@ -239,6 +244,12 @@ int sl_Stop(unsigned short timeout)
       sl_DeviceDisable();
       sl_IfClose(g_pCB->FD);
     }
+#if (defined(SL_INC_DNS_CACHE)) && _SL_INCLUDE_FUNC(sl_NetAppDnsGetHostByName)
+    /* the pool object of a refresh in flight is gone with the driver control block */
+    _sl_DnsCacheReset();
+#endif
+    /* the socket IDs are handed out again after the next sl_Start */
+    _sl_SocketReset();
     _SlDrvDriverCBDeinit();
 
     return RetVal;
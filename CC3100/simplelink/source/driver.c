@@ -48,16 +48,17 @@ _SlReturnVal_t   _SlDrvMsgReadCmdCtx(void);
 _SlReturnVal_t   _SlDrvMsgReadSpawnCtx(void *pValue);
 void             _SlDrvClassifyRxMsg(_SlOpcode_t Opcode );
 _SlReturnVal_t   _SlDrvRxHdrRead(UINT8 *pBuf, UINT8 *pAlignSize);
-void             _SlDrvShiftDWord(UINT8 *pBuf);
 void             _SlDrvDriverCBInit(void);
 void             _SlAsyncEventGenericHandler(void);
 int				 _SlDrvWaitForPoolObj(UINT32 ActionID, UINT8 SocketID);
 void			 _SlDrvReleasePoolObj(UINT8 pObj);
 void			 _SlDrvObjInit(void);
 void			 _SlDrvObjDeInit(void);
-void			 _SlRemoveFromList(UINT8* ListIndex, UINT8 ItemIndex);
 _SlReturnVal_t	 _SlFindAndSetActiveObj(_SlOpcode_t  Opcode, UINT8 Sd);
 _SlDriverCb_t* g_pCB = NULL;
+#ifdef SL_DBG_CNT_ENABLE
+_SlDbgCnt_t g_DbgCnt;
+#endif
 P_SL_DEV_PING_CALLBACK  pPingCallBackFunc = NULL;
 
 const _SlSyncPattern_t g_H2NSyncPattern = H2N_SYNC_PATTERN;
@@ -94,6 +95,28 @@ const _SlActionLookup_t _SlActionLookupTable[7] =
                  ( !(*((UINT32 *)pBuf) & N2H_SYNC_PATTERN_SEQ_NUM_EXISTS) && ( MATCH_WOUT_SEQ_NUM(pBuf          ) ) )	   \
             )
 
+/*  While hunting for the sync pattern, the bytes are read N2H_SYNC_SCAN_CHUNK at a time
+    into a window that keeps the last 3 bytes of the previous read, so a pattern split
+    across reads is still found. The chunk is kept small enough that the bytes read past
+    the pattern always fall inside the response header, never in the payload */
+#define N2H_SYNC_SCAN_CHUNK                      (2*SYNC_PATTERN_LEN)
+#define N2H_SYNC_SCAN_CARRY                      (SYNC_PATTERN_LEN - 1)
+#define N2H_SYNC_SCAN_WINDOW                     (N2H_SYNC_SCAN_CARRY + N2H_SYNC_SCAN_CHUNK)
+/*  Byte 2 of the pattern is touched neither by the SPI bugs mask nor by the sequence
+    number, so it is used to pick candidate offsets four at a time */
+#define N2H_SYNC_KEY_BYTE                        ((UINT8)(N2H_SYNC_SPIM >> 16))
+#define BUF_LE_DWORD(pBuf)                       ( (UINT32)(pBuf)[0] | ((UINT32)(pBuf)[1] << 8) | ((UINT32)(pBuf)[2] << 16) | ((UINT32)(pBuf)[3] << 24) )
+
+/*  Messages (or leading parts of them) up to this size are assembled in g_TxGatherBuf
+    and written to the interface at once, instead of one transaction per part.
+    Must be a multiple of 4 */
+#ifndef SL_TX_GATHER_SIZE
+#define SL_TX_GATHER_SIZE                        (64)
+#endif
+
+/*  Only used by _SlDrvMsgWrite, which is always called with GlobalLockObj held */
+static UINT32 g_TxGatherBuf[SL_TX_GATHER_SIZE / 4];
+
 #if (SL_MEMORY_MGMT == SL_MEMORY_MGMT_STATIC)
 typedef struct
 {
@@ -128,6 +151,8 @@ void _SlDrvDriverCBInit(void)
     OSI_RET_OK_CHECK( sl_LockObjCreate(&g_pCB->GlobalLockObj, "GlobalLockObj") );
 
 	OSI_RET_OK_CHECK( sl_LockObjCreate(&g_pCB->ProtectionLockObj, "ProtectionLockObj") );
+
+	OSI_RET_OK_CHECK( sl_LockObjCreate(&g_pCB->CoalesceLockObj, "CoalesceLockObj") );
 	
 	_SlDrvObjInit();
 
@@ -153,6 +178,8 @@ void _SlDrvDriverCBDeinit()
     OSI_RET_OK_CHECK( sl_LockObjDelete(&g_pCB->GlobalLockObj) );
 
 	OSI_RET_OK_CHECK( sl_LockObjDelete(&g_pCB->ProtectionLockObj) );
+
+	OSI_RET_OK_CHECK( sl_LockObjDelete(&g_pCB->CoalesceLockObj) );
     for (Idx = 0; Idx < MAX_CONCURRENT_ACTIONS; Idx++)
     {
 		OSI_RET_OK_CHECK( sl_SyncObjDelete(&g_pCB->ObjPool[Idx].SyncObj) );   
@@ -256,6 +283,30 @@ _SlReturnVal_t _SlDrvDataReadOp(
     _SlCmdCtrl_t        *pCmdCtrl ,
     void                *pTxRxDescBuff ,
     _SlCmdExt_t         *pCmdExt)
+{
+    SlRecvSeg_t Seg;
+
+    /* A flat receive buffer is a scatter list of one segment */
+    Seg.pBuf = pCmdExt->pRxPayload;
+    Seg.Len = pCmdExt->RxPayloadLen;
+
+    return _SlDrvDataReadVecOp(Sd, pCmdCtrl, pTxRxDescBuff, pCmdExt, &Seg, 1);
+}
+
+/*****************************************************************************
+  _SlDrvDataReadVecOp
+
+  Same as _SlDrvDataReadOp, but the payload is read from the interface
+  straight into the caller's segments. pCmdExt->RxPayloadLen must not exceed
+  the total length of the segments.
+*****************************************************************************/
+_SlReturnVal_t _SlDrvDataReadVecOp(
+    _SlSd_t             Sd,
+    _SlCmdCtrl_t        *pCmdCtrl ,
+    void                *pTxRxDescBuff ,
+    _SlCmdExt_t         *pCmdExt,
+    SlRecvSeg_t         *pSegs,
+    UINT8               NumSegs)
 {
     _SlReturnVal_t RetVal;
 	UINT8 pObjIdx = MAX_CONCURRENT_ACTIONS;
@@ -263,6 +314,7 @@ _SlReturnVal_t _SlDrvDataReadOp(
     
     /* Validate input arguments */
     VERIFY_PROTOCOL(NULL != pCmdExt->pRxPayload);
+    VERIFY_PROTOCOL((NULL != pSegs) && (0 != NumSegs));
 
     /* If zero bytes is requested, return error. */
     /*  This allows us not to fill remote socket's IP address in return arguments */
@@ -280,6 +332,8 @@ _SlReturnVal_t _SlDrvDataReadOp(
 
 	pArgsData.pData = pCmdExt->pRxPayload;
 	pArgsData.pArgs =  (UINT8 *)pTxRxDescBuff;
+	pArgsData.pSegs = pSegs;
+	pArgsData.NumSegs = NumSegs;
 	g_pCB->ObjPool[pObjIdx].pRespArgs =  (UINT8 *)&pArgsData;
     OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj));
 
@@ -399,8 +453,37 @@ _SlReturnVal_t _SlDrvDataWriteOp(
 /* ******************************************************************************/
 /*  _SlDrvMsgWrite */
 /* ******************************************************************************/
+/*  Gather one part of an outgoing message. Small parts are copied to g_TxGatherBuf
+    so that the sync pattern, header, descriptors and a short payload go out in a
+    single interface transaction; a part that does not fit is written directly,
+    after whatever was gathered before it */
+static _SlReturnVal_t _SlDrvTxGather(UINT8 *pPart, UINT16 Len, UINT16 *pFill)
+{
+    if ((*pFill + Len) > SL_TX_GATHER_SIZE)
+    {
+        if (*pFill > 0)
+        {
+            NWP_IF_WRITE_CHECK(g_pCB->FD, (unsigned char *)g_TxGatherBuf, *pFill);
+            *pFill = 0;
+        }
+
+        if (Len > SL_TX_GATHER_SIZE)
+        {
+            NWP_IF_WRITE_CHECK(g_pCB->FD, pPart, Len);
+            return SL_RET_CODE_OK;
+        }
+    }
+
+    sl_Memcpy((UINT8 *)g_TxGatherBuf + *pFill, pPart, Len);
+    *pFill += Len;
+
+    return SL_RET_CODE_OK;
+}
+
 _SlReturnVal_t _SlDrvMsgWrite(void)
 {
+    UINT16 TxFill = 0;
+
     VERIFY_PROTOCOL(NULL != g_pCB->FunctionParams.pCmdCtrl);
 
     g_pCB->TempProtocolHeader.Opcode 	= g_pCB->FunctionParams.pCmdCtrl->Opcode;
@@ -418,20 +501,20 @@ _SlReturnVal_t _SlDrvMsgWrite(void)
 	
 #ifdef SL_IF_TYPE_UART
 	/*  Write long sync pattern */
-    NWP_IF_WRITE_CHECK(g_pCB->FD, (unsigned char *)&g_H2NSyncPattern.Long, 2*SYNC_PATTERN_LEN);
+    VERIFY_RET_OK(_SlDrvTxGather((UINT8 *)&g_H2NSyncPattern.Long, 2*SYNC_PATTERN_LEN, &TxFill));
 #else
 	/*  Write short sync pattern */
-	NWP_IF_WRITE_CHECK(g_pCB->FD, (unsigned char *)&g_H2NSyncPattern.Short, SYNC_PATTERN_LEN);
+	VERIFY_RET_OK(_SlDrvTxGather((UINT8 *)&g_H2NSyncPattern.Short, SYNC_PATTERN_LEN, &TxFill));
 #endif
 
     /*  Header */
-    NWP_IF_WRITE_CHECK(g_pCB->FD, (unsigned char *)&g_pCB->TempProtocolHeader, _SL_CMD_HDR_SIZE);
+    VERIFY_RET_OK(_SlDrvTxGather((UINT8 *)&g_pCB->TempProtocolHeader, _SL_CMD_HDR_SIZE, &TxFill));
 
     /*  Descriptors */
     if (g_pCB->FunctionParams.pTxRxDescBuff && g_pCB->FunctionParams.pCmdCtrl->TxDescLen > 0)
     {
-    	NWP_IF_WRITE_CHECK(g_pCB->FD, g_pCB->FunctionParams.pTxRxDescBuff, 
-                           _SL_PROTOCOL_ALIGN_SIZE(g_pCB->FunctionParams.pCmdCtrl->TxDescLen));
+    	VERIFY_RET_OK(_SlDrvTxGather(g_pCB->FunctionParams.pTxRxDescBuff, 
+                                     _SL_PROTOCOL_ALIGN_SIZE(g_pCB->FunctionParams.pCmdCtrl->TxDescLen), &TxFill));
     }
 
 	/*  A special mode where Rx payload and Rx length are used as Tx as well */
@@ -440,8 +523,8 @@ _SlReturnVal_t _SlDrvMsgWrite(void)
     if (g_pCB->RelayFlagsViaRxPayload == TRUE )
     {
         g_pCB->RelayFlagsViaRxPayload = FALSE;
-     	NWP_IF_WRITE_CHECK(g_pCB->FD, g_pCB->FunctionParams.pCmdExt->pRxPayload, 
-                           _SL_PROTOCOL_ALIGN_SIZE(g_pCB->FunctionParams.pCmdExt->RxPayloadLen));
+     	VERIFY_RET_OK(_SlDrvTxGather(g_pCB->FunctionParams.pCmdExt->pRxPayload, 
+                                     _SL_PROTOCOL_ALIGN_SIZE(g_pCB->FunctionParams.pCmdExt->RxPayloadLen), &TxFill));
     }
 	
     /*  Payload */
@@ -451,10 +534,15 @@ _SlReturnVal_t _SlDrvMsgWrite(void)
         /*  Otherwise the alignning of arguments will create a gap between argumants and payload. */
         VERIFY_PROTOCOL(_SL_IS_PROTOCOL_ALIGNED_SIZE(g_pCB->FunctionParams.pCmdCtrl->TxDescLen));
 
-    	NWP_IF_WRITE_CHECK(g_pCB->FD, g_pCB->FunctionParams.pCmdExt->pTxPayload, 
-                           _SL_PROTOCOL_ALIGN_SIZE(g_pCB->FunctionParams.pCmdExt->TxPayloadLen));
+    	VERIFY_RET_OK(_SlDrvTxGather(g_pCB->FunctionParams.pCmdExt->pTxPayload, 
+                                     _SL_PROTOCOL_ALIGN_SIZE(g_pCB->FunctionParams.pCmdExt->TxPayloadLen), &TxFill));
     }
 
+    /*  Write whatever is still gathered */
+    if (TxFill > 0)
+    {
+        NWP_IF_WRITE_CHECK(g_pCB->FD, (unsigned char *)g_TxGatherBuf, TxFill);
+    }
 
     _SL_DBG_CNT_INC(MsgCnt.Write);
 
@@ -465,6 +553,65 @@ _SlReturnVal_t _SlDrvMsgWrite(void)
     return SL_OS_RET_CODE_OK;
 }
 
+/* ******************************************************************************/
+/*  _SlDrvRecvScatter */
+/* ******************************************************************************/
+/*  Read Len bytes of Recv payload from the interface straight into the caller's
+    segments. Only 4 bytes aligned blocks are read directly; whenever less than
+    4 bytes are left in a segment or in the payload, one word is read into a
+    TailBuffer and spread over the segment end and the next segment start */
+static _SlReturnVal_t _SlDrvRecvScatter(_SlArgsData_t *pArgsData, UINT16 Len)
+{
+    SlRecvSeg_t *pSeg = pArgsData->pSegs;
+    SlRecvSeg_t *pSegEnd = pArgsData->pSegs + pArgsData->NumSegs;
+    UINT8       TailBuffer[4];
+    UINT16      Offset = 0;
+    UINT16      AlignedLengthRecv;
+    UINT8       Idx;
+
+    while(Len > 0)
+    {
+        /* skip filled (or empty) segments */
+        while(Offset == pSeg->Len)
+        {
+            pSeg++;
+            Offset = 0;
+            VERIFY_PROTOCOL(pSeg < pSegEnd);
+        }
+
+        AlignedLengthRecv = (pSeg->Len - Offset);
+        if(AlignedLengthRecv > Len)
+        {
+            AlignedLengthRecv = Len;
+        }
+        AlignedLengthRecv &= (~3);
+
+        if(AlignedLengthRecv >= 4)
+        {
+            NWP_IF_READ_CHECK(g_pCB->FD, pSeg->pBuf + Offset, AlignedLengthRecv);
+            Offset += AlignedLengthRecv;
+            Len -= AlignedLengthRecv;
+        }
+        else
+        {
+            NWP_IF_READ_CHECK(g_pCB->FD, TailBuffer, 4);
+            for(Idx = 0; (Idx < 4) && (Len > 0); Idx++)
+            {
+                while(Offset == pSeg->Len)
+                {
+                    pSeg++;
+                    Offset = 0;
+                    VERIFY_PROTOCOL(pSeg < pSegEnd);
+                }
+                pSeg->pBuf[Offset++] = TailBuffer[Idx];
+                Len--;
+            }
+        }
+    }
+
+    return SL_RET_CODE_OK;
+}
+
 /* ******************************************************************************/
 /*  _SlDrvMsgRead  */
 /* ******************************************************************************/
@@ -609,22 +756,8 @@ _SlReturnVal_t _SlDrvMsgRead(void)
                 {       
 					VERIFY_SOCKET_CB(NULL != ((_SlArgsData_t *)(g_pCB->ObjPool[g_pCB->FunctionParams.AsyncExt.ActionIndex].pRespArgs))->pData);
                     
-                    /*  Read 4 bytes aligned from interface */
-                    /*  therefore check the requested length and read only  */
-                    /*  4 bytes aligned data. The rest unaligned (if any) will be read */
-                    /*  and copied to a TailBuffer  */
-                    LengthToCopy = ACT_DATA_SIZE(&uBuf.TempBuf[4]) & (3);
-                    AlignedLengthRecv = ACT_DATA_SIZE(&uBuf.TempBuf[4]) & (~3);
-                    if( AlignedLengthRecv >= 4)
-                    {
-                    NWP_IF_READ_CHECK(g_pCB->FD,((_SlArgsData_t *)(g_pCB->ObjPool[g_pCB->FunctionParams.AsyncExt.ActionIndex].pRespArgs))->pData,AlignedLengthRecv );                      
-                    }
-                    /*  copy the unaligned part, if any */
-                    if( LengthToCopy > 0) 
-                    {
-                       NWP_IF_READ_CHECK(g_pCB->FD,TailBuffer,4);
-                       /*  copy TailBuffer unaligned part (1/2/3 bytes) */
-                       memcpy(((_SlArgsData_t *)(g_pCB->ObjPool[g_pCB->FunctionParams.AsyncExt.ActionIndex].pRespArgs))->pData + AlignedLengthRecv,TailBuffer,LengthToCopy);                    }                  
+                    VERIFY_RET_OK(_SlDrvRecvScatter((_SlArgsData_t *)(g_pCB->ObjPool[g_pCB->FunctionParams.AsyncExt.ActionIndex].pRespArgs),
+                                                    ACT_DATA_SIZE(&uBuf.TempBuf[4])));
                 }
                  OSI_RET_OK_CHECK(sl_SyncObjSignal(&(g_pCB->ObjPool[g_pCB->FunctionParams.AsyncExt.ActionIndex].SyncObj)));
                  OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj)); 
@@ -1150,16 +1283,60 @@ void _SlDrvClassifyRxMsg(
 }
 
 /* ******************************************************************************/
-/*  _SlDrvShiftDWord */
+/*  _SlDrvSyncFind */
+/* ******************************************************************************/
+/*  Returns the offset of the first sync pattern in the scan window, or -1 if there is
+    none. The key byte of every candidate offset is compared in one go with the SWAR
+    zero-byte test on each 32-bit word; only offsets it flags get the full masked
+    compare. The test can flag a byte above a real match, never miss one */
+static INT32 _SlDrvSyncFind(const UINT8 *pWin, UINT8 TxSeqNum)
+{
+    UINT32      Cand;
+    UINT32      Word;
+    UINT32      Offset;
+    UINT8       Quad;
+
+    for(Quad = 0; Quad < N2H_SYNC_SCAN_CHUNK; Quad += 4)
+    {
+        Word = BUF_LE_DWORD(&pWin[Quad + 2]) ^ ((UINT32)0x01010101 * N2H_SYNC_KEY_BYTE);
+        Cand = (Word - (UINT32)0x01010101) & ~Word & (UINT32)0x80808080;
+
+        for(Offset = Quad; Cand; Offset++, Cand >>= 8)
+        {
+            if(Cand & 0x80)
+            {
+                Word = BUF_LE_DWORD(&pWin[Offset]);
+                if(N2H_SYNC_PATTERN_MATCH(&Word, TxSeqNum))
+                {
+                    return (INT32)Offset;
+                }
+            }
+        }
+    }
+
+    return -1;
+}
+
+/* ******************************************************************************/
+/*  _SlDrvRxHdrFill */
 /* ******************************************************************************/
-void _SlDrvShiftDWord(UINT8 *pBuf)
+/*  Fill Len bytes of the header, first from bytes already read past the sync pattern
+    and then from the interface */
+static _SlReturnVal_t _SlDrvRxHdrFill(UINT8 *pDst, UINT8 Len, UINT8 **ppPend, UINT8 *pPendLen)
 {
-    UINT8       ShiftIdx;
-    for(ShiftIdx = 0; ShiftIdx< 7; ShiftIdx++)
+    while(Len && *pPendLen)
     {
-        pBuf[ShiftIdx] = pBuf[ShiftIdx+1];
+        *pDst++ = *(*ppPend)++;
+        (*pPendLen)--;
+        Len--;
     }
-    pBuf[7] = 0;
+
+    if(Len)
+    {
+        NWP_IF_READ_CHECK(g_pCB->FD, pDst, Len);
+    }
+
+    return SL_RET_CODE_OK;
 }
 
 /* ******************************************************************************/
@@ -1167,7 +1344,16 @@ void _SlDrvShiftDWord(UINT8 *pBuf)
 /* ******************************************************************************/
 _SlReturnVal_t   _SlDrvRxHdrRead(UINT8 *pBuf, UINT8 *pAlignSize)
 {
+    union
+    {
+        UINT8   Bytes[N2H_SYNC_SCAN_WINDOW + 1];
+        UINT32  Align;
+    } uWin;
     UINT32       SyncCnt  = 0;
+    UINT32       ReadCnt  = 0;
+    INT32        Offset;
+    UINT8        *pPend   = NULL;
+    UINT8        PendLen  = 0;
 
 #ifndef SL_IF_TYPE_UART
     /*  1. Write CNYS pattern to NWP when working in SPI mode only  */
@@ -1176,53 +1362,60 @@ _SlReturnVal_t   _SlDrvRxHdrRead(UINT8 *pBuf, UINT8 *pAlignSize)
 
     /*  2. Read 4 bytes (protocol aligned) */
     NWP_IF_READ_CHECK(g_pCB->FD, &pBuf[0], 4);
-    _SL_DBG_SYNC_LOG(SyncCnt,pBuf);
+    _SL_DBG_SYNC_LOG(ReadCnt,pBuf);
+    _SL_DBG_CNT_INC(Sync.Headers);
 
     /* Wait for SYNC_PATTERN_LEN from the device */
-    while ( ! N2H_SYNC_PATTERN_MATCH(pBuf, g_pCB->TxSeqNum) )
+    if ( ! N2H_SYNC_PATTERN_MATCH(pBuf, g_pCB->TxSeqNum) )
     {
-        /*  3. Debug limit of scan */
-        VERIFY_PROTOCOL(SyncCnt < SL_SYNC_SCAN_THRESHOLD);
+        _SL_DBG_CNT_INC(Sync.Scans);
 
-        /*  4. Read next 4 bytes to Low 4 bytes of buffer */
-        if(0 == (SyncCnt % (UINT32)SYNC_PATTERN_LEN))
+        /*  3. Scan the window, which starts at stream offset SyncCnt, a chunk at a time */
+        sl_Memcpy(&uWin.Bytes[0], &pBuf[1], N2H_SYNC_SCAN_CARRY);
+        SyncCnt = 1;
+        for(;;)
         {
-        	NWP_IF_READ_CHECK(g_pCB->FD, &pBuf[4], 4);
-            _SL_DBG_SYNC_LOG(SyncCnt,pBuf);
-        }
+            /*  Debug limit of scan */
+            VERIFY_PROTOCOL(SyncCnt < SL_SYNC_SCAN_THRESHOLD);
 
-        /*  5. Shift Buffer Up for checking if the sync is shifted */
-        _SlDrvShiftDWord(pBuf);
+            NWP_IF_READ_CHECK(g_pCB->FD, &uWin.Bytes[N2H_SYNC_SCAN_CARRY], N2H_SYNC_SCAN_CHUNK);
+            ReadCnt++;
+            _SL_DBG_SYNC_LOG(ReadCnt,&uWin.Bytes[N2H_SYNC_SCAN_CARRY + 1]);
+            _SL_DBG_CNT_INC(Sync.ScanReads);
 
-        SyncCnt++;
-    }
+            Offset = _SlDrvSyncFind(uWin.Bytes, g_pCB->TxSeqNum);
+            if(Offset >= 0)
+            {
+                break;
+            }
 
-    /*  5. Sync pattern found. If needed, complete number of read bytes to multiple of 4 (protocol align) */
-    SyncCnt %= SYNC_PATTERN_LEN;
+            /*  Keep the tail, which may hold the start of a pattern */
+            sl_Memcpy(&uWin.Bytes[0], &uWin.Bytes[N2H_SYNC_SCAN_CHUNK], N2H_SYNC_SCAN_CARRY);
+            SyncCnt += N2H_SYNC_SCAN_CHUNK;
+        }
 
-    if(SyncCnt > 0)
-    {
-        *(UINT32 *)&pBuf[0] = *(UINT32 *)&pBuf[4];
-        NWP_IF_READ_CHECK(g_pCB->FD, &pBuf[SYNC_PATTERN_LEN - SyncCnt], SyncCnt);
-    }
-    else
-    {
-    	NWP_IF_READ_CHECK(g_pCB->FD, &pBuf[0], 4);
+        /*  4. Sync pattern found. The bytes after it are the start of the header */
+        SyncCnt += Offset;
+        pPend = &uWin.Bytes[Offset + SYNC_PATTERN_LEN];
+        PendLen = (UINT8)(N2H_SYNC_SCAN_WINDOW - SYNC_PATTERN_LEN - Offset);
+        _SL_DBG_CNT_ADD(Sync.SkippedBytes, SyncCnt);
     }
 
-    /*  6. Scan for Double pattern. */
+    /*  5. Read the generic header. Scan for Double pattern. */
+    VERIFY_RET_OK(_SlDrvRxHdrFill(&pBuf[0], SYNC_PATTERN_LEN, &pPend, &PendLen));
     while ( N2H_SYNC_PATTERN_MATCH(pBuf, g_pCB->TxSeqNum) )
     {
         _SL_DBG_CNT_INC(Work.DoubleSyncPattern);
-        NWP_IF_READ_CHECK(g_pCB->FD, &pBuf[0], SYNC_PATTERN_LEN);
+        VERIFY_RET_OK(_SlDrvRxHdrFill(&pBuf[0], SYNC_PATTERN_LEN, &pPend, &PendLen));
     }
     g_pCB->TxSeqNum++;
 
-    /*  7. Here we've read Generic Header (4 bytes). Read the Resp Specific header (4 more bytes). */
-    NWP_IF_READ_CHECK(g_pCB->FD, &pBuf[SYNC_PATTERN_LEN], _SL_RESP_SPEC_HDR_SIZE);
+    /*  6. Here we've read Generic Header (4 bytes). Read the Resp Specific header (4 more bytes). */
+    VERIFY_RET_OK(_SlDrvRxHdrFill(&pBuf[SYNC_PATTERN_LEN], _SL_RESP_SPEC_HDR_SIZE, &pPend, &PendLen));
 
-    /*  8. Here we've read the enire Resp Header. */
+    /*  7. Here we've read the enire Resp Header. */
     /*     Return number bytes needed to be sent after read for NWP Rx 4-byte alignment (protocol alignment) */
+    SyncCnt %= SYNC_PATTERN_LEN;
     *pAlignSize = (SyncCnt > 0) ? (SYNC_PATTERN_LEN - SyncCnt) : 0;
 
     return SL_RET_CODE_OK;
@@ -1254,30 +1447,59 @@ int _SlDrvBasicCmd(_SlOpcode_t Opcode)
 /* ***************************************************************************** */
 /*  */
 /* ***************************************************************************** */
+/*  Actions on a socket are serialized per socket, other actions per action ID */
+#define _SL_POOL_KEY(ActionID, SocketID)    ((SL_MAX_SOCKETS > (SocketID)) ? (SocketID) : (ActionID))
+
+/*  Append an object to the FIFO of objects waiting for Key */
+static void _SlDrvPendingPush(UINT8 Key, UINT8 ObjIdx)
+{
+	g_pCB->ObjPool[ObjIdx].NextIndex = MAX_CONCURRENT_ACTIONS;
+	if (MAX_CONCURRENT_ACTIONS > g_pCB->PendingTail[Key])
+	{
+		g_pCB->ObjPool[g_pCB->PendingTail[Key]].NextIndex = ObjIdx;
+	}
+	else
+	{
+		g_pCB->PendingHead[Key] = ObjIdx;
+	}
+	g_pCB->PendingTail[Key] = ObjIdx;
+}
+
+/*  Take the first object waiting for Key, MAX_CONCURRENT_ACTIONS if none */
+static UINT8 _SlDrvPendingPop(UINT8 Key)
+{
+	UINT8 ObjIdx = g_pCB->PendingHead[Key];
+
+	if (MAX_CONCURRENT_ACTIONS > ObjIdx)
+	{
+		g_pCB->PendingHead[Key] = g_pCB->ObjPool[ObjIdx].NextIndex;
+		if (MAX_CONCURRENT_ACTIONS == g_pCB->PendingHead[Key])
+		{
+			g_pCB->PendingTail[Key] = MAX_CONCURRENT_ACTIONS;
+		}
+	}
+	return ObjIdx;
+}
+
 int _SlDrvWaitForPoolObj(UINT32 ActionID, UINT8 SocketID)
 {
 	UINT8 CurrObjIndex = MAX_CONCURRENT_ACTIONS;
+	UINT8 Key = _SL_POOL_KEY(ActionID, SocketID);
 
 	OSI_RET_OK_CHECK(sl_LockObjLock(&g_pCB->ProtectionLockObj, SL_OS_WAIT_FOREVER));
+	_SL_DBG_LOCK_TAKEN();
 
 	/* Get free object  */
 	if (MAX_CONCURRENT_ACTIONS > g_pCB->FreePoolIdx)
 	{
-		/* save the current obj index */
+		/* save the current obj index and set the new free index */
 		CurrObjIndex = g_pCB->FreePoolIdx;
-		/* set the new free index */
-		if (MAX_CONCURRENT_ACTIONS > g_pCB->ObjPool[CurrObjIndex].NextIndex)
-		{
-			g_pCB->FreePoolIdx = g_pCB->ObjPool[CurrObjIndex].NextIndex;
-		}
-		else
-		{
-			/* No further free actions available */
-			g_pCB->FreePoolIdx = MAX_CONCURRENT_ACTIONS;
-		}
+		g_pCB->FreePoolIdx = g_pCB->ObjPool[CurrObjIndex].NextIndex;
 	}
 	else
 	{
+		_SL_DBG_CNT_INC(Pool.Empty);
+		_SL_DBG_LOCK_GIVING();
 		OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj));
 		return CurrObjIndex;
 	}
@@ -1286,33 +1508,25 @@ int _SlDrvWaitForPoolObj(UINT32 ActionID, UINT8 SocketID)
 	{
 		g_pCB->ObjPool[CurrObjIndex].AdditionalData = SocketID;
 	}
-	/*In case this action is socket related, SocketID bit will be on
-	  In case SocketID is set to SL_MAX_SOCKETS, the socket is not relevent to the action. In that case ActionID bit will be on */
-	while ( ( (SL_MAX_SOCKETS > SocketID) && (g_pCB->ActiveActionsBitmap & (1<<SocketID)) ) || ( (g_pCB->ActiveActionsBitmap & (1<<ActionID)) && (SL_MAX_SOCKETS == SocketID) ) )
+	/* While another action holds the socket (or this action, if it is not socket related), */
+	/* wait in its queue. The releasing action wakes exactly the first waiter */
+	while (g_pCB->ActiveActionsBitmap & (1<<Key))
 	{
-		//action in progress - move to pending list 
-		g_pCB->ObjPool[CurrObjIndex].NextIndex = g_pCB->PendingPoolIdx;
-		g_pCB->PendingPoolIdx = CurrObjIndex;
+		_SlDrvPendingPush(Key, CurrObjIndex);
+		_SL_DBG_CNT_INC(Pool.Waits);
+		_SL_DBG_LOCK_GIVING();
 		OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj));
 		//wait for action to be free
 		OSI_RET_OK_CHECK(sl_SyncObjWait(&g_pCB->ObjPool[CurrObjIndex].SyncObj, SL_OS_WAIT_FOREVER));
-		//set params and move to active (remove from pending list at _SlDrvReleasePoolObj)
 		OSI_RET_OK_CHECK(sl_LockObjLock(&g_pCB->ProtectionLockObj, SL_OS_WAIT_FOREVER));
+		_SL_DBG_LOCK_TAKEN();
 	}
-	/*mark as active. Set socket as active if action is on socket, otherwise mark action as active*/
-		if (SL_MAX_SOCKETS > SocketID)
-		{
-			g_pCB->ActiveActionsBitmap |= (1<<SocketID);
-		}
-		else
-		{
-			g_pCB->ActiveActionsBitmap |= (1<<ActionID);
-		}
-	/* move to active list  */
-		g_pCB->ObjPool[CurrObjIndex].NextIndex = g_pCB->ActivePoolIdx;
-		g_pCB->ActivePoolIdx = CurrObjIndex;	
-	/* unlock */
-		OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj));
+	/* mark as active */
+	g_pCB->ActiveActionsBitmap |= (1<<Key);
+	g_pCB->ActiveIdx[Key] = CurrObjIndex;
+
+	_SL_DBG_LOCK_GIVING();
+	OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj));
 	return CurrObjIndex;
 }
 
@@ -1322,48 +1536,35 @@ int _SlDrvWaitForPoolObj(UINT32 ActionID, UINT8 SocketID)
 void _SlDrvReleasePoolObj(UINT8 pObjIdx)
 {
 	UINT8 PendingIndex;
+	UINT8 Key;
 	
 	OSI_RET_OK_CHECK(sl_LockObjLock(&g_pCB->ProtectionLockObj, SL_OS_WAIT_FOREVER));
+	_SL_DBG_LOCK_TAKEN();
+
+	/* In case this action is socket related, SocketID is in use, otherwise will be set to SL_MAX_SOCKETS */
+	Key = _SL_POOL_KEY(g_pCB->ObjPool[pObjIdx].ActionID, g_pCB->ObjPool[pObjIdx].AdditionalData & BSD_SOCKET_ID_MASK);
 
-	/* go over the pending list and release other pending action if needed */
-	PendingIndex = g_pCB->PendingPoolIdx;
-	while(MAX_CONCURRENT_ACTIONS > PendingIndex)
+	/* release the next action waiting for the same socket or action, if any */
+	PendingIndex = _SlDrvPendingPop(Key);
+	if (MAX_CONCURRENT_ACTIONS > PendingIndex)
 	{
-		/* In case this action is socket related, SocketID is in use, otherwise will be set to SL_MAX_SOCKETS */
-		if ( (g_pCB->ObjPool[PendingIndex].ActionID == g_pCB->ObjPool[pObjIdx].ActionID) && 
-			( (SL_MAX_SOCKETS == (g_pCB->ObjPool[PendingIndex].AdditionalData & BSD_SOCKET_ID_MASK)) || 
-			((SL_MAX_SOCKETS > (g_pCB->ObjPool[pObjIdx].AdditionalData & BSD_SOCKET_ID_MASK)) && ( (g_pCB->ObjPool[PendingIndex].AdditionalData & BSD_SOCKET_ID_MASK) == (g_pCB->ObjPool[pObjIdx].AdditionalData & BSD_SOCKET_ID_MASK) ))) )
-		{
-			/* remove from pending list */
-			_SlRemoveFromList(&g_pCB->PendingPoolIdx, PendingIndex);
-			 OSI_RET_OK_CHECK(sl_SyncObjSignal(&(g_pCB->ObjPool[PendingIndex].SyncObj)));
-			 break;
-		}
-		PendingIndex = g_pCB->ObjPool[PendingIndex].NextIndex;
+		_SL_DBG_CNT_INC(Pool.Wakeups);
+		OSI_RET_OK_CHECK(sl_SyncObjSignal(&(g_pCB->ObjPool[PendingIndex].SyncObj)));
 	}
 
-		if (SL_MAX_SOCKETS > (g_pCB->ObjPool[pObjIdx].AdditionalData & BSD_SOCKET_ID_MASK))
-		{
-		/* unset socketID  */
-			g_pCB->ActiveActionsBitmap &= ~(1<<(g_pCB->ObjPool[pObjIdx].AdditionalData & BSD_SOCKET_ID_MASK));
-		}
-		else
-		{
-		/* unset actionID  */
-			g_pCB->ActiveActionsBitmap &= ~(1<<g_pCB->ObjPool[pObjIdx].ActionID);
-		}	
+	g_pCB->ActiveActionsBitmap &= ~(1<<Key);
+	g_pCB->ActiveIdx[Key] = MAX_CONCURRENT_ACTIONS;
 
 	/* delete old data */
 	g_pCB->ObjPool[pObjIdx].pRespArgs = NULL;
 	g_pCB->ObjPool[pObjIdx].ActionID = 0;
 	g_pCB->ObjPool[pObjIdx].AdditionalData = SL_MAX_SOCKETS;
 
-	/* remove from active list */
-	_SlRemoveFromList(&g_pCB->ActivePoolIdx, pObjIdx);
 	/* move to free list */
 	g_pCB->ObjPool[pObjIdx].NextIndex = g_pCB->FreePoolIdx;
 	g_pCB->FreePoolIdx = pObjIdx;
 
+	_SL_DBG_LOCK_GIVING();
 	OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj));
 }
 
@@ -1384,10 +1585,8 @@ void _SlDrvObjInit(void)
 		g_pCB->ObjPool[Idx].NextIndex = Idx + 1;
 		g_pCB->ObjPool[Idx].AdditionalData = SL_MAX_SOCKETS;
 	}
-	
-	g_pCB->ActivePoolIdx = MAX_CONCURRENT_ACTIONS;
-	g_pCB->PendingPoolIdx = MAX_CONCURRENT_ACTIONS;
 
+	_SlDrvObjDeInit();
 }
 
 /* ******************************************************************************/
@@ -1395,44 +1594,49 @@ void _SlDrvObjInit(void)
 /* ******************************************************************************/
 void _SlDrvObjDeInit(void)
 {
-	g_pCB->FreePoolIdx = 0;
-	g_pCB->PendingPoolIdx = MAX_CONCURRENT_ACTIONS;
-	g_pCB->ActivePoolIdx = MAX_CONCURRENT_ACTIONS;
+	UINT8 Idx;
 
+	g_pCB->FreePoolIdx = 0;
+	for (Idx = 0 ; Idx < MAX_ACTION_ENUM_IDX ; Idx++)
+	{
+		g_pCB->PendingHead[Idx] = MAX_CONCURRENT_ACTIONS;
+		g_pCB->PendingTail[Idx] = MAX_CONCURRENT_ACTIONS;
+		g_pCB->ActiveIdx[Idx] = MAX_CONCURRENT_ACTIONS;
+	}
 }
 
 /* ******************************************************************************/
-/*   */
+/*  _SlDrvSetActiveObj                                                         */
 /* ******************************************************************************/
-void _SlRemoveFromList(UINT8 *ListIndex, UINT8 ItemIndex)
+/*  Check whether the active object ActiveIndex waits for this Async event and if
+    so, make it the target of the event */
+static _SlReturnVal_t _SlDrvSetActiveObj(UINT8 ActiveIndex, _SlOpcode_t Opcode, UINT8 Sd)
 {
-	UINT8 Idx;
-	/* only one item in the list */
-	if (MAX_CONCURRENT_ACTIONS == g_pCB->ObjPool[*ListIndex].NextIndex)
+	/* unset the Ipv4\IPv6 bit in the opcode if family bit was set  */
+	if (g_pCB->ObjPool[ActiveIndex].AdditionalData & SL_NETAPP_FAMILY_MASK)
 	{
-		*ListIndex = MAX_CONCURRENT_ACTIONS;
+		Opcode &= ~SL_OPCODE_IPV6;
 	}
-	/* need to remove the first item in the list and therfore update the global which holds this index */
-	else if (*ListIndex == ItemIndex)
+
+	if ((g_pCB->ObjPool[ActiveIndex].ActionID == RECV_ID) && (Sd == g_pCB->ObjPool[ActiveIndex].AdditionalData) && 
+				( (SL_OPCODE_SOCKET_RECVASYNCRESPONSE == Opcode) || (SL_OPCODE_SOCKET_RECVFROMASYNCRESPONSE == Opcode) || (SL_OPCODE_SOCKET_RECVFROMASYNCRESPONSE_V6 == Opcode) ) )
 	{
-		*ListIndex = g_pCB->ObjPool[ItemIndex].NextIndex;
+		g_pCB->FunctionParams.AsyncExt.ActionIndex = ActiveIndex;
+		return SL_RET_CODE_OK;
 	}
-	else
+	/* In case this action is socket related, SocketID is in use, otherwise will be set to SL_MAX_SOCKETS */
+	if ( (g_pCB->ObjPool[ActiveIndex].ActionID >= MAX_SOCKET_ENUM_IDX) && (g_pCB->ObjPool[ActiveIndex].ActionID < RECV_ID) &&
+				(_SlActionLookupTable[ g_pCB->ObjPool[ActiveIndex].ActionID - MAX_SOCKET_ENUM_IDX].ActionAsyncOpcode == Opcode) && 
+				( ((Sd == (g_pCB->ObjPool[ActiveIndex].AdditionalData & BSD_SOCKET_ID_MASK) ) && (SL_MAX_SOCKETS > Sd)) || (SL_MAX_SOCKETS == (g_pCB->ObjPool[ActiveIndex].AdditionalData & BSD_SOCKET_ID_MASK)) ) )
 	{
-		Idx = *ListIndex;
-		while(MAX_CONCURRENT_ACTIONS > Idx)
-		{
-			/* remove from list */
-			if (g_pCB->ObjPool[Idx].NextIndex == ItemIndex)
-			{
-				g_pCB->ObjPool[Idx].NextIndex = g_pCB->ObjPool[ItemIndex].NextIndex;
-				break;
-			}
-			Idx = g_pCB->ObjPool[Idx].NextIndex;		
-		}
+		/* set handler */
+		g_pCB->FunctionParams.AsyncExt.AsyncEvtHandler = _SlActionLookupTable[ g_pCB->ObjPool[ActiveIndex].ActionID - MAX_SOCKET_ENUM_IDX].AsyncEventHandler;
+		g_pCB->FunctionParams.AsyncExt.ActionIndex = ActiveIndex;
+		return SL_RET_CODE_OK;
 	}
-}
 
+	return SL_RET_CODE_SELF_ERROR;
+}
 
 /* ******************************************************************************/
 /*  _SlFindAndSetActiveObj                                                     */
@@ -1440,34 +1644,32 @@ void _SlRemoveFromList(UINT8 *ListIndex, UINT8 ItemIndex)
 _SlReturnVal_t _SlFindAndSetActiveObj(_SlOpcode_t  Opcode, UINT8 Sd)
 {
 	UINT8 ActiveIndex;
+	UINT8 Idx;
 
-	ActiveIndex = g_pCB->ActivePoolIdx;
-	/* go over the active list if exist to find obj waiting for this Async event */
-		while (MAX_CONCURRENT_ACTIONS > ActiveIndex)
+	/* the object holding the socket the event is for */
+	if (SL_MAX_SOCKETS > Sd)
+	{
+		ActiveIndex = g_pCB->ActiveIdx[Sd];
+		if ((MAX_CONCURRENT_ACTIONS > ActiveIndex) && (SL_RET_CODE_OK == _SlDrvSetActiveObj(ActiveIndex, Opcode, Sd)))
 		{
-			/* unset the Ipv4\IPv6 bit in the opcode if family bit was set  */
-			if (g_pCB->ObjPool[ActiveIndex].AdditionalData & SL_NETAPP_FAMILY_MASK)
-			{
-				Opcode &= ~SL_OPCODE_IPV6;
-			}
+			return SL_RET_CODE_OK;
+		}
+	}
 
-			if ((g_pCB->ObjPool[ActiveIndex].ActionID == RECV_ID) && (Sd == g_pCB->ObjPool[ActiveIndex].AdditionalData) && 
-						( (SL_OPCODE_SOCKET_RECVASYNCRESPONSE == Opcode) || (SL_OPCODE_SOCKET_RECVFROMASYNCRESPONSE == Opcode) || (SL_OPCODE_SOCKET_RECVFROMASYNCRESPONSE_V6 == Opcode) ) )
-			{
-				g_pCB->FunctionParams.AsyncExt.ActionIndex = ActiveIndex;
-				return SL_RET_CODE_OK;
-			}
-                         /* In case this action is socket related, SocketID is in use, otherwise will be set to SL_MAX_SOCKETS */
-			if ( (_SlActionLookupTable[ g_pCB->ObjPool[ActiveIndex].ActionID - MAX_SOCKET_ENUM_IDX].ActionAsyncOpcode == Opcode) && 
-						( ((Sd == (g_pCB->ObjPool[ActiveIndex].AdditionalData & BSD_SOCKET_ID_MASK) ) && (SL_MAX_SOCKETS > Sd)) || (SL_MAX_SOCKETS == (g_pCB->ObjPool[ActiveIndex].AdditionalData & BSD_SOCKET_ID_MASK)) ) )
+	/* otherwise the object holding the action the event answers, if not socket related */
+	for (Idx = 0; Idx < sizeof(_SlActionLookupTable)/sizeof(_SlActionLookupTable[0]); Idx++)
+	{
+		if ((_SlActionLookupTable[Idx].ActionAsyncOpcode == Opcode) ||
+			(_SlActionLookupTable[Idx].ActionAsyncOpcode == (Opcode & ~SL_OPCODE_IPV6)))
+		{
+			ActiveIndex = g_pCB->ActiveIdx[_SlActionLookupTable[Idx].ActionID];
+			if (MAX_CONCURRENT_ACTIONS > ActiveIndex)
 			{
-				/* set handler */
-				g_pCB->FunctionParams.AsyncExt.AsyncEvtHandler = _SlActionLookupTable[ g_pCB->ObjPool[ActiveIndex].ActionID - MAX_SOCKET_ENUM_IDX].AsyncEventHandler;
-				g_pCB->FunctionParams.AsyncExt.ActionIndex = ActiveIndex;
-				return SL_RET_CODE_OK;
+				return _SlDrvSetActiveObj(ActiveIndex, Opcode, Sd);
 			}
-			ActiveIndex = g_pCB->ObjPool[ActiveIndex].NextIndex;
+			break;
 		}
+	}
 
 	return SL_RET_CODE_SELF_ERROR;
 }
@@ -58,6 +58,8 @@ typedef struct _SlArgsData_t
 {
     UINT8	 *pArgs;
 	UINT8    *pData;
+    SlRecvSeg_t  *pSegs;    /* payload is scattered over these segments, in order */
+    UINT8        NumSegs;
 } _SlArgsData_t;
 
 
@@ -90,7 +92,8 @@ typedef enum
 	GETHOSYBYSERVICE_ID,
 	PING_ID,
     START_STOP_ID,
-	RECV_ID
+	RECV_ID,
+	MAX_ACTION_ENUM_IDX
 }_SlActionID_e;
 
 typedef struct _SlActionLookup_t
@@ -145,10 +148,13 @@ typedef struct
 
     _SlPoolObj_t                    ObjPool[MAX_CONCURRENT_ACTIONS];
 	UINT8							FreePoolIdx;
-	UINT8							PendingPoolIdx;
-	UINT8							ActivePoolIdx;
+	/* Actions on a socket are keyed by the socket ID, other actions by their action ID */
+	UINT8							PendingHead[MAX_ACTION_ENUM_IDX];	/* FIFO of objects waiting for the key */
+	UINT8							PendingTail[MAX_ACTION_ENUM_IDX];
+	UINT8							ActiveIdx[MAX_ACTION_ENUM_IDX];	/* object holding the key */
 	UINT32							ActiveActionsBitmap;
 	_SlLockObj_t                    ProtectionLockObj;
+	_SlLockObj_t                    CoalesceLockObj;	/* guards the SL_MSG_MORE buffer of sl_Send */
 
     _SlSyncObj_t                     CmdSyncObj;  
     UINT8                            IsCmdRespWaited;
@@ -174,6 +180,7 @@ extern void _SlDrvRxIrqHandler(void *pValue);
 extern _SlReturnVal_t  _SlDrvCmdOp(_SlCmdCtrl_t *pCmdCtrl , void* pTxRxDescBuff , _SlCmdExt_t* pCmdExt);
 extern _SlReturnVal_t  _SlDrvCmdSend(_SlCmdCtrl_t *pCmdCtrl , void* pTxRxDescBuff , _SlCmdExt_t* pCmdExt);
 extern _SlReturnVal_t  _SlDrvDataReadOp(_SlSd_t Sd, _SlCmdCtrl_t *pCmdCtrl , void* pTxRxDescBuff , _SlCmdExt_t* pCmdExt);
+extern _SlReturnVal_t  _SlDrvDataReadVecOp(_SlSd_t Sd, _SlCmdCtrl_t *pCmdCtrl , void* pTxRxDescBuff , _SlCmdExt_t* pCmdExt, SlRecvSeg_t *pSegs, UINT8 NumSegs);
 extern _SlReturnVal_t  _SlDrvDataWriteOp(_SlSd_t Sd, _SlCmdCtrl_t *pCmdCtrl , void* pTxRxDescBuff , _SlCmdExt_t* pCmdExt);
 extern int  _SlDrvBasicCmd(_SlOpcode_t Opcode);
 
@@ -184,6 +191,10 @@ extern void _sl_HandleAsync_Select(void *pVoidBuf);
 extern void _sl_HandleAsync_DnsGetHostByName(void *pVoidBuf);
 extern void _sl_HandleAsync_DnsGetHostByService(void *pVoidBuf);
 extern void _sl_HandleAsync_DnsGetHostByAddr(void *pVoidBuf);
+#if (defined(SL_INC_DNS_CACHE)) && _SL_INCLUDE_FUNC(sl_NetAppDnsGetHostByName)
+extern void _sl_DnsCacheReset(void);
+#endif
+extern void _sl_SocketReset(void);
 extern void _sl_HandleAsync_PingResponse(void *pVoidBuf);
 extern void _SlDrvNetAppEventHandler(void *pArgs);
 extern void _SlDrvDeviceEventHandler(void *pArgs);
@@ -856,12 +856,12 @@ const _SlCmdCtrl_t _SlGetHostByNameCtrl =
     sizeof(_BasicResponse_t)
 };
 #if _SL_INCLUDE_FUNC(sl_NetAppDnsGetHostByName)
-int sl_NetAppDnsGetHostByName(char * hostname, unsigned short usNameLen, unsigned long* out_ip_addr,unsigned char family)
+/* issue the query, the answer is copied into pAsyncRsp by the async handler */
+static int _sl_DnsQueryStart(char * hostname, unsigned short usNameLen, unsigned char family, _GetHostByNameAsyncResponse_u *pAsyncRsp, UINT8 *pObjIdx)
 {
     _SlGetHostByNameMsg_u           Msg;
     _SlCmdExt_t                     ExtCtrl;
-    _GetHostByNameAsyncResponse_u   AsyncRsp;
-	UINT8 pObjIdx = MAX_CONCURRENT_ACTIONS;
+	UINT8 ObjIdx = MAX_CONCURRENT_ACTIONS;
 
     ExtCtrl.TxPayloadLen = usNameLen;
     ExtCtrl.RxPayloadLen = 0;
@@ -872,38 +872,347 @@ int sl_NetAppDnsGetHostByName(char * hostname, unsigned short usNameLen, unsigne
     Msg.Cmd.family = family;
 
 	/*Use Obj to issue the command, if not available try later */
-	pObjIdx = _SlDrvWaitForPoolObj(GETHOSYBYNAME_ID,SL_MAX_SOCKETS);
-	if (MAX_CONCURRENT_ACTIONS == pObjIdx)
+	ObjIdx = _SlDrvWaitForPoolObj(GETHOSYBYNAME_ID,SL_MAX_SOCKETS);
+	if (MAX_CONCURRENT_ACTIONS == ObjIdx)
 	{
 		return SL_POOL_IS_EMPTY;
 	}
 	OSI_RET_OK_CHECK(sl_LockObjLock(&g_pCB->ProtectionLockObj, SL_OS_WAIT_FOREVER));
 
-	g_pCB->ObjPool[pObjIdx].pRespArgs =  (UINT8 *)&AsyncRsp;
+	g_pCB->ObjPool[ObjIdx].pRespArgs =  (UINT8 *)pAsyncRsp;
 	/*set bit to indicate IPv6 address is expected */
 	if (SL_AF_INET6 == family)  
 	{
-		g_pCB->ObjPool[pObjIdx].AdditionalData |= SL_NETAPP_FAMILY_MASK;
+		g_pCB->ObjPool[ObjIdx].AdditionalData |= SL_NETAPP_FAMILY_MASK;
 	}
 	
     OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj));
 
     VERIFY_RET_OK(_SlDrvCmdOp((_SlCmdCtrl_t *)&_SlGetHostByNameCtrl, &Msg, &ExtCtrl));
 
-    if(SL_RET_CODE_OK == Msg.Rsp.status)
-    {        
-        OSI_RET_OK_CHECK(sl_SyncObjWait(&g_pCB->ObjPool[pObjIdx].SyncObj, SL_OS_WAIT_FOREVER));
-        Msg.Rsp.status = AsyncRsp.IpV4.status;
+    if(SL_RET_CODE_OK != Msg.Rsp.status)
+    {
+        _SlDrvReleasePoolObj(ObjIdx);
+        return Msg.Rsp.status;
+    }
+
+    *pObjIdx = ObjIdx;
+    return SL_RET_CODE_OK;
+}
+
+static int _sl_DnsQuery(char * hostname, unsigned short usNameLen, unsigned long* out_ip_addr,unsigned char family)
+{
+    _GetHostByNameAsyncResponse_u   AsyncRsp;
+    INT16                           Status;
+	UINT8 pObjIdx = MAX_CONCURRENT_ACTIONS;
+
+    Status = _sl_DnsQueryStart(hostname, usNameLen, family, &AsyncRsp, &pObjIdx);
+    if (SL_RET_CODE_OK != Status)
+    {
+        return Status;
+    }
+
+    OSI_RET_OK_CHECK(sl_SyncObjWait(&g_pCB->ObjPool[pObjIdx].SyncObj, SL_OS_WAIT_FOREVER));
+    Status = AsyncRsp.IpV4.status;
+
+    if(SL_OS_RET_CODE_OK == (int)Status)
+    {
+        sl_Memcpy((char *)out_ip_addr,
+                  (char *)&AsyncRsp.IpV4.ip0, 
+                  (SL_AF_INET == family) ? SL_IPV4_ADDRESS_SIZE : SL_IPV6_ADDRESS_SIZE);
+    }
+    _SlDrvReleasePoolObj(pObjIdx);
+    return Status;
+}
+#endif
+
+#if (defined(SL_INC_DNS_CACHE)) && _SL_INCLUDE_FUNC(sl_NetAppDnsGetHostByName)
+/*****************************************************************************/
+/* DNS cache */
+/*****************************************************************************/
+#ifndef sl_DnsCacheTime
+#error "SL_INC_DNS_CACHE needs sl_DnsCacheTime() to be defined in user.h"
+#endif
+
+#ifndef SL_DNS_CACHE_SIZE
+#define SL_DNS_CACHE_SIZE           (4)     /* entries, probed linearly from the name hash */
+#endif
+#ifndef SL_DNS_CACHE_NAME_LEN
+#define SL_DNS_CACHE_NAME_LEN       (64)    /* longer names bypass the cache */
+#endif
+#ifndef SL_DNS_CACHE_TTL
+#define SL_DNS_CACHE_TTL            (300)   /* seconds a resolved address is kept */
+#endif
+#ifndef SL_DNS_CACHE_NEG_TTL
+#define SL_DNS_CACHE_NEG_TTL        (10)    /* seconds a name the server failed to resolve is kept */
+#endif
+#ifndef SL_DNS_CACHE_REFRESH
+#define SL_DNS_CACHE_REFRESH        (30)    /* a hit this many seconds before expiry starts a refresh */
+#endif
+
+#define _SL_DNS_CACHE_NONE          (SL_DNS_CACHE_SIZE)
+#define _SL_DNS_LOWER(c)            ((((c) >= 'A') && ((c) <= 'Z')) ? ((c) + ('a' - 'A')) : (c))
+#define _SL_DNS_EXPIRED(pE, Now)    ((INT32)((Now) - (pE)->Expires) >= 0)
 
-        if(SL_OS_RET_CODE_OK == (int)Msg.Rsp.status)
+typedef struct
+{
+    UINT32  Hash;
+    UINT32  Expires;                        /* sl_DnsCacheTime() at which the entry is stale */
+    UINT32  Ip[4];                          /* address in the layout sl_NetAppDnsGetHostByName returns */
+    INT16   Status;                         /* SL_RET_CODE_OK or the cached DNS error */
+    UINT8   NameLen;                        /* 0 for an entry never used */
+    UINT8   Family;
+    char    Name[SL_DNS_CACHE_NAME_LEN];    /* lower case */
+}_SlDnsCacheEntry_t;
+
+typedef struct
+{
+    _SlDnsCacheEntry_t              Entries[SL_DNS_CACHE_SIZE];
+    _GetHostByNameAsyncResponse_u   RefreshRsp;
+    BOOLEAN                         RefreshPending;
+    UINT8                           RefreshSlot;    /* entry the refresh updates, _SL_DNS_CACHE_NONE to drop it */
+    SlDnsCacheStats_t               Stats;
+}_SlDnsCache_t;
+
+_SlDnsCache_t g_SlDnsCache;
+
+
+static UINT32 _sl_DnsCacheHash(const char *pName, UINT16 Len)
+{
+    UINT32 Hash = 2166136261UL;
+
+    /* FNV-1a; names are compared without case */
+    while (Len--)
+    {
+        Hash = (Hash ^ (UINT8)_SL_DNS_LOWER(*pName)) * 16777619UL;
+        pName++;
+    }
+    return Hash;
+}
+
+static UINT8 _sl_DnsCacheFind(UINT32 Hash, const char *pName, UINT16 Len, UINT8 Family)
+{
+    _SlDnsCacheEntry_t  *pE;
+    UINT16              i;
+    UINT8               Probe;
+    UINT8               Slot;
+
+    /* entries are only reused, never emptied, so an empty entry ends the probe */
+    for (Probe = 0 ; Probe < SL_DNS_CACHE_SIZE ; Probe++)
+    {
+        Slot = (Hash + Probe) % SL_DNS_CACHE_SIZE;
+        pE = &g_SlDnsCache.Entries[Slot];
+
+        if (0 == pE->NameLen)
+        {
+            break;
+        }
+        if ((pE->Hash == Hash) && (pE->NameLen == Len) && (pE->Family == Family))
         {
-            sl_Memcpy((char *)out_ip_addr,
-                      (char *)&AsyncRsp.IpV4.ip0, 
-                      (SL_AF_INET == family) ? SL_IPV4_ADDRESS_SIZE : SL_IPV6_ADDRESS_SIZE);
+            for (i = 0 ; (i < Len) && (pE->Name[i] == _SL_DNS_LOWER(pName[i])) ; i++)
+            {
+            }
+            if (i == Len)
+            {
+                return Slot;
+            }
         }
     }
-    _SlDrvReleasePoolObj(pObjIdx);
-    return Msg.Rsp.status;
+    return _SL_DNS_CACHE_NONE;
+}
+
+static void _sl_DnsCacheStore(UINT8 Slot, INT16 Status, const UINT8 *pIp)
+{
+    _SlDnsCacheEntry_t *pE = &g_SlDnsCache.Entries[Slot];
+
+    pE->Status = Status;
+    if (SL_RET_CODE_OK == Status)
+    {
+        sl_Memcpy((char *)pE->Ip, (char *)pIp, (SL_AF_INET == pE->Family) ? SL_IPV4_ADDRESS_SIZE : SL_IPV6_ADDRESS_SIZE);
+        pE->Expires = sl_DnsCacheTime() + SL_DNS_CACHE_TTL;
+    }
+    else
+    {
+        pE->Expires = sl_DnsCacheTime() + SL_DNS_CACHE_NEG_TTL;
+    }
+}
+
+static void _sl_DnsCacheInsert(UINT32 Hash, const char *pName, UINT16 Len, UINT8 Family, INT16 Status, const UINT8 *pIp)
+{
+    _SlDnsCacheEntry_t  *pE;
+    UINT32              Now = sl_DnsCacheTime();
+    UINT16              i;
+    UINT8               Probe;
+    UINT8               Slot;
+    UINT8               Victim;
+
+    Slot = _sl_DnsCacheFind(Hash, pName, Len, Family);
+    if (_SL_DNS_CACHE_NONE == Slot)
+    {
+        /* take the first empty or expired entry on the probe path, else the one expiring first */
+        Victim = Hash % SL_DNS_CACHE_SIZE;
+        for (Probe = 0 ; Probe < SL_DNS_CACHE_SIZE ; Probe++)
+        {
+            Slot = (Hash + Probe) % SL_DNS_CACHE_SIZE;
+            pE = &g_SlDnsCache.Entries[Slot];
+            if ((0 == pE->NameLen) || _SL_DNS_EXPIRED(pE, Now))
+            {
+                Victim = Slot;
+                break;
+            }
+            if ((INT32)(pE->Expires - g_SlDnsCache.Entries[Victim].Expires) < 0)
+            {
+                Victim = Slot;
+            }
+        }
+        Slot = Victim;
+        pE = &g_SlDnsCache.Entries[Slot];
+
+        if (0 != pE->NameLen)
+        {
+            g_SlDnsCache.Stats.Evictions++;
+        }
+        if (Slot == g_SlDnsCache.RefreshSlot)
+        {
+            g_SlDnsCache.RefreshSlot = _SL_DNS_CACHE_NONE;
+        }
+
+        pE->Hash = Hash;
+        pE->NameLen = (UINT8)Len;
+        pE->Family = Family;
+        for (i = 0 ; i < Len ; i++)
+        {
+            pE->Name[i] = _SL_DNS_LOWER(pName[i]);
+        }
+    }
+    _sl_DnsCacheStore(Slot, Status, pIp);
+}
+
+/* called by the async handler: nobody waits for a refresh, so it completes here */
+static void _sl_DnsCacheRefreshDone(UINT8 ObjIdx)
+{
+    OSI_RET_OK_CHECK(sl_LockObjLock(&g_pCB->ProtectionLockObj, SL_OS_WAIT_FOREVER));
+
+    if ((_SL_DNS_CACHE_NONE != g_SlDnsCache.RefreshSlot) && (SL_RET_CODE_OK == (INT16)g_SlDnsCache.RefreshRsp.IpV4.status))
+    {
+        _sl_DnsCacheStore(g_SlDnsCache.RefreshSlot, SL_RET_CODE_OK, (UINT8 *)&g_SlDnsCache.RefreshRsp.IpV4.ip0);
+        g_SlDnsCache.Stats.Refreshes++;
+    }
+    /* a failed refresh leaves the entry to expire */
+    g_SlDnsCache.RefreshSlot = _SL_DNS_CACHE_NONE;
+    g_SlDnsCache.RefreshPending = FALSE;
+
+    OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj));
+
+    _SlDrvReleasePoolObj(ObjIdx);
+}
+
+void _sl_DnsCacheReset(void)
+{
+    sl_Memset(&g_SlDnsCache, 0, sizeof(g_SlDnsCache));
+    g_SlDnsCache.RefreshSlot = _SL_DNS_CACHE_NONE;
+}
+
+#if _SL_INCLUDE_FUNC(sl_NetAppDnsCacheFlush)
+void sl_NetAppDnsCacheFlush(void)
+{
+    OSI_RET_OK_CHECK(sl_LockObjLock(&g_pCB->ProtectionLockObj, SL_OS_WAIT_FOREVER));
+
+    sl_Memset(g_SlDnsCache.Entries, 0, sizeof(g_SlDnsCache.Entries));
+    /* a refresh in flight completes, but its answer is dropped */
+    g_SlDnsCache.RefreshSlot = _SL_DNS_CACHE_NONE;
+
+    OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj));
+}
+#endif
+
+#if _SL_INCLUDE_FUNC(sl_NetAppDnsCacheStatsGet)
+void sl_NetAppDnsCacheStatsGet(SlDnsCacheStats_t *pStats)
+{
+    OSI_RET_OK_CHECK(sl_LockObjLock(&g_pCB->ProtectionLockObj, SL_OS_WAIT_FOREVER));
+    *pStats = g_SlDnsCache.Stats;
+    OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj));
+}
+#endif
+
+int sl_NetAppDnsGetHostByName(char * hostname, unsigned short usNameLen, unsigned long* out_ip_addr,unsigned char family)
+{
+    _SlDnsCacheEntry_t  *pE;
+    char                Name[SL_DNS_CACHE_NAME_LEN];
+    UINT32              Hash;
+    UINT32              Now;
+    INT16               Status;
+    UINT8               Slot;
+    UINT8               ObjIdx;
+    BOOLEAN             Refresh = FALSE;
+
+    if ((0 == usNameLen) || (SL_DNS_CACHE_NAME_LEN < usNameLen))
+    {
+        return _sl_DnsQuery(hostname, usNameLen, out_ip_addr, family);
+    }
+
+    Hash = _sl_DnsCacheHash(hostname, usNameLen);
+    Now = sl_DnsCacheTime();
+
+    OSI_RET_OK_CHECK(sl_LockObjLock(&g_pCB->ProtectionLockObj, SL_OS_WAIT_FOREVER));
+
+    Slot = _sl_DnsCacheFind(Hash, hostname, usNameLen, family);
+    if ((_SL_DNS_CACHE_NONE != Slot) && !_SL_DNS_EXPIRED(&g_SlDnsCache.Entries[Slot], Now))
+    {
+        pE = &g_SlDnsCache.Entries[Slot];
+        Status = pE->Status;
+        if (SL_RET_CODE_OK == Status)
+        {
+            g_SlDnsCache.Stats.Hits++;
+            sl_Memcpy((char *)out_ip_addr, (char *)pE->Ip, (SL_AF_INET == family) ? SL_IPV4_ADDRESS_SIZE : SL_IPV6_ADDRESS_SIZE);
+
+            /* close to expiry: resolve again in the background, this hit is answered now */
+            if (((INT32)(pE->Expires - Now) <= SL_DNS_CACHE_REFRESH) && (FALSE == g_SlDnsCache.RefreshPending))
+            {
+                g_SlDnsCache.RefreshPending = TRUE;
+                g_SlDnsCache.RefreshSlot = Slot;
+                sl_Memcpy(Name, pE->Name, usNameLen);
+                Refresh = TRUE;
+            }
+        }
+        else
+        {
+            g_SlDnsCache.Stats.NegativeHits++;
+        }
+
+        OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj));
+
+        if (Refresh)
+        {
+            if (SL_RET_CODE_OK != _sl_DnsQueryStart(Name, usNameLen, family, &g_SlDnsCache.RefreshRsp, &ObjIdx))
+            {
+                OSI_RET_OK_CHECK(sl_LockObjLock(&g_pCB->ProtectionLockObj, SL_OS_WAIT_FOREVER));
+                g_SlDnsCache.RefreshSlot = _SL_DNS_CACHE_NONE;
+                g_SlDnsCache.RefreshPending = FALSE;
+                OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj));
+            }
+        }
+        return Status;
+    }
+    g_SlDnsCache.Stats.Misses++;
+
+    OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj));
+
+    Status = _sl_DnsQuery(hostname, usNameLen, out_ip_addr, family);
+
+    /* only a server answer is cached as negative, not a local or timeout failure */
+    if ((SL_RET_CODE_OK == Status) || (SL_NET_APP_DNS_QUERY_FAILED == Status))
+    {
+        OSI_RET_OK_CHECK(sl_LockObjLock(&g_pCB->ProtectionLockObj, SL_OS_WAIT_FOREVER));
+        _sl_DnsCacheInsert(Hash, hostname, usNameLen, family, Status, (UINT8 *)out_ip_addr);
+        OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj));
+    }
+    return Status;
+}
+#elif _SL_INCLUDE_FUNC(sl_NetAppDnsGetHostByName)
+int sl_NetAppDnsGetHostByName(char * hostname, unsigned short usNameLen, unsigned long* out_ip_addr,unsigned char family)
+{
+    return _sl_DnsQuery(hostname, usNameLen, out_ip_addr, family);
 }
 #endif
 /******************************************************************************/
@@ -927,6 +1236,16 @@ void _sl_HandleAsync_DnsGetHostByName(void *pVoidBuf)
 	{
 		memcpy(g_pCB->ObjPool[g_pCB->FunctionParams.AsyncExt.ActionIndex].pRespArgs, pMsgArgs, sizeof(_GetHostByNameIPv4AsyncResponse_t));
 	}
+#if (defined(SL_INC_DNS_CACHE)) && _SL_INCLUDE_FUNC(sl_NetAppDnsGetHostByName)
+	if ((UINT8 *)&g_SlDnsCache.RefreshRsp == g_pCB->ObjPool[g_pCB->FunctionParams.AsyncExt.ActionIndex].pRespArgs)
+	{
+		UINT8 ObjIdx = g_pCB->FunctionParams.AsyncExt.ActionIndex;
+
+		OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj));
+		_sl_DnsCacheRefreshDone(ObjIdx);
+		return;
+	}
+#endif
 	OSI_RET_OK_CHECK(sl_SyncObjSignal(&(g_pCB->ObjPool[g_pCB->FunctionParams.AsyncExt.ActionIndex].SyncObj)));
 
     OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj));
@@ -45,6 +45,9 @@
 
 #define NONOS_MAX_SPAWN_ENTRIES		5
 
+/* the ring keeps one slot empty to tell full from empty */
+#define NONOS_SPAWN_RING_SIZE		(NONOS_MAX_SPAWN_ENTRIES + 1)
+
 typedef struct
 {
 	_SlSpawnEntryFunc_t 		pEntry;
@@ -53,11 +56,21 @@ typedef struct
 
 typedef struct
 {
-	_SlNonOsSpawnEntry_t	SpawnEntries[NONOS_MAX_SPAWN_ENTRIES];
+	_SlNonOsSpawnEntry_t	SpawnEntries[NONOS_SPAWN_RING_SIZE];
+	volatile unsigned char	Head;		/* next entry to run, moved by the main loop only */
+	volatile unsigned char	Tail;		/* next free slot, moved by _SlNonOsSpawn with interrupts masked */
+	unsigned long			Overflow;	/* entries refused because the ring was full */
 }_SlNonOsCB_t;
 
 _SlNonOsCB_t g__SlNonOsCB;
 
+/* the ring is filled both from the Host IRQ and from the main context */
+/* (_SlDrvMsgReadCmdCtx), so the producers mask interrupts around the enqueue */
+#ifndef sl_NonOsIntMask
+#define sl_NonOsIntMask()			(0)
+#define sl_NonOsIntRestore(Masked)
+#endif
+
 
 _SlNonOsRetVal_t _SlNonOsSemSet(_SlNonOsSemObj_t* pSemObj , _SlNonOsSemObj_t Value)
 {
@@ -94,46 +107,51 @@ _SlNonOsRetVal_t _SlNonOsSemGet(_SlNonOsSemObj_t* pSyncObj, _SlNonOsSemObj_t Wai
 
 _SlNonOsRetVal_t _SlNonOsSpawn(_SlSpawnEntryFunc_t pEntry , void* pValue , unsigned long flags)
 {
-	int i;
-	
-	for (i=0 ; i<NONOS_MAX_SPAWN_ENTRIES ; i++)
+	_SlNonOsCB_t* pR = &g__SlNonOsCB;
+	unsigned char Masked;
+	unsigned char Next;
+
+	Masked = sl_NonOsIntMask();
+
+	Next = (pR->Tail + 1) % NONOS_SPAWN_RING_SIZE;
+	if (Next == pR->Head)
 	{
-		_SlNonOsSpawnEntry_t* pE = &g__SlNonOsCB.SpawnEntries[i];
-	
-		if (NULL == pE->pEntry)
-		{
-			pE->pValue = pValue;
-			pE->pEntry = pEntry;
-			break;
-		}
+		pR->Overflow++;
+		sl_NonOsIntRestore(Masked);
+		return NONOS_RET_ERR;
 	}
-        
-        
-        return NONOS_RET_OK;
+
+	pR->SpawnEntries[pR->Tail].pValue = pValue;
+	pR->SpawnEntries[pR->Tail].pEntry = pEntry;
+	pR->Tail = Next;
+
+	sl_NonOsIntRestore(Masked);
+
+	return NONOS_RET_OK;
 }
 
 
 _SlNonOsRetVal_t _SlNonOsMainLoopTask(void)
 {
-	int i;
-	
-	for (i=0 ; i<NONOS_MAX_SPAWN_ENTRIES ; i++)
+	_SlNonOsCB_t*			pR = &g__SlNonOsCB;
+	_SlNonOsSpawnEntry_t	E;
+	int						Count;
+
+	/* run at most what a full ring holds, so that entries spawned */
+	/* meanwhile are left for the next call */
+	for (Count = 0 ; (Count < NONOS_MAX_SPAWN_ENTRIES) && (pR->Head != pR->Tail) ; Count++)
 	{
-		_SlNonOsSpawnEntry_t* pE = &g__SlNonOsCB.SpawnEntries[i];
-		_SlSpawnEntryFunc_t 		pF = pE->pEntry;
-		
-		if (NULL != pF)
+		E = pR->SpawnEntries[pR->Head];
+		pR->Head = (pR->Head + 1) % NONOS_SPAWN_RING_SIZE;
+
+		/* an Rx read is stale if the message was already read by the command context */
+		if ((g_pCB)->RxIrqCnt != (g_pCB)->RxDoneCnt)
 		{
-                        if((g_pCB)->RxIrqCnt != (g_pCB)->RxDoneCnt)
-            {
-				pF(0);/*(pValue);*/
-		}
-			pE->pEntry = NULL;
-			pE->pValue = NULL;
+			E.pEntry(E.pValue);
 		}
 	}
-        
-        return NONOS_RET_OK;
+
+	return NONOS_RET_OK;
 }
     
 #endif /*(SL_PLATFORM != SL_PLATFORM_NON_OS)*/
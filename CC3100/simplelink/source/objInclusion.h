@@ -173,6 +173,8 @@ extern "C" {
 #define _SL_INC_sl_NetAppStop           __nap
 
 #define _SL_INC_sl_NetAppDnsGetHostByName     __nap__clt
+#define _SL_INC_sl_NetAppDnsCacheFlush        __nap__clt
+#define _SL_INC_sl_NetAppDnsCacheStatsGet     __nap__clt
 
 
 #define _SL_INC_sl_NetAppDnsGetHostByService			__nap__clt
@@ -235,6 +237,8 @@ extern "C" {
 
 #define _SL_INC_sl_Recv                 __sck__rcv
 
+#define _SL_INC_sl_RecvVec              __sck__rcv
+
 #define _SL_INC_sl_RecvFrom             __sck__rcv
 
 #define _SL_INC_sl_Write                __sck__snd
@@ -53,6 +53,93 @@ void   _sl_HandleAsync_Connect(void *pVoidBuf);
 void   _sl_HandleAsync_Accept(void *pVoidBuf);
 void   _sl_HandleAsync_Select(void *pVoidBuf);
 unsigned int _sl_TruncatePayloadByProtocol(const UINT8 pSd,const unsigned int length);  
+int    _sl_SendFlush(int sd, int flags);
+void   _sl_ReadyUpdate(UINT16 ReadMask, UINT16 ReadFds, UINT16 WriteMask, UINT16 WriteFds);
+
+/*  Socket readiness, one bit per socket. Bits are set from the select responses
+    of the device and cleared as soon as the socket is read, accepted on, sent on
+    or closed, so a set bit holds without asking the device again */
+typedef struct
+{
+    UINT16  Read;
+    UINT16  Write;
+    UINT16  PollRead;           /* sl_PollCtl interest */
+    UINT16  PollWrite;
+    UINT16  ReportedRead;       /* state last returned by sl_Poll */
+    UINT16  ReportedWrite;
+    UINT16  ReportedErr;
+    INT16   PollSd[SL_MAX_SOCKETS];
+}_SlSockReady_t;
+
+static _SlSockReady_t g_SockReady;
+
+#define _SL_SD_BIT(sd)          ((UINT16)(1 << ((sd) & BSD_SOCKET_ID_MASK)))
+
+/*  Writes sent with SL_MSG_MORE are held here, for one socket at a time.
+    Shared by all tasks, so only used with CoalesceLockObj held */
+#ifndef SL_SEND_COALESCE_SIZE
+#define SL_SEND_COALESCE_SIZE   (256)
+#endif
+
+typedef struct
+{
+    UINT8   Buf[SL_SEND_COALESCE_SIZE];
+    UINT16  Len;
+    int     Sd;
+}_SlSendCoalesce_t;
+
+#if _SL_INCLUDE_FUNC(sl_Send)
+static _SlSendCoalesce_t g_SendCoalesce;
+#endif
+
+/* ******************************************************************************/
+/*  _sl_ReadyUpdate */
+/* ******************************************************************************/
+void _sl_ReadyUpdate(UINT16 ReadMask, UINT16 ReadFds, UINT16 WriteMask, UINT16 WriteFds)
+{
+    OSI_RET_OK_CHECK(sl_LockObjLock(&g_pCB->ProtectionLockObj, SL_OS_WAIT_FOREVER));
+
+    g_SockReady.Read  = (g_SockReady.Read  & ~ReadMask)  | (ReadFds  & ReadMask);
+    g_SockReady.Write = (g_SockReady.Write & ~WriteMask) | (WriteFds & WriteMask);
+
+    OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj));
+}
+
+/* ******************************************************************************/
+/*  _sl_ReadyForget */
+/* ******************************************************************************/
+/*  Forget all that is known about the socket ID of sd: it was closed, or it was
+    just handed out again by the device */
+static void _sl_ReadyForget(int sd)
+{
+    UINT16 Bit = _SL_SD_BIT(sd);
+
+    OSI_RET_OK_CHECK(sl_LockObjLock(&g_pCB->ProtectionLockObj, SL_OS_WAIT_FOREVER));
+
+    g_SockReady.Read          &= ~Bit;
+    g_SockReady.Write         &= ~Bit;
+    g_SockReady.PollRead      &= ~Bit;
+    g_SockReady.PollWrite     &= ~Bit;
+    g_SockReady.ReportedRead  &= ~Bit;
+    g_SockReady.ReportedWrite &= ~Bit;
+    g_SockReady.ReportedErr   &= ~Bit;
+
+    OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj));
+}
+
+/* ******************************************************************************/
+/*  _sl_SocketReset */
+/* ******************************************************************************/
+/*  Forget the socket state kept on the host, from sl_Start and sl_Stop */
+void _sl_SocketReset(void)
+{
+    sl_Memset(&g_SockReady, 0, sizeof(g_SockReady));
+
+#if _SL_INCLUDE_FUNC(sl_Send)
+    /*  bytes held by SL_MSG_MORE belong to a connection that is gone */
+    g_SendCoalesce.Len = 0;
+#endif
+}
 
 
 
@@ -203,6 +290,8 @@ int sl_Socket(int Domain, int Type, int Protocol)
 	}
 	else
 	{
+        /*  the ID may have been used before, without a clean sl_Close */
+        _sl_ReadyForget((UINT8)Msg.Rsp.sd);
     return (int)((UINT8)Msg.Rsp.sd);
 }
 }
@@ -231,6 +320,13 @@ int sl_Close(int sd)
 
     Msg.Cmd.sd = (UINT8)sd;
 
+#if _SL_INCLUDE_FUNC(sl_Send)
+    /*  send what is still held by SL_MSG_MORE before the socket goes away */
+    _sl_SendFlush(sd, 0);
+#endif
+
+    _sl_ReadyForget(sd);
+
     VERIFY_RET_OK(_SlDrvCmdOp((_SlCmdCtrl_t *)&_SlSockCloseCmdCtrl, &Msg, NULL));
 
     return Msg.Rsp.statusOrLen;
@@ -411,6 +507,9 @@ int sl_RecvFrom(int sd, void *buf, int Len, int flags, SlSockAddr_t *from, SlSoc
     Msg.Cmd.FamilyAndFlags = (Msg.Cmd.FamilyAndFlags << 4) & 0xF0;
     Msg.Cmd.FamilyAndFlags |= flags & 0x0F;
 
+    /*  the socket is no longer known to be readable once it is read */
+    _sl_ReadyUpdate(_SL_SD_BIT(sd), 0, 0, 0);
+
     RetVal = _SlDrvDataReadOp((_SlSd_t)sd, (_SlCmdCtrl_t *)&_SlRecvfomCmdCtrl, &Msg, &CmdExt);
     if( RetVal != SL_OS_RET_CODE_OK )
     {
@@ -569,7 +668,7 @@ const _SlCmdCtrl_t _SlSendCmdCtrl =
 };
 
 #if _SL_INCLUDE_FUNC(sl_Send)
-int sl_Send(int sd, const void *pBuf, int Len, int flags)
+static int _sl_SendChunks(int sd, const void *pBuf, int Len, int flags)
 {
     _SlSendMsg_u   Msg;
     _SlCmdExt_t    CmdExt;
@@ -616,12 +715,101 @@ int sl_Send(int sd, const void *pBuf, int Len, int flags)
         }
         else
         {
-            return RetVal;
+            break;
         }
     }while((ChunkLen > 0) && (runSingleChunk==FALSE));
-    
+
+    /*  the send may have used up the buffers of the device, or failed: the */
+    /*  socket is not known to be writable any more */
+    _sl_ReadyUpdate(0, 0, _SL_SD_BIT(sd), 0);
+
+    if(SL_OS_RET_CODE_OK != RetVal)
+    {
+        return RetVal;
+    }
+
     return (int)Len;
 }
+
+/*  Send the data held for sd, if any, as one message. CoalesceLockObj must be held */
+static int _sl_SendHeld(int sd, int flags)
+{
+    UINT16 Len = g_SendCoalesce.Len;
+
+    if((0 == Len) || (g_SendCoalesce.Sd != sd))
+    {
+        return 0;
+    }
+
+    /*  the held data is dropped on error, the same way a failed sl_Send drops its data */
+    g_SendCoalesce.Len = 0;
+
+    return _sl_SendChunks(sd, g_SendCoalesce.Buf, Len, flags);
+}
+
+/*  Send the data held for sd, if any, as one message */
+int _sl_SendFlush(int sd, int flags)
+{
+    int RetVal;
+
+    OSI_RET_OK_CHECK(sl_LockObjLock(&g_pCB->CoalesceLockObj, SL_OS_WAIT_FOREVER));
+    RetVal = _sl_SendHeld(sd, flags);
+    OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->CoalesceLockObj));
+
+    return RetVal;
+}
+
+int sl_Send(int sd, const void *pBuf, int Len, int flags)
+{
+    int RetVal = 0;
+
+    /*  transceiver mode relays the flags with every frame, so it is never coalesced */
+    if((sd & SL_SOCKET_PAYLOAD_TYPE_MASK) == SL_SOCKET_PAYLOAD_TYPE_RAW_TRANCEIVER)
+    {
+        return _sl_SendChunks(sd, pBuf, Len, flags);
+    }
+
+    /*  the lock is held while the buffer is filled or sent, not for direct sends */
+    OSI_RET_OK_CHECK(sl_LockObjLock(&g_pCB->CoalesceLockObj, SL_OS_WAIT_FOREVER));
+
+    /*  Only the socket holding the buffer may use it, others are sent right away */
+    if((g_SendCoalesce.Len > 0) && (g_SendCoalesce.Sd != sd))
+    {
+        OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->CoalesceLockObj));
+        return _sl_SendChunks(sd, pBuf, Len, flags);
+    }
+
+    /*  the new data does not fit behind what is held: send that first */
+    if((g_SendCoalesce.Len + Len) > SL_SEND_COALESCE_SIZE)
+    {
+        RetVal = _sl_SendHeld(sd, flags);
+    }
+
+    if((RetVal >= 0) &&
+       ((flags & SL_MSG_MORE) || (g_SendCoalesce.Len > 0)) &&
+       ((g_SendCoalesce.Len + Len) <= SL_SEND_COALESCE_SIZE))
+    {
+        sl_Memcpy(&g_SendCoalesce.Buf[g_SendCoalesce.Len], pBuf, Len);
+        g_SendCoalesce.Len += Len;
+        g_SendCoalesce.Sd = sd;
+
+        if(!(flags & SL_MSG_MORE))
+        {
+            RetVal = _sl_SendHeld(sd, flags);
+        }
+        OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->CoalesceLockObj));
+
+        return (RetVal < 0) ? RetVal : Len;
+    }
+
+    OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->CoalesceLockObj));
+    if(RetVal < 0)
+    {
+        return RetVal;
+    }
+
+    return _sl_SendChunks(sd, pBuf, Len, flags);
+}
 #endif
 
 /*******************************************************************************/
@@ -685,6 +873,9 @@ int sl_Accept(int sd, SlSockAddr_t *addr, SlSocklen_t *addrlen)
 
 	/* Use Obj to issue the command, if not available try later */
 	pObjIdx = _SlDrvWaitForPoolObj(ACCEPT_ID, sd  & BSD_SOCKET_ID_MASK);
+
+    /*  a listening socket is readable while connections wait to be accepted */
+    _sl_ReadyUpdate(_SL_SD_BIT(sd), 0, 0, 0);
 	
 	if (MAX_CONCURRENT_ACTIONS == pObjIdx)
 	{
@@ -761,6 +952,12 @@ int sl_Accept(int sd, SlSockAddr_t *addr, SlSocklen_t *addrlen)
     }
 
     _SlDrvReleasePoolObj(pObjIdx);
+
+    /*  the accepted socket may reuse an ID used before, without a clean sl_Close */
+    if(RetVal >= 0)
+    {
+        _sl_ReadyForget(RetVal);
+    }
     return (int)RetVal;
 }
 #endif
@@ -861,11 +1058,20 @@ int sl_Recv(int sd, void *pBuf, int Len, int flags)
 
     Msg.Cmd.FamilyAndFlags = flags & 0x0F;
 
+    /*  the socket is no longer known to be readable once it is read */
+    _sl_ReadyUpdate(_SL_SD_BIT(sd), 0, 0, 0);
+
     status = _SlDrvDataReadOp((_SlSd_t)sd, (_SlCmdCtrl_t *)&_SlRecvCmdCtrl, &Msg, &CmdExt);
     if( status != SL_OS_RET_CODE_OK )
     {
 	return status;
     }
+
+    /*  end of stream: every further read returns at once */
+    if(0 == Msg.Rsp.statusOrLen)
+    {
+        _sl_ReadyUpdate(_SL_SD_BIT(sd), _SL_SD_BIT(sd), 0, 0);
+    }
      
     /*  if the Device side sends less than expected it is not the Driver's role */
     /*  the returned value could be smaller than the requested size */
@@ -873,6 +1079,121 @@ int sl_Recv(int sd, void *pBuf, int Len, int flags)
 }
 #endif
 
+/*******************************************************************************/
+/*  sl_RecvVec */
+/*******************************************************************************/
+#if _SL_INCLUDE_FUNC(sl_RecvVec)
+int sl_RecvVec(int sd, SlRecvSeg_t *pSegs, int NumSegs, int flags)
+{
+    _SlRecvMsg_u    Msg;
+    _SlCmdExt_t     CmdExt;
+    _SlReturnVal_t  status;
+    UINT32          Len = 0;
+    int             Idx;
+
+    if((NumSegs < 1) || (NumSegs > 0xFF))
+    {
+        return SL_RET_CODE_INVALID_INPUT;
+    }
+
+    /*  the payload pointer only has to be valid, the data goes to the segments */
+    CmdExt.pRxPayload = NULL;
+    for(Idx = 0; Idx < NumSegs; Idx++)
+    {
+        if((NULL == CmdExt.pRxPayload) && (pSegs[Idx].Len > 0))
+        {
+            CmdExt.pRxPayload = pSegs[Idx].pBuf;
+        }
+        Len += pSegs[Idx].Len;
+    }
+
+    if(0 == Len)
+    {
+        return SL_RET_CODE_INVALID_INPUT;
+    }
+
+    /*  a single request is limited by the 16 bits length field, */
+    /*  the segments may be larger than what is asked for */
+    if(Len > 0xFFFF)
+    {
+        Len = 0xFFFF;
+    }
+
+    CmdExt.TxPayloadLen = 0;
+    CmdExt.RxPayloadLen = (UINT16)Len;
+    CmdExt.pTxPayload = NULL;
+
+    Msg.Cmd.sd = sd;
+    Msg.Cmd.StatusOrLen = (UINT16)Len;
+    Msg.Cmd.FamilyAndFlags = flags & 0x0F;
+
+    _sl_ReadyUpdate(_SL_SD_BIT(sd), 0, 0, 0);
+
+    status = _SlDrvDataReadVecOp((_SlSd_t)sd, (_SlCmdCtrl_t *)&_SlRecvCmdCtrl, &Msg, &CmdExt, pSegs, (UINT8)NumSegs);
+    if( status != SL_OS_RET_CODE_OK )
+    {
+	return status;
+    }
+
+    if(0 == Msg.Rsp.statusOrLen)
+    {
+        _sl_ReadyUpdate(_SL_SD_BIT(sd), _SL_SD_BIT(sd), 0, 0);
+    }
+
+    return (int)Msg.Rsp.statusOrLen;
+}
+
+#ifdef SL_INC_RINGBUF_RECV
+/*******************************************************************************/
+/*  sl_RecvRingBuf */
+/*******************************************************************************/
+int sl_RecvRingBuf(int sd, tRingBufObject *psRingBuf, int flags)
+{
+    SlRecvSeg_t     Segs[2];
+    UINT32          Free;
+    int             Status;
+
+    /*  the free space is contiguous from the write index up to the read index */
+    /*  or up to the end of the buffer. In the latter case the rest of it, if */
+    /*  any, starts again at the beginning. The reader may free more space */
+    /*  meanwhile, so the contiguous part is taken first. A request is limited */
+    /*  to the 16 bits length field of sl_RecvVec, so a ring larger than that */
+    /*  is filled over several calls */
+    Free = RingBufContigFree(psRingBuf);
+    if(Free > 0xFFFF)
+    {
+        Free = 0xFFFF;
+    }
+    Segs[0].pBuf = psRingBuf->pui8Buf + psRingBuf->ui32WriteIndex;
+    Segs[0].Len = (UINT16)Free;
+    Segs[1].pBuf = psRingBuf->pui8Buf;
+    Segs[1].Len = 0;
+    if((psRingBuf->ui32WriteIndex + Free) == psRingBuf->ui32Size)
+    {
+        Free = RingBufFree(psRingBuf);
+        if(Free > 0xFFFF)
+        {
+            Free = 0xFFFF;
+        }
+        Segs[1].Len = (UINT16)(Free - Segs[0].Len);
+    }
+
+    if(0 == Free)
+    {
+        return SL_RET_CODE_INVALID_INPUT;
+    }
+
+    Status = sl_RecvVec(sd, Segs, (Segs[1].Len > 0) ? 2 : 1, flags);
+    if(Status > 0)
+    {
+        RingBufAdvanceWrite(psRingBuf, (UINT32)Status);
+    }
+
+    return Status;
+}
+#endif
+#endif
+
 /*******************************************************************************/
 /*  sl_SetSockOpt */
 /*******************************************************************************/
@@ -980,28 +1301,74 @@ const _SlCmdCtrl_t _SlSelectCmdCtrl =
 };
 
 #if _SL_INCLUDE_FUNC(sl_Select)
+static int _sl_BitCount(UINT16 Bits)
+{
+    int Count = 0;
+
+    while(Bits)
+    {
+        Bits &= (Bits - 1);
+        Count++;
+    }
+    return Count;
+}
+
+/*  Return only the sockets known to be ready, in the caller's sets */
+static int _sl_SelectKnown(SlFdSet_t *readsds, SlFdSet_t *writesds, UINT16 ReadHit, UINT16 WriteHit)
+{
+    if( readsds )
+    {
+        readsds->fd_array[0] = ReadHit;
+    }
+    if( writesds )
+    {
+        writesds->fd_array[0] = WriteHit;
+    }
+    return _sl_BitCount(ReadHit) + _sl_BitCount(WriteHit);
+}
+
 int sl_Select(int nfds, SlFdSet_t *readsds, SlFdSet_t *writesds, SlFdSet_t *exceptsds, struct SlTimeval_t *timeout)
 {
     _SlSelectMsg_u          Msg;
     _SelectAsyncResponse_t  AsyncRsp;
 	UINT8 pObjIdx = MAX_CONCURRENT_ACTIONS;
+    UINT16                  ReadHit = 0;
+    UINT16                  WriteHit = 0;
+    UINT16                  ReadReq;
+    UINT16                  WriteReq;
+
+    /*  sockets already known to be ready are not asked about again. The device */
+    /*  is still asked about the others, without waiting if some are known ready */
+    ReadReq = 0;
+    WriteReq = 0;
+    if( readsds )
+    {
+        ReadHit = (UINT16)readsds->fd_array[0] & g_SockReady.Read;
+        ReadReq = (UINT16)readsds->fd_array[0] & ~ReadHit;
+    }
+    if( writesds )
+    {
+        WriteHit = (UINT16)writesds->fd_array[0] & g_SockReady.Write;
+        WriteReq = (UINT16)writesds->fd_array[0] & ~WriteHit;
+    }
+    if( (ReadHit | WriteHit) && (0 == (ReadReq | WriteReq)) )
+    {
+        return _sl_SelectKnown(readsds, writesds, ReadHit, WriteHit);
+    }
 
     Msg.Cmd.nfds          = nfds;
     Msg.Cmd.readFdsCount  = 0;
     Msg.Cmd.writeFdsCount = 0;
     
-    Msg.Cmd.readFds = 0;
-    Msg.Cmd.writeFds = 0; 
-    
-    if( readsds )
-    {
-       Msg.Cmd.readFds       = (UINT16)readsds->fd_array[0];  
-    }
-    if( writesds )
+    Msg.Cmd.readFds       = ReadReq;
+    Msg.Cmd.writeFds      = WriteReq;
+
+    if( ReadHit | WriteHit )
     {
-       Msg.Cmd.writeFds      = (UINT16)writesds->fd_array[0]; 
+        Msg.Cmd.tv_sec = 0;
+        Msg.Cmd.tv_usec = 0;
     }
-	if( NULL == timeout )
+	else if( NULL == timeout )
 	{
 		Msg.Cmd.tv_sec = 0xffff;
 		Msg.Cmd.tv_usec = 0xffff;
@@ -1032,6 +1399,10 @@ int sl_Select(int nfds, SlFdSet_t *readsds, SlFdSet_t *writesds, SlFdSet_t *exce
 
 	if (MAX_CONCURRENT_ACTIONS == pObjIdx)
 	{
+        if( ReadHit | WriteHit )
+        {
+            return _sl_SelectKnown(readsds, writesds, ReadHit, WriteHit);
+        }
 		return SL_POOL_IS_EMPTY;
 	}
 	OSI_RET_OK_CHECK(sl_LockObjLock(&g_pCB->ProtectionLockObj, SL_OS_WAIT_FOREVER));
@@ -1049,18 +1420,21 @@ int sl_Select(int nfds, SlFdSet_t *readsds, SlFdSet_t *writesds, SlFdSet_t *exce
 
         if(  ((int)Msg.Rsp.status) >= 0 )
         {
-            if( readsds )
-            {
-               readsds->fd_array[0]  = AsyncRsp.readFds;
-            }
-            if( writesds )
-            {
-               writesds->fd_array[0] = AsyncRsp.writeFds;      
-            }
+            _sl_ReadyUpdate(ReadReq, AsyncRsp.readFds, WriteReq, AsyncRsp.writeFds);
+
+            Msg.Rsp.status = (INT16)_sl_SelectKnown(readsds, writesds,
+                                                    ReadHit | (AsyncRsp.readFds & ReadReq),
+                                                    WriteHit | (AsyncRsp.writeFds & WriteReq));
         }
     }
 
     _SlDrvReleasePoolObj(pObjIdx);
+
+    /*  the sockets known to be ready are reported even if the device was not */
+    if( (((int)Msg.Rsp.status) < 0) && (ReadHit | WriteHit) )
+    {
+        return _sl_SelectKnown(readsds, writesds, ReadHit, WriteHit);
+    }
     return (int)Msg.Rsp.status;
 }
 
@@ -1098,6 +1472,123 @@ void SL_FD_ZERO(SlFdSet_t *fdset)
   fdset->fd_array[0] = 0;
 }
 
+/*******************************************************************************/
+/*  sl_PollCtl */
+/*******************************************************************************/
+int sl_PollCtl(int sd, unsigned short Events)
+{
+    UINT16 Bit = _SL_SD_BIT(sd);
+
+    if((sd & BSD_SOCKET_ID_MASK) >= SL_MAX_SOCKETS)
+    {
+        return SL_RET_CODE_INVALID_INPUT;
+    }
+
+    OSI_RET_OK_CHECK(sl_LockObjLock(&g_pCB->ProtectionLockObj, SL_OS_WAIT_FOREVER));
+
+    g_SockReady.PollSd[sd & BSD_SOCKET_ID_MASK] = (INT16)sd;
+    g_SockReady.PollRead  = (Events & SL_POLLIN)  ? (g_SockReady.PollRead | Bit)  : (g_SockReady.PollRead & ~Bit);
+    g_SockReady.PollWrite = (Events & SL_POLLOUT) ? (g_SockReady.PollWrite | Bit) : (g_SockReady.PollWrite & ~Bit);
+
+    /*  report the current state of the socket on the next sl_Poll */
+    g_SockReady.ReportedRead  &= ~Bit;
+    g_SockReady.ReportedWrite &= ~Bit;
+    g_SockReady.ReportedErr   &= ~Bit;
+
+    OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj));
+
+    return 0;
+}
+
+/*******************************************************************************/
+/*  _sl_PollCollect */
+/*******************************************************************************/
+/*  Fill pEvents with the watched sockets that became ready since they were last
+    reported, from the readiness known to the host only */
+static int _sl_PollCollect(SlPollEvent_t *pEvents, int MaxEvents)
+{
+    UINT16  Read;
+    UINT16  Write;
+    UINT16  Err;
+    UINT16  Bit;
+    int     Idx;
+    int     Count = 0;
+
+    OSI_RET_OK_CHECK(sl_LockObjLock(&g_pCB->ProtectionLockObj, SL_OS_WAIT_FOREVER));
+
+    Read  = g_SockReady.Read & g_SockReady.PollRead;
+    Write = g_SockReady.Write & g_SockReady.PollWrite;
+    Err   = g_pCB->SocketTXFailure & (g_SockReady.PollRead | g_SockReady.PollWrite);
+
+    for(Idx = 0; (Idx < SL_MAX_SOCKETS) && (Count < MaxEvents); Idx++)
+    {
+        Bit = (UINT16)(1 << Idx);
+
+        if(((Read & ~g_SockReady.ReportedRead) | (Write & ~g_SockReady.ReportedWrite) |
+            (Err & ~g_SockReady.ReportedErr)) & Bit)
+        {
+            pEvents[Count].sd = g_SockReady.PollSd[Idx];
+            pEvents[Count].Events = ((Read & Bit) ? SL_POLLIN : 0) |
+                                    ((Write & Bit) ? SL_POLLOUT : 0) |
+                                    ((Err & Bit) ? SL_POLLERR : 0);
+            Count++;
+        }
+
+        g_SockReady.ReportedRead  = (g_SockReady.ReportedRead  & ~Bit) | (Read  & Bit);
+        g_SockReady.ReportedWrite = (g_SockReady.ReportedWrite & ~Bit) | (Write & Bit);
+        g_SockReady.ReportedErr   = (g_SockReady.ReportedErr   & ~Bit) | (Err   & Bit);
+    }
+
+    OSI_RET_OK_CHECK(sl_LockObjUnlock(&g_pCB->ProtectionLockObj));
+
+    return Count;
+}
+
+/*******************************************************************************/
+/*  sl_Poll */
+/*******************************************************************************/
+int sl_Poll(SlPollEvent_t *pEvents, int MaxEvents, struct SlTimeval_t *timeout)
+{
+    SlFdSet_t       ReadFds;
+    SlFdSet_t       WriteFds;
+    SlTimeval_t     Timeout;
+    int             RetVal;
+
+    if((NULL == pEvents) || (MaxEvents < 1))
+    {
+        return SL_RET_CODE_INVALID_INPUT;
+    }
+
+    RetVal = _sl_PollCollect(pEvents, MaxEvents);
+    if(RetVal > 0)
+    {
+        return RetVal;
+    }
+
+    /*  nothing new is known: ask the device once about every watched socket */
+    /*  that is not ready yet */
+    ReadFds.fd_array[0] = g_SockReady.PollRead & ~g_SockReady.Read;
+    WriteFds.fd_array[0] = g_SockReady.PollWrite & ~g_SockReady.Write;
+    if((0 == ReadFds.fd_array[0]) && (0 == WriteFds.fd_array[0]))
+    {
+        return 0;
+    }
+
+    /*  sl_Select converts the timeout in place */
+    if(NULL != timeout)
+    {
+        Timeout = *timeout;
+    }
+
+    RetVal = sl_Select(SL_FD_SETSIZE, &ReadFds, &WriteFds, NULL, (NULL != timeout) ? &Timeout : NULL);
+    if(RetVal <= 0)
+    {
+        return RetVal;
+    }
+
+    return _sl_PollCollect(pEvents, MaxEvents);
+}
+
 #endif
 
 /*******************************************************************************/
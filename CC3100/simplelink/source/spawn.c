@@ -54,6 +54,7 @@ typedef struct
     _SlInternalSpawnEntry_t*    pFree;
     _SlInternalSpawnEntry_t*    pWaitForExe;
     _SlInternalSpawnEntry_t*    pLastInWaitList;
+    unsigned long               Overflow;   /* entries refused because no free entry was left */
     _SlSyncObj_t                SyncObj;
     _SlLockObj_t                LockObj;
 }_SlInternalSpawnCB_t;
@@ -65,7 +66,6 @@ void _SlInternalSpawnTaskEntry()
 {
     int                         i;
     _SlInternalSpawnEntry_t*    pEntry;
-    BOOLEAN                     LastEntry;
 
     /* create and lock the locking object. lock in order to avoid race condition 
         on the first creation */
@@ -79,6 +79,7 @@ void _SlInternalSpawnTaskEntry()
     g_SlInternalSpawnCB.pFree = &g_SlInternalSpawnCB.SpawnEntries[0];
     g_SlInternalSpawnCB.pWaitForExe = NULL;
     g_SlInternalSpawnCB.pLastInWaitList = NULL;
+    g_SlInternalSpawnCB.Overflow = 0;
 
     /* create the link list between the entries */
     for (i=0 ; i<_SL_MAX_INTERNAL_SPAWN_ENTRIES - 1 ; i++)
@@ -96,52 +97,42 @@ void _SlInternalSpawnTaskEntry()
     while (TRUE)
     {
         sl_SyncObjWait(&g_SlInternalSpawnCB.SyncObj,SL_OS_WAIT_FOREVER);
-        /* go over all entries that already waiting for execution */
-        LastEntry = FALSE;
-        do
+        /* go over all entries that are waiting for execution, including the
+           ones spawned meanwhile */
+        while (TRUE)
         {
             /* get entry to execute */
             sl_LockObjLock(&g_SlInternalSpawnCB.LockObj,SL_OS_WAIT_FOREVER);
 
             pEntry = g_SlInternalSpawnCB.pWaitForExe;
-            if ( NULL == pEntry )
-            {
-               sl_LockObjUnlock(&g_SlInternalSpawnCB.LockObj);
-               break;
-            }
-            g_SlInternalSpawnCB.pWaitForExe = pEntry->pNext;
-            if (pEntry == g_SlInternalSpawnCB.pLastInWaitList)
+            if (NULL != pEntry)
             {
-                g_SlInternalSpawnCB.pLastInWaitList = NULL;
-                LastEntry = TRUE;
+                g_SlInternalSpawnCB.pWaitForExe = pEntry->pNext;
+                if (pEntry == g_SlInternalSpawnCB.pLastInWaitList)
+                {
+                    g_SlInternalSpawnCB.pLastInWaitList = NULL;
+                }
             }
 
             sl_LockObjUnlock(&g_SlInternalSpawnCB.LockObj);
 
-
             /* pEntry could be null in case that the sync was already set by some
                of the entries during execution of earlier entry */
-            if (NULL != pEntry)
+            if (NULL == pEntry)
             {
-                pEntry->pEntry(pEntry->pValue);
-                /* free the entry */
-                sl_LockObjLock(&g_SlInternalSpawnCB.LockObj,SL_OS_WAIT_FOREVER);
-
-                pEntry->pNext = g_SlInternalSpawnCB.pFree;
-                g_SlInternalSpawnCB.pFree = pEntry;
+                break;
+            }
 
+            pEntry->pEntry(pEntry->pValue);
 
-                if (NULL != g_SlInternalSpawnCB.pWaitForExe)
-                {
-                    /* new entry received meanwhile */
-                    LastEntry = FALSE;
-                }
+            /* free the entry */
+            sl_LockObjLock(&g_SlInternalSpawnCB.LockObj,SL_OS_WAIT_FOREVER);
 
-                sl_LockObjUnlock(&g_SlInternalSpawnCB.LockObj);
+            pEntry->pNext = g_SlInternalSpawnCB.pFree;
+            g_SlInternalSpawnCB.pFree = pEntry;
 
-            }
-
-        }while (!LastEntry);
+            sl_LockObjUnlock(&g_SlInternalSpawnCB.LockObj);
+        }
     }
 }
 
@@ -160,6 +151,13 @@ int _SlInternalSpawn(_SlSpawnEntryFunc_t pEntry , void* pValue , unsigned long f
         sl_LockObjLock(&g_SlInternalSpawnCB.LockObj,SL_OS_WAIT_FOREVER);
 
         pSpawnEntry = g_SlInternalSpawnCB.pFree;
+        if (NULL == pSpawnEntry)
+        {
+            /* all entries are waiting for execution: refuse instead of corrupting the lists */
+            g_SlInternalSpawnCB.Overflow++;
+            sl_LockObjUnlock(&g_SlInternalSpawnCB.LockObj);
+            return -1;
+        }
         g_SlInternalSpawnCB.pFree = pSpawnEntry->pNext;
 
         pSpawnEntry->pEntry = pEntry;
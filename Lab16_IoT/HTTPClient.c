@@ -0,0 +1,366 @@
+// HTTPClient.c
+// Runs on TM4C123 with the CC3100 booster pack
+// Minimal HTTP/1.1 client over the SimpleLink socket API.
+// The TCP connection is kept open between requests, several
+// requests may be sent before their responses are read
+// (pipelining), and responses framed by Content-Length,
+// chunked transfer coding or connection close are read
+// so the next response starts in the right place.
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to ARM Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2014
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+#include "simplelink.h"
+#include "HTTPClient.h"
+#include <string.h>
+
+#define NOLENGTH 0xFFFFFFFF  // response without Content-Length
+
+// lower case of an ASCII letter
+static char Lower(char letter){
+  if((letter >= 'A')&&(letter <= 'Z')){
+    return letter+('a'-'A');
+  }
+  return letter;
+}
+
+// If line is the header name, return its value with leading
+// spaces skipped, otherwise return 0 (header names ignore case)
+static char *HeaderValue(char *line, const char *name){
+  while(*name){
+    if(Lower(*line) != Lower(*name)) return 0;
+    line++; name++;
+  }
+  if(*line != ':') return 0;
+  line++;
+  while((*line == ' ')||(*line == '\t')) line++;
+  return line;
+}
+
+// true if word appears in value, ignoring case
+static int Contains(const char *value, const char *word){
+  uint32_t i;
+  for(; *value; value++){
+    for(i=0; word[i]&&(Lower(value[i]) == word[i]); i++){};
+    if(word[i] == 0) return 1;
+  }
+  return 0;
+}
+
+// Close the socket and forget everything received on it
+static void Disconnect(HTTP_Client_t *c){
+  if(c->Sd >= 0){
+    sl_Close(c->Sd);
+  }
+  c->Sd = -1;
+  c->Start = c->End = 0;
+  c->Outstanding = 0;
+}
+
+// Open the TCP connection to the server
+static int32_t Connect(HTTP_Client_t *c){
+  SlSockAddrIn_t Addr;
+  int sd;
+
+  Addr.sin_family = SL_AF_INET;
+  Addr.sin_port = sl_Htons(c->Port);
+  Addr.sin_addr.s_addr = sl_Htonl(c->IP);   // to big endian
+
+  sd = sl_Socket(SL_AF_INET, SL_SOCK_STREAM, 0);
+  if(sd < 0){
+    return HTTP_ERR_CONNECT;
+  }
+  if(sl_Connect(sd, (SlSockAddr_t *)&Addr, sizeof(SlSockAddrIn_t)) < 0){
+    sl_Close(sd);
+    return HTTP_ERR_CONNECT;
+  }
+  c->Sd = sd;
+  c->Connects++;
+  return 0;
+}
+
+// Receive more bytes after the unread ones in Rx
+// Output: number of bytes received, or negative HTTP_ERR_ code
+static int32_t Fill(HTTP_Client_t *c){
+  int n;
+  if(c->Start){     // move the unread bytes to the front
+    memmove(c->Rx, &c->Rx[c->Start], c->End - c->Start);
+    c->End -= c->Start;
+    c->Start = 0;
+  }
+  if(c->End == HTTP_RX_SIZE){
+    return HTTP_ERR_FORMAT;   // a line longer than the buffer
+  }
+  n = sl_Recv(c->Sd, &c->Rx[c->End], HTTP_RX_SIZE - c->End, 0);
+  if(n <= 0){
+    return HTTP_ERR_CLOSED;
+  }
+  c->End += n;
+  c->RxBytes += n;
+  return n;
+}
+
+// Take the next line out of Rx, without its CR LF
+// The line is null terminated and valid until the next Fill
+// Output: line length, or negative HTTP_ERR_ code
+static int32_t ReadLine(HTTP_Client_t *c, char **line){
+  uint32_t i = c->Start;
+  int32_t n;
+  while(1){
+    for(; i < c->End; i++){
+      if(c->Rx[i] == '\n'){
+        *line = &c->Rx[c->Start];
+        n = i - c->Start;
+        if(n && (c->Rx[i-1] == '\r')) n--;
+        c->Rx[c->Start + n] = 0;
+        c->Start = i+1;
+        return n;
+      }
+    }
+    i -= c->Start;  // Fill moves the unread bytes to the front
+    n = Fill(c);
+    if(n < 0) return n;
+  }
+}
+
+// Read length body bytes, copying what fits into buf
+// A length of NOLENGTH reads until the server closes
+// Output: 0, or negative HTTP_ERR_ code
+static int32_t ReadBody(HTTP_Client_t *c, uint32_t length, char *buf, uint32_t size, uint32_t *copied){
+  uint32_t n, m;
+  int32_t err;
+  while(length){
+    if(c->Start == c->End){
+      err = Fill(c);
+      if(err < 0){
+        if((length == NOLENGTH)&&(err == HTTP_ERR_CLOSED)) return 0;
+        return err;
+      }
+    }
+    n = c->End - c->Start;
+    if(n > length) n = length;
+    if(*copied+1 < size){
+      m = size-1 - *copied;
+      if(m > n) m = n;
+      memcpy(&buf[*copied], &c->Rx[c->Start], m);
+      *copied += m;
+    }
+    c->Start += n;
+    if(length != NOLENGTH) length -= n;
+  }
+  return 0;
+}
+
+// Parse an unsigned number in base 10 or 16
+// Output: number of digits, 0 if none
+static uint32_t Number(const char *pt, uint32_t base, uint32_t *value){
+  uint32_t digits = 0, d;
+  *value = 0;
+  while(1){
+    if((*pt >= '0')&&(*pt <= '9')){
+      d = *pt-'0';
+    }else if((base == 16)&&(Lower(*pt) >= 'a')&&(Lower(*pt) <= 'f')){
+      d = Lower(*pt)-'a'+10;
+    }else{
+      return digits;
+    }
+    *value = (*value)*base + d;
+    pt++; digits++;
+  }
+}
+
+//------------HTTP_Init------------
+// Initialize a client, call once before any other function.
+// No connection is opened yet.
+// Input: c    client
+// Output: none
+void HTTP_Init(HTTP_Client_t *c){
+  memset(c, 0, sizeof(HTTP_Client_t));
+  c->Sd = -1;
+  c->Port = 80;
+}
+
+//------------HTTP_Server------------
+// Set the server of a client. Changing the server of an
+// open client closes the connection.
+// Input: c    client
+//        IP   server address, host byte order
+//        Port server port, usually 80
+// Output: none
+void HTTP_Server(HTTP_Client_t *c, unsigned long IP, uint16_t Port){
+  if((c->IP != IP)||(c->Port != Port)){
+    Disconnect(c);
+  }
+  c->IP = IP;
+  c->Port = Port;
+}
+
+//------------HTTP_Request------------
+// Send one complete request, for example
+// "GET /path HTTP/1.1\r\nHost: server\r\n\r\n"
+// Opens the connection if needed. More requests may be
+// sent before reading the responses, up to HTTP_MAXPIPE.
+// Input: c       client
+//        request request text, null terminated
+//        flags   0, or SL_MSG_MORE to hold a short request in the
+//                driver and send it with the next one
+// Output: 0 on success, negative HTTP_ERR_ code on error
+int32_t HTTP_Request(HTTP_Client_t *c, const char *request, int32_t flags){
+  uint32_t length = strlen(request);
+  uint32_t sent = 0;
+  int n;
+
+  if(c->Outstanding >= HTTP_MAXPIPE){
+    return HTTP_ERR_PIPE;
+  }
+  if(c->Sd < 0){
+    if(Connect(c) < 0) return HTTP_ERR_CONNECT;
+  }
+  while(sent < length){
+    n = sl_Send(c->Sd, &request[sent], length-sent, flags);
+    if(n <= 0){
+      Disconnect(c);
+      return HTTP_ERR_SEND;
+    }
+    sent += n;
+  }
+  c->Outstanding++;
+  c->Requests++;
+  return 0;
+}
+
+//------------HTTP_Response------------
+// Read the response to the oldest outstanding request.
+// The body is copied into buf and null terminated, a body
+// longer than size-1 is truncated but still read from the
+// connection, so the next response stays in step.
+// Input: c      client
+//        buf    buffer for the body
+//        size   size of buf in bytes
+//        status filled in with the HTTP status code, e.g. 200
+// Output: body length copied (not counting the null), or
+//         negative HTTP_ERR_ code on error (connection closed)
+int32_t HTTP_Response(HTTP_Client_t *c, char *buf, uint32_t size, int32_t *status){
+  char *line, *value;
+  int32_t err;
+  uint32_t length, code, chunk;
+  uint32_t copied = 0;
+  int chunked, keep;
+
+  if(c->Outstanding == 0){
+    return HTTP_ERR_NONE;
+  }
+  do{   // skip 1xx interim responses
+    err = ReadLine(c, &line);
+    if(err < 0) goto fail;
+    // "HTTP/1.1 200 OK"
+    if((err < 12)||strncmp(line, "HTTP/1.", 7)||(line[8] != ' ')||(Number(&line[9], 10, &code) != 3)){
+      err = HTTP_ERR_FORMAT;
+      goto fail;
+    }
+    keep = (line[7] != '0');  // HTTP/1.0 closes unless asked to keep alive
+    length = NOLENGTH;
+    chunked = 0;
+    while(1){   // headers, up to the empty line
+      err = ReadLine(c, &line);
+      if(err < 0) goto fail;
+      if(err == 0) break;
+      if((value = HeaderValue(line, "content-length")) != 0){
+        Number(value, 10, &length);
+      }else if((value = HeaderValue(line, "transfer-encoding")) != 0){
+        chunked = Contains(value, "chunked");
+      }else if((value = HeaderValue(line, "connection")) != 0){
+        if(Contains(value, "close")) keep = 0;
+        if(Contains(value, "keep-alive")) keep = 1;
+      }
+    }
+  }while((code >= 100)&&(code < 200));
+  *status = code;
+
+  if((code == 204)||(code == 304)){
+    err = 0;  // no body
+  }else if(chunked){
+    while(1){ // size line, data, CR LF
+      err = ReadLine(c, &line);
+      if(err < 0) goto fail;
+      if(Number(line, 16, &chunk) == 0){
+        err = HTTP_ERR_FORMAT;
+        goto fail;
+      }
+      if(chunk == 0) break;
+      err = ReadBody(c, chunk, buf, size, &copied);
+      if(err < 0) goto fail;
+      err = ReadLine(c, &line);
+      if(err != 0){
+        if(err > 0) err = HTTP_ERR_FORMAT;
+        goto fail;
+      }
+    }
+    do{       // trailer headers, up to the empty line
+      err = ReadLine(c, &line);
+      if(err < 0) goto fail;
+    }while(err);
+  }else{
+    if(length == NOLENGTH) keep = 0;  // the body ends when the server closes
+    err = ReadBody(c, length, buf, size, &copied);
+    if(err < 0) goto fail;
+  }
+  if(size) buf[copied] = 0;
+  c->Outstanding--;
+  if(!keep){
+    Disconnect(c);  // requests pipelined after this one are lost
+  }
+  return copied;
+
+fail:
+  if(size) buf[copied] = 0;
+  Disconnect(c);
+  return err;
+}
+
+//------------HTTP_Get------------
+// Send one request and read its response. If a reused
+// connection turns out to be closed by the server before
+// any response byte arrives, the request is sent once more
+// on a new connection.
+// Input: same as HTTP_Request and HTTP_Response
+// Output: same as HTTP_Response
+int32_t HTTP_Get(HTTP_Client_t *c, const char *request, char *buf, uint32_t size, int32_t *status){
+  int32_t result;
+  uint32_t rxBytes = c->RxBytes;
+  int reused = (c->Sd >= 0)&&(c->Outstanding == 0);
+
+  result = HTTP_Request(c, request, 0);
+  if(result == 0){
+    result = HTTP_Response(c, buf, size, status);
+  }
+  if(reused && (rxBytes == c->RxBytes) &&
+     ((result == HTTP_ERR_SEND)||(result == HTTP_ERR_CLOSED))){
+    // the server timed out the idle connection
+    result = HTTP_Request(c, request, 0);
+    if(result == 0){
+      result = HTTP_Response(c, buf, size, status);
+    }
+  }
+  return result;
+}
+
+//------------HTTP_Close------------
+// Close the connection, outstanding responses are dropped.
+// Input: c client
+// Output: none
+void HTTP_Close(HTTP_Client_t *c){
+  Disconnect(c);
+}
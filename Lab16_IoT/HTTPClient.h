@@ -0,0 +1,113 @@
+// HTTPClient.h
+// Runs on TM4C123 with the CC3100 booster pack
+// Minimal HTTP/1.1 client over the SimpleLink socket API.
+// The TCP connection is kept open between requests, several
+// requests may be sent before their responses are read
+// (pipelining), and responses framed by Content-Length,
+// chunked transfer coding or connection close are read
+// so the next response starts in the right place.
+
+/* This example accompanies the book
+   "Embedded Systems: Real Time Interfacing to ARM Cortex M Microcontrollers",
+   ISBN: 978-1463590154, Jonathan Valvano, copyright (c) 2014
+
+ Copyright 2015 by Jonathan W. Valvano, valvano@mail.utexas.edu
+    You may use, edit, run or distribute this file
+    as long as the above copyright notice remains
+ THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+ OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+ VALVANO SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL,
+ OR CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+ For more information about my classes, my research, and my books, see
+ http://users.ece.utexas.edu/~valvano/
+ */
+
+#ifndef __HTTPCLIENT_H__
+#define __HTTPCLIENT_H__
+#include <stdint.h>
+
+#define HTTP_RX_SIZE   512   // receive buffer, must hold the longest header line
+#define HTTP_MAXPIPE   4     // requests sent and not yet read
+
+// error codes, all negative
+#define HTTP_ERR_CONNECT  -1  // could not open the TCP connection
+#define HTTP_ERR_SEND     -2  // sl_Send failed, connection closed
+#define HTTP_ERR_CLOSED   -3  // server closed the connection early
+#define HTTP_ERR_FORMAT   -4  // malformed status line, header or chunk
+#define HTTP_ERR_PIPE     -5  // HTTP_MAXPIPE requests already outstanding
+#define HTTP_ERR_NONE     -6  // HTTP_Response with no request outstanding
+
+typedef struct{
+  int16_t Sd;               // socket descriptor, negative when closed
+  uint16_t Port;            // server port
+  unsigned long IP;         // server address, host byte order
+  uint8_t Outstanding;      // requests sent and not yet read
+  uint16_t Start;           // first unread byte in Rx
+  uint16_t End;             // one past the last unread byte in Rx
+  char Rx[HTTP_RX_SIZE];    // bytes received and not yet parsed
+  uint32_t Requests;        // requests sent
+  uint32_t Connects;        // TCP connections opened
+  uint32_t RxBytes;         // bytes received
+}HTTP_Client_t;
+
+// true if the connection to the server is open
+#define HTTP_IsOpen(c)  ((c)->Sd >= 0)
+
+//------------HTTP_Init------------
+// Initialize a client, call once before any other function.
+// No connection is opened yet.
+// Input: c    client
+// Output: none
+void HTTP_Init(HTTP_Client_t *c);
+
+//------------HTTP_Server------------
+// Set the server of a client. Changing the server of an
+// open client closes the connection.
+// Input: c    client
+//        IP   server address, host byte order
+//        Port server port, usually 80
+// Output: none
+void HTTP_Server(HTTP_Client_t *c, unsigned long IP, uint16_t Port);
+
+//------------HTTP_Request------------
+// Send one complete request, for example
+// "GET /path HTTP/1.1\r\nHost: server\r\n\r\n"
+// Opens the connection if needed. More requests may be
+// sent before reading the responses, up to HTTP_MAXPIPE.
+// Input: c       client
+//        request request text, null terminated
+//        flags   0, or SL_MSG_MORE to hold a short request in the
+//                driver and send it with the next one
+// Output: 0 on success, negative HTTP_ERR_ code on error
+int32_t HTTP_Request(HTTP_Client_t *c, const char *request, int32_t flags);
+
+//------------HTTP_Response------------
+// Read the response to the oldest outstanding request.
+// The body is copied into buf and null terminated, a body
+// longer than size-1 is truncated but still read from the
+// connection, so the next response stays in step.
+// Input: c      client
+//        buf    buffer for the body
+//        size   size of buf in bytes
+//        status filled in with the HTTP status code, e.g. 200
+// Output: body length copied (not counting the null), or
+//         negative HTTP_ERR_ code on error (connection closed)
+int32_t HTTP_Response(HTTP_Client_t *c, char *buf, uint32_t size, int32_t *status);
+
+//------------HTTP_Get------------
+// Send one request and read its response. If a reused
+// connection turns out to be closed by the server before
+// any response byte arrives, the request is sent once more
+// on a new connection.
+// Input: same as HTTP_Request and HTTP_Response
+// Output: same as HTTP_Response
+int32_t HTTP_Get(HTTP_Client_t *c, const char *request, char *buf, uint32_t size, int32_t *status);
+
+//------------HTTP_Close------------
+// Close the connection, outstanding responses are dropped.
+// Input: c client
+// Output: none
+void HTTP_Close(HTTP_Client_t *c);
+
+#endif
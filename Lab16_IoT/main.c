@@ -121,6 +121,7 @@ Port A, SSI0 (PA2, PA3, PA5, PA6, PA7) sends data to Nokia5110 LCD
 #include "application_commands.h"
 #include "LED.h"
 #include "Nokia5110.h"
+#include "HTTPClient.h"
 #include <string.h>
 #define SERVER "embsysmooc.appspot.com"
 #define REQUEST "GET /query?city=Atlanta%20Georgia&id=Timmy%20Duong&greet=Fascinating.&edxcode=9558 HTTP/1.1\r\nUser-Agent: Keil\r\nHost: embsysmooc.appspot.com\r\n\r\n"
@@ -235,7 +236,7 @@ struct{
   char SendBuff[MAX_SEND_BUFF_SIZE];
   char HostName[MAX_HOSTNAME_SIZE];
   unsigned long DestinationIP;
-  int SockID;
+  HTTP_Client_t Http;   // connection to SERVER, kept open between requests
 }appData;
 
 typedef enum{
@@ -257,7 +258,6 @@ UINT32  g_Status = 0;
 void WlanConnect(void);
 static int32_t configureSimpleLinkToDefaultState(char *);
 static uint32_t initializeAppVariables(void);
-static int CreateConnection(void);
 static int32_t getWeather(void);
 static int32_t GetHostIP(void);
 /*
@@ -623,50 +623,11 @@ static int32_t configureSimpleLinkToDefaultState(char *pConfig){
 static uint32_t initializeAppVariables(void){
   g_Status = 0;
   memset(&appData, 0, sizeof(appData));
+  HTTP_Init(&appData.Http);
   return SUCCESS;
 }
 
 
-/*!
-    \brief Create TCP connection with openweathermap.org
-
-    \param[in]      none
-
-    \return         Socket descriptor for success otherwise negative
-
-    \warning
-*/
-static int CreateConnection(void){
-  SlSockAddrIn_t  Addr;
-
-  INT32 sd = 0;
-  INT32 AddrSize = 0;
-  INT16 ret_val = 0;
-
-  Addr.sin_family = SL_AF_INET;
-  Addr.sin_port = sl_Htons(80);
-
-    /* Change the DestinationIP endianity, to big endian */
-  Addr.sin_addr.s_addr = sl_Htonl(appData.DestinationIP);
-
-  AddrSize = sizeof(SlSockAddrIn_t);
-
-  sd = sl_Socket(SL_AF_INET,SL_SOCK_STREAM, 0);
-  if( sd < 0 ){
-    LCD_OutString("Error creating socket\r\n");
-    return sd;
-  }
-
-  ret_val = sl_Connect(sd, ( SlSockAddr_t *)&Addr, AddrSize);
-  if( ret_val < 0 ){
-        /* error */
-    LCD_OutString("Error connecting to socket\r\n");
-    return ret_val;
-  }
-
-  return sd;
-}
-
 /*!
     \brief This function obtains the server IP address
 
@@ -729,21 +690,22 @@ void WlanConnect(void){
 */
 static int32_t getWeather(void){uint32_t i;
   char *pt = NULL;
+  int32_t status;
 
   memcpy(appData.HostName,SERVER,strlen(SERVER));
-  if(GetHostIP() == 0){
-    if( (appData.SockID = CreateConnection()) < 0 ) return -1;
+  // the server is looked up again only when the connection has to be reopened
+  if(HTTP_IsOpen(&appData.Http) || (GetHostIP() == 0)){
+    HTTP_Server(&appData.Http, appData.DestinationIP, 80);
 
 /* HTTP GET string. */
     strcpy(appData.SendBuff,REQUEST); 
 // 1) change Austin Texas to your city
 // 2) you can change metric to imperial if you want temperature in F
-    /* Send the HTTP GET string to the open TCP/IP socket. */
-    sl_Send(appData.SockID, appData.SendBuff, strlen(appData.SendBuff), 0);
-
-/* Receive response */
-    sl_Recv(appData.SockID, &appData.Recvbuff[0], MAX_RECV_BUFF_SIZE, 0);
-    appData.Recvbuff[strlen(appData.Recvbuff)] = '\0';
+    /* Send the HTTP GET string and receive the response body, the TCP/IP connection stays open */
+    if(HTTP_Get(&appData.Http, appData.SendBuff, appData.Recvbuff, MAX_RECV_BUFF_SIZE, &status) < 0){
+      LCD_OutString("Error reading response\r\n");
+      return -1;
+    }
 
 /* find ticker name in response*/
     pt = strstr(appData.Recvbuff, "\"name\"");
@@ -780,7 +742,6 @@ static int32_t getWeather(void){uint32_t i;
       }
     }
     Weather[i] = 0;   
-    sl_Close(appData.SockID);
   }
 
   return 0;
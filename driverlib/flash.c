@@ -255,6 +255,171 @@ FlashProgram(uint32_t *pui32Data, uint32_t ui32Address, uint32_t ui32Count)
     return(0);
 }
 
+//*****************************************************************************
+//
+//! Starts erasing a block of flash without waiting for it to complete.
+//!
+//! \param ui32Address is the start address of the flash block to be erased.
+//!
+//! This function starts an erase of a block of the on-chip flash in the same
+//! way as FlashErase() but returns as soon as the operation has been started.
+//! The caller must use FlashBusy() to determine when the erase has completed
+//! and FlashOperationStatus() to determine whether it succeeded.  No other
+//! flash erase or program operation may be started until FlashBusy() returns
+//! \b false.
+//!
+//! Note that the processor stalls on any instruction fetch or data read from
+//! flash while the erase is in progress.  Overlapping an erase with other work
+//! is therefore only useful for work that runs from SRAM or for peripheral
+//! activity, such as DMA-driven Ethernet reception, that does not involve the
+//! processor.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+FlashEraseNonBlocking(uint32_t ui32Address)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(!(ui32Address & (FLASH_ERASE_SIZE - 1)));
+
+    //
+    // Clear the flash access and error interrupts.
+    //
+    HWREG(FLASH_FCMISC) = (FLASH_FCMISC_AMISC | FLASH_FCMISC_VOLTMISC |
+                           FLASH_FCMISC_ERMISC);
+
+    //
+    // Start erasing the block.
+    //
+    HWREG(FLASH_FMA) = ui32Address;
+    HWREG(FLASH_FMC) = FLASH_FMC_WRKEY | FLASH_FMC_ERASE;
+}
+
+//*****************************************************************************
+//
+//! Starts programming flash from the write buffer without waiting for it to
+//! complete.
+//!
+//! \param pui32Data is a pointer to the data to be programmed.
+//! \param ui32Address is the starting address in flash to be programmed.  Must
+//! be a multiple of four.
+//! \param ui32Count is the number of bytes to be programmed.  Must be a
+//! multiple of four.
+//!
+//! This function loads as many words as fit in the flash write buffer, up to
+//! the next 32-word boundary, and starts programming them.  It returns as soon
+//! as programming has started.  The caller must wait for FlashBusy() to
+//! return \b false before calling this function again with the remaining
+//! data, and may use FlashOperationStatus() to check for errors once all data
+//! has been programmed.
+//!
+//! \return Returns the number of bytes from \e pui32Data that were loaded into
+//! the write buffer.
+//
+//*****************************************************************************
+uint32_t
+FlashProgramNonBlocking(uint32_t *pui32Data, uint32_t ui32Address,
+                        uint32_t ui32Count)
+{
+    uint32_t ui32Loaded;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(!(ui32Address & 3));
+    ASSERT(!(ui32Count & 3));
+
+    //
+    // Clear the flash access and error interrupts.
+    //
+    HWREG(FLASH_FCMISC) = (FLASH_FCMISC_AMISC | FLASH_FCMISC_VOLTMISC |
+                           FLASH_FCMISC_INVDMISC | FLASH_FCMISC_PROGMISC);
+
+    //
+    // Set the address of this block of words.
+    //
+    HWREG(FLASH_FMA) = ui32Address & ~(0x7f);
+
+    //
+    // Loop over the words in this 32-word block.
+    //
+    ui32Loaded = 0;
+    while(((ui32Address & 0x7c) || (HWREG(FLASH_FWBVAL) == 0)) &&
+          (ui32Count != 0))
+    {
+        //
+        // Write this word into the write buffer.
+        //
+        HWREG(FLASH_FWBN + (ui32Address & 0x7c)) = *pui32Data++;
+        ui32Address += 4;
+        ui32Count -= 4;
+        ui32Loaded += 4;
+    }
+
+    //
+    // Start programming the contents of the write buffer into flash.
+    //
+    HWREG(FLASH_FMC2) = FLASH_FMC2_WRKEY | FLASH_FMC2_WRBUF;
+
+    return(ui32Loaded);
+}
+
+//*****************************************************************************
+//
+//! Determines whether a flash erase or program operation is in progress.
+//!
+//! This function is used along with FlashEraseNonBlocking() and
+//! FlashProgramNonBlocking() to determine when a previously started operation
+//! has completed.
+//!
+//! \return Returns \b true if an erase or program operation is in progress
+//! and \b false otherwise.
+//
+//*****************************************************************************
+bool
+FlashBusy(void)
+{
+    return(((HWREG(FLASH_FMC) & FLASH_FMC_ERASE) ||
+            (HWREG(FLASH_FMC2) & FLASH_FMC2_WRBUF)) ? true : false);
+}
+
+//*****************************************************************************
+//
+//! Returns the result of the erase and program operations since the status
+//! was last cleared.
+//!
+//! This function checks the flash controller error flags which are cleared
+//! each time FlashEraseNonBlocking() or FlashProgramNonBlocking() starts a
+//! new operation.  It should be called only once FlashBusy() returns
+//! \b false.
+//!
+//! \return Returns 0 on success, or -1 if an access violation, erase error or
+//! programming error was reported.
+//
+//*****************************************************************************
+int32_t
+FlashOperationStatus(void)
+{
+    //
+    // Return an error if an access violation, erase or programming error
+    // occurred.
+    //
+    if(HWREG(FLASH_FCRIS) & (FLASH_FCRIS_ARIS | FLASH_FCRIS_VOLTRIS |
+                             FLASH_FCRIS_ERRIS | FLASH_FCRIS_INVDRIS |
+                             FLASH_FCRIS_PROGRIS))
+    {
+        return(-1);
+    }
+
+    //
+    // Success.
+    //
+    return(0);
+}
+
 //*****************************************************************************
 //
 //! Gets the protection setting for a block of flash.
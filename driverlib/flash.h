@@ -87,6 +87,12 @@ tFlashProtection;
 extern int32_t FlashErase(uint32_t ui32Address);
 extern int32_t FlashProgram(uint32_t *pui32Data, uint32_t ui32Address,
                             uint32_t ui32Count);
+extern void FlashEraseNonBlocking(uint32_t ui32Address);
+extern uint32_t FlashProgramNonBlocking(uint32_t *pui32Data,
+                                        uint32_t ui32Address,
+                                        uint32_t ui32Count);
+extern bool FlashBusy(void);
+extern int32_t FlashOperationStatus(void);
 extern tFlashProtection FlashProtectGet(uint32_t ui32Address);
 extern int32_t FlashProtectSet(uint32_t ui32Address,
                                tFlashProtection eProtect);
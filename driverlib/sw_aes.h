@@ -0,0 +1,108 @@
+//*****************************************************************************
+//
+// sw_aes.h - Prototypes for the software AES functions.
+//
+// Copyright (c) 2010-2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+//   Redistribution and use in source and binary forms, with or without
+//   modification, are permitted provided that the following conditions
+//   are met:
+// 
+//   Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+// 
+//   Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the  
+//   distribution.
+// 
+//   Neither the name of Texas Instruments Incorporated nor the names of
+//   its contributors may be used to endorse or promote products derived
+//   from this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Peripheral Driver Library.
+//
+
+#ifndef __DRIVERLIB_SW_AES_H__
+#define __DRIVERLIB_SW_AES_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The size of an AES block in bytes.
+//
+//*****************************************************************************
+#define SW_AES_BLOCK_SIZE       16
+
+//*****************************************************************************
+//
+// The expanded key for the software AES implementation.  The encryption and
+// decryption key schedules are both kept so that a single key set can be
+// used in either direction.  The contents of this structure are private and
+// must only be set up by SWAESKeySet().
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The encryption round keys, four words per round plus the initial key.
+    //
+    uint32_t pui32EncKey[60];
+
+    //
+    // The decryption round keys for the equivalent inverse cipher.
+    //
+    uint32_t pui32DecKey[60];
+
+    //
+    // The number of rounds; 10, 12 or 14 for 128, 192 or 256-bit keys.
+    //
+    uint32_t ui32Rounds;
+}
+tSWAESContext;
+
+//*****************************************************************************
+//
+// Prototypes for the functions.
+//
+//*****************************************************************************
+extern bool SWAESKeySet(tSWAESContext *psContext, const uint8_t *pui8Key,
+                        uint32_t ui32KeyBits);
+extern void SWAESEncryptBlock(const tSWAESContext *psContext,
+                              const uint8_t *pui8Src, uint8_t *pui8Dest);
+extern void SWAESDecryptBlock(const tSWAESContext *psContext,
+                              const uint8_t *pui8Src, uint8_t *pui8Dest);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __DRIVERLIB_SW_AES_H__
@@ -0,0 +1,852 @@
+//*****************************************************************************
+//
+// sw_shamd5.c - Software SHA-1, SHA-224, SHA-256 and MD5 hash functions.
+//
+// Copyright (c) 2010-2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+//   Redistribution and use in source and binary forms, with or without
+//   modification, are permitted provided that the following conditions
+//   are met:
+// 
+//   Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+// 
+//   Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the  
+//   distribution.
+// 
+//   Neither the name of Texas Instruments Incorporated nor the names of
+//   its contributors may be used to endorse or promote products derived
+//   from this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Peripheral Driver Library.
+//
+
+//*****************************************************************************
+//
+//! \addtogroup sw_shamd5_api
+//! @{
+//
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/shamd5.h"
+#include "driverlib/sw_shamd5.h"
+
+//*****************************************************************************
+//
+// Rotates a 32-bit value.
+//
+//*****************************************************************************
+#define ROTL(ui32Val, ui32Bits)                                               \
+        (((ui32Val) << (ui32Bits)) | ((ui32Val) >> (32 - (ui32Bits))))
+#define ROTR(ui32Val, ui32Bits)                                               \
+        (((ui32Val) >> (ui32Bits)) | ((ui32Val) << (32 - (ui32Bits))))
+
+//*****************************************************************************
+//
+// Loads and stores 32-bit words from byte arrays that need not be word
+// aligned.  SHA uses big-endian words and MD5 uses little-endian words.
+//
+//*****************************************************************************
+#define LOAD32_BE(pui8Data)                                                   \
+        (((uint32_t)(pui8Data)[0] << 24) | ((uint32_t)(pui8Data)[1] << 16) |  \
+         ((uint32_t)(pui8Data)[2] << 8) | (uint32_t)(pui8Data)[3])
+#define LOAD32_LE(pui8Data)                                                   \
+        ((uint32_t)(pui8Data)[0] | ((uint32_t)(pui8Data)[1] << 8) |           \
+         ((uint32_t)(pui8Data)[2] << 16) | ((uint32_t)(pui8Data)[3] << 24))
+
+//*****************************************************************************
+//
+// The initial hash values for each of the supported algorithms.
+//
+//*****************************************************************************
+static const uint32_t g_pui32SHA256Init[8] =
+{
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+    0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+static const uint32_t g_pui32SHA224Init[8] =
+{
+    0xC1059ED8, 0x367CD507, 0x3070DD17, 0xF70E5939,
+    0xFFC00B31, 0x68581511, 0x64F98FA7, 0xBEFA4FA4
+};
+static const uint32_t g_pui32SHA1Init[5] =
+{
+    0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0
+};
+static const uint32_t g_pui32MD5Init[4] =
+{
+    0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476
+};
+
+//*****************************************************************************
+//
+// The SHA-256 round constants.
+//
+//*****************************************************************************
+static const uint32_t g_pui32SHA256K[64] =
+{
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5,
+    0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3,
+    0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC,
+    0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7,
+    0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13,
+    0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3,
+    0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5,
+    0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208,
+    0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
+//*****************************************************************************
+//
+// The SHA-256 round and message schedule functions.
+//
+//*****************************************************************************
+#define SHA_CH(x, y, z)         ((z) ^ ((x) & ((y) ^ (z))))
+#define SHA_MAJ(x, y, z)        (((x) & (y)) | ((z) & ((x) | (y))))
+#define SHA256_S0(x)            (ROTR(x, 2) ^ ROTR(x, 13) ^ ROTR(x, 22))
+#define SHA256_S1(x)            (ROTR(x, 6) ^ ROTR(x, 11) ^ ROTR(x, 25))
+#define SHA256_G0(x)            (ROTR(x, 7) ^ ROTR(x, 18) ^ ((x) >> 3))
+#define SHA256_G1(x)            (ROTR(x, 17) ^ ROTR(x, 19) ^ ((x) >> 10))
+
+//*****************************************************************************
+//
+// Computes message schedule word i in place in the 16-word circular buffer.
+//
+//*****************************************************************************
+#define SHA256_W(i)                                                           \
+        (pui32W[(i) & 15] += (SHA256_G1(pui32W[((i) - 2) & 15]) +            \
+                              pui32W[((i) - 7) & 15] +                        \
+                              SHA256_G0(pui32W[((i) - 15) & 15])))
+
+//*****************************************************************************
+//
+// One SHA-256 round.  Rather than shifting the eight working variables after
+// every round, the callers rotate the argument order, so only d and h are
+// written.
+//
+//*****************************************************************************
+#define SHA256_ROUND(a, b, c, d, e, f, g, h, ui32K, ui32W)                    \
+        do                                                                    \
+        {                                                                     \
+            uint32_t ui32T;                                                   \
+                                                                              \
+            ui32T = (h) + SHA256_S1(e) + SHA_CH(e, f, g) + (ui32K) + (ui32W); \
+            (d) += ui32T;                                                     \
+            (h) = ui32T + SHA256_S0(a) + SHA_MAJ(a, b, c);                    \
+        }                                                                     \
+        while(0)
+
+//*****************************************************************************
+//
+// Eight SHA-256 rounds, after which the working variables are back in their
+// original positions.
+//
+//*****************************************************************************
+#define SHA256_ROUND8(i, W)                                                   \
+        do                                                                    \
+        {                                                                     \
+            SHA256_ROUND(ui32A, ui32B, ui32C, ui32D, ui32E, ui32F, ui32G,     \
+                         ui32H, pui32K[(i) + 0], W((i) + 0));                 \
+            SHA256_ROUND(ui32H, ui32A, ui32B, ui32C, ui32D, ui32E, ui32F,     \
+                         ui32G, pui32K[(i) + 1], W((i) + 1));                 \
+            SHA256_ROUND(ui32G, ui32H, ui32A, ui32B, ui32C, ui32D, ui32E,     \
+                         ui32F, pui32K[(i) + 2], W((i) + 2));                 \
+            SHA256_ROUND(ui32F, ui32G, ui32H, ui32A, ui32B, ui32C, ui32D,     \
+                         ui32E, pui32K[(i) + 3], W((i) + 3));                 \
+            SHA256_ROUND(ui32E, ui32F, ui32G, ui32H, ui32A, ui32B, ui32C,     \
+                         ui32D, pui32K[(i) + 4], W((i) + 4));                 \
+            SHA256_ROUND(ui32D, ui32E, ui32F, ui32G, ui32H, ui32A, ui32B,     \
+                         ui32C, pui32K[(i) + 5], W((i) + 5));                 \
+            SHA256_ROUND(ui32C, ui32D, ui32E, ui32F, ui32G, ui32H, ui32A,     \
+                         ui32B, pui32K[(i) + 6], W((i) + 6));                 \
+            SHA256_ROUND(ui32B, ui32C, ui32D, ui32E, ui32F, ui32G, ui32H,     \
+                         ui32A, pui32K[(i) + 7], W((i) + 7));                 \
+        }                                                                     \
+        while(0)
+
+//*****************************************************************************
+//
+// The first sixteen rounds read the message words directly.
+//
+//*****************************************************************************
+#define SHA256_LOAD(i)                                                        \
+        (pui32W[(i) & 15] = LOAD32_BE(pui8Data + (((i) & 15) * 4)))
+
+//*****************************************************************************
+//
+// The SHA-1 message schedule, computed in place in the 16-word circular
+// buffer.
+//
+//*****************************************************************************
+#define SHA1_W(i)                                                             \
+        (pui32W[(i) & 15] = ROTL(pui32W[((i) - 3) & 15] ^                     \
+                                 pui32W[((i) - 8) & 15] ^                     \
+                                 pui32W[((i) - 14) & 15] ^                    \
+                                 pui32W[(i) & 15], 1))
+
+//*****************************************************************************
+//
+// The SHA-1 rounds for each group of twenty.  As with SHA-256, the callers
+// rotate the argument order instead of moving the working variables.
+//
+//*****************************************************************************
+#define SHA1_STEP(a, b, c, d, e, ui32F, ui32K, ui32W)                         \
+        do                                                                    \
+        {                                                                     \
+            (e) += ROTL(a, 5) + (ui32F) + (ui32K) + (ui32W);                  \
+            (b) = ROTL(b, 30);                                                \
+        }                                                                     \
+        while(0)
+#define SHA1_R1(a, b, c, d, e, ui32W)                                         \
+        SHA1_STEP(a, b, c, d, e, SHA_CH(b, c, d), 0x5A827999, ui32W)
+#define SHA1_R2(a, b, c, d, e, ui32W)                                         \
+        SHA1_STEP(a, b, c, d, e, (b) ^ (c) ^ (d), 0x6ED9EBA1, ui32W)
+#define SHA1_R3(a, b, c, d, e, ui32W)                                         \
+        SHA1_STEP(a, b, c, d, e, SHA_MAJ(b, c, d), 0x8F1BBCDC, ui32W)
+#define SHA1_R4(a, b, c, d, e, ui32W)                                         \
+        SHA1_STEP(a, b, c, d, e, (b) ^ (c) ^ (d), 0xCA62C1D6, ui32W)
+
+//*****************************************************************************
+//
+// The MD5 round functions.
+//
+//*****************************************************************************
+#define MD5_F(x, y, z)          ((z) ^ ((x) & ((y) ^ (z))))
+#define MD5_G(x, y, z)          ((y) ^ ((z) & ((x) ^ (y))))
+#define MD5_H(x, y, z)          ((x) ^ (y) ^ (z))
+#define MD5_I(x, y, z)          ((y) ^ ((x) | ~(z)))
+
+//*****************************************************************************
+//
+// One MD5 step.
+//
+//*****************************************************************************
+#define MD5_STEP(f, a, b, c, d, ui32W, ui32T, ui32S)                          \
+        do                                                                    \
+        {                                                                     \
+            (a) += MD5_##f(b, c, d) + (ui32W) + (ui32T);                      \
+            (a) = ROTL(a, ui32S) + (b);                                       \
+        }                                                                     \
+        while(0)
+
+//*****************************************************************************
+//
+// Hashes one or more complete 64-byte blocks with SHA-1.
+//
+//*****************************************************************************
+static void
+SHA1Blocks(uint32_t *pui32State, const uint8_t *pui8Data, uint32_t ui32Blocks)
+{
+    uint32_t ui32A, ui32B, ui32C, ui32D, ui32E, pui32W[16], ui32Idx;
+
+    while(ui32Blocks--)
+    {
+        //
+        // Load the message words and the working variables.
+        //
+        for(ui32Idx = 0; ui32Idx < 16; ui32Idx++)
+        {
+            pui32W[ui32Idx] = LOAD32_BE(pui8Data + (ui32Idx * 4));
+        }
+        ui32A = pui32State[0];
+        ui32B = pui32State[1];
+        ui32C = pui32State[2];
+        ui32D = pui32State[3];
+        ui32E = pui32State[4];
+
+        //
+        // Perform the four fully unrolled groups of twenty rounds.
+        //
+        SHA1_R1(ui32A, ui32B, ui32C, ui32D, ui32E, pui32W[0]);
+        SHA1_R1(ui32E, ui32A, ui32B, ui32C, ui32D, pui32W[1]);
+        SHA1_R1(ui32D, ui32E, ui32A, ui32B, ui32C, pui32W[2]);
+        SHA1_R1(ui32C, ui32D, ui32E, ui32A, ui32B, pui32W[3]);
+        SHA1_R1(ui32B, ui32C, ui32D, ui32E, ui32A, pui32W[4]);
+        SHA1_R1(ui32A, ui32B, ui32C, ui32D, ui32E, pui32W[5]);
+        SHA1_R1(ui32E, ui32A, ui32B, ui32C, ui32D, pui32W[6]);
+        SHA1_R1(ui32D, ui32E, ui32A, ui32B, ui32C, pui32W[7]);
+        SHA1_R1(ui32C, ui32D, ui32E, ui32A, ui32B, pui32W[8]);
+        SHA1_R1(ui32B, ui32C, ui32D, ui32E, ui32A, pui32W[9]);
+        SHA1_R1(ui32A, ui32B, ui32C, ui32D, ui32E, pui32W[10]);
+        SHA1_R1(ui32E, ui32A, ui32B, ui32C, ui32D, pui32W[11]);
+        SHA1_R1(ui32D, ui32E, ui32A, ui32B, ui32C, pui32W[12]);
+        SHA1_R1(ui32C, ui32D, ui32E, ui32A, ui32B, pui32W[13]);
+        SHA1_R1(ui32B, ui32C, ui32D, ui32E, ui32A, pui32W[14]);
+        SHA1_R1(ui32A, ui32B, ui32C, ui32D, ui32E, pui32W[15]);
+        SHA1_R1(ui32E, ui32A, ui32B, ui32C, ui32D, SHA1_W(16));
+        SHA1_R1(ui32D, ui32E, ui32A, ui32B, ui32C, SHA1_W(17));
+        SHA1_R1(ui32C, ui32D, ui32E, ui32A, ui32B, SHA1_W(18));
+        SHA1_R1(ui32B, ui32C, ui32D, ui32E, ui32A, SHA1_W(19));
+
+        SHA1_R2(ui32A, ui32B, ui32C, ui32D, ui32E, SHA1_W(20));
+        SHA1_R2(ui32E, ui32A, ui32B, ui32C, ui32D, SHA1_W(21));
+        SHA1_R2(ui32D, ui32E, ui32A, ui32B, ui32C, SHA1_W(22));
+        SHA1_R2(ui32C, ui32D, ui32E, ui32A, ui32B, SHA1_W(23));
+        SHA1_R2(ui32B, ui32C, ui32D, ui32E, ui32A, SHA1_W(24));
+        SHA1_R2(ui32A, ui32B, ui32C, ui32D, ui32E, SHA1_W(25));
+        SHA1_R2(ui32E, ui32A, ui32B, ui32C, ui32D, SHA1_W(26));
+        SHA1_R2(ui32D, ui32E, ui32A, ui32B, ui32C, SHA1_W(27));
+        SHA1_R2(ui32C, ui32D, ui32E, ui32A, ui32B, SHA1_W(28));
+        SHA1_R2(ui32B, ui32C, ui32D, ui32E, ui32A, SHA1_W(29));
+        SHA1_R2(ui32A, ui32B, ui32C, ui32D, ui32E, SHA1_W(30));
+        SHA1_R2(ui32E, ui32A, ui32B, ui32C, ui32D, SHA1_W(31));
+        SHA1_R2(ui32D, ui32E, ui32A, ui32B, ui32C, SHA1_W(32));
+        SHA1_R2(ui32C, ui32D, ui32E, ui32A, ui32B, SHA1_W(33));
+        SHA1_R2(ui32B, ui32C, ui32D, ui32E, ui32A, SHA1_W(34));
+        SHA1_R2(ui32A, ui32B, ui32C, ui32D, ui32E, SHA1_W(35));
+        SHA1_R2(ui32E, ui32A, ui32B, ui32C, ui32D, SHA1_W(36));
+        SHA1_R2(ui32D, ui32E, ui32A, ui32B, ui32C, SHA1_W(37));
+        SHA1_R2(ui32C, ui32D, ui32E, ui32A, ui32B, SHA1_W(38));
+        SHA1_R2(ui32B, ui32C, ui32D, ui32E, ui32A, SHA1_W(39));
+
+        SHA1_R3(ui32A, ui32B, ui32C, ui32D, ui32E, SHA1_W(40));
+        SHA1_R3(ui32E, ui32A, ui32B, ui32C, ui32D, SHA1_W(41));
+        SHA1_R3(ui32D, ui32E, ui32A, ui32B, ui32C, SHA1_W(42));
+        SHA1_R3(ui32C, ui32D, ui32E, ui32A, ui32B, SHA1_W(43));
+        SHA1_R3(ui32B, ui32C, ui32D, ui32E, ui32A, SHA1_W(44));
+        SHA1_R3(ui32A, ui32B, ui32C, ui32D, ui32E, SHA1_W(45));
+        SHA1_R3(ui32E, ui32A, ui32B, ui32C, ui32D, SHA1_W(46));
+        SHA1_R3(ui32D, ui32E, ui32A, ui32B, ui32C, SHA1_W(47));
+        SHA1_R3(ui32C, ui32D, ui32E, ui32A, ui32B, SHA1_W(48));
+        SHA1_R3(ui32B, ui32C, ui32D, ui32E, ui32A, SHA1_W(49));
+        SHA1_R3(ui32A, ui32B, ui32C, ui32D, ui32E, SHA1_W(50));
+        SHA1_R3(ui32E, ui32A, ui32B, ui32C, ui32D, SHA1_W(51));
+        SHA1_R3(ui32D, ui32E, ui32A, ui32B, ui32C, SHA1_W(52));
+        SHA1_R3(ui32C, ui32D, ui32E, ui32A, ui32B, SHA1_W(53));
+        SHA1_R3(ui32B, ui32C, ui32D, ui32E, ui32A, SHA1_W(54));
+        SHA1_R3(ui32A, ui32B, ui32C, ui32D, ui32E, SHA1_W(55));
+        SHA1_R3(ui32E, ui32A, ui32B, ui32C, ui32D, SHA1_W(56));
+        SHA1_R3(ui32D, ui32E, ui32A, ui32B, ui32C, SHA1_W(57));
+        SHA1_R3(ui32C, ui32D, ui32E, ui32A, ui32B, SHA1_W(58));
+        SHA1_R3(ui32B, ui32C, ui32D, ui32E, ui32A, SHA1_W(59));
+
+        SHA1_R4(ui32A, ui32B, ui32C, ui32D, ui32E, SHA1_W(60));
+        SHA1_R4(ui32E, ui32A, ui32B, ui32C, ui32D, SHA1_W(61));
+        SHA1_R4(ui32D, ui32E, ui32A, ui32B, ui32C, SHA1_W(62));
+        SHA1_R4(ui32C, ui32D, ui32E, ui32A, ui32B, SHA1_W(63));
+        SHA1_R4(ui32B, ui32C, ui32D, ui32E, ui32A, SHA1_W(64));
+        SHA1_R4(ui32A, ui32B, ui32C, ui32D, ui32E, SHA1_W(65));
+        SHA1_R4(ui32E, ui32A, ui32B, ui32C, ui32D, SHA1_W(66));
+        SHA1_R4(ui32D, ui32E, ui32A, ui32B, ui32C, SHA1_W(67));
+        SHA1_R4(ui32C, ui32D, ui32E, ui32A, ui32B, SHA1_W(68));
+        SHA1_R4(ui32B, ui32C, ui32D, ui32E, ui32A, SHA1_W(69));
+        SHA1_R4(ui32A, ui32B, ui32C, ui32D, ui32E, SHA1_W(70));
+        SHA1_R4(ui32E, ui32A, ui32B, ui32C, ui32D, SHA1_W(71));
+        SHA1_R4(ui32D, ui32E, ui32A, ui32B, ui32C, SHA1_W(72));
+        SHA1_R4(ui32C, ui32D, ui32E, ui32A, ui32B, SHA1_W(73));
+        SHA1_R4(ui32B, ui32C, ui32D, ui32E, ui32A, SHA1_W(74));
+        SHA1_R4(ui32A, ui32B, ui32C, ui32D, ui32E, SHA1_W(75));
+        SHA1_R4(ui32E, ui32A, ui32B, ui32C, ui32D, SHA1_W(76));
+        SHA1_R4(ui32D, ui32E, ui32A, ui32B, ui32C, SHA1_W(77));
+        SHA1_R4(ui32C, ui32D, ui32E, ui32A, ui32B, SHA1_W(78));
+        SHA1_R4(ui32B, ui32C, ui32D, ui32E, ui32A, SHA1_W(79));
+
+        //
+        // Add the working variables back into the chaining state.
+        //
+        pui32State[0] += ui32A;
+        pui32State[1] += ui32B;
+        pui32State[2] += ui32C;
+        pui32State[3] += ui32D;
+        pui32State[4] += ui32E;
+
+        pui8Data += SW_SHAMD5_BLOCK_SIZE;
+    }
+}
+
+//*****************************************************************************
+//
+// Hashes one or more complete 64-byte blocks with SHA-224 or SHA-256.
+//
+//*****************************************************************************
+static void
+SHA256Blocks(uint32_t *pui32State, const uint8_t *pui8Data,
+             uint32_t ui32Blocks)
+{
+    const uint32_t *pui32K;
+    uint32_t ui32A, ui32B, ui32C, ui32D, ui32E, ui32F, ui32G, ui32H;
+    uint32_t pui32W[16], ui32Idx;
+
+    while(ui32Blocks--)
+    {
+        //
+        // Load the working variables from the chaining state.
+        //
+        ui32A = pui32State[0];
+        ui32B = pui32State[1];
+        ui32C = pui32State[2];
+        ui32D = pui32State[3];
+        ui32E = pui32State[4];
+        ui32F = pui32State[5];
+        ui32G = pui32State[6];
+        ui32H = pui32State[7];
+
+        //
+        // Perform the 64 rounds, eight at a time.  The message schedule is
+        // computed on the fly into a 16-word circular buffer.
+        //
+        pui32K = g_pui32SHA256K;
+        SHA256_ROUND8(0, SHA256_LOAD);
+        SHA256_ROUND8(8, SHA256_LOAD);
+        for(ui32Idx = 16; ui32Idx < 64; ui32Idx += 8)
+        {
+            SHA256_ROUND8(ui32Idx, SHA256_W);
+        }
+
+        //
+        // Add the working variables back into the chaining state.
+        //
+        pui32State[0] += ui32A;
+        pui32State[1] += ui32B;
+        pui32State[2] += ui32C;
+        pui32State[3] += ui32D;
+        pui32State[4] += ui32E;
+        pui32State[5] += ui32F;
+        pui32State[6] += ui32G;
+        pui32State[7] += ui32H;
+
+        pui8Data += SW_SHAMD5_BLOCK_SIZE;
+    }
+}
+
+//*****************************************************************************
+//
+// Hashes one or more complete 64-byte blocks with MD5.
+//
+//*****************************************************************************
+static void
+MD5Blocks(uint32_t *pui32State, const uint8_t *pui8Data, uint32_t ui32Blocks)
+{
+    uint32_t ui32A, ui32B, ui32C, ui32D, pui32W[16], ui32Idx;
+
+    while(ui32Blocks--)
+    {
+        //
+        // Load the message words and the working variables.
+        //
+        for(ui32Idx = 0; ui32Idx < 16; ui32Idx++)
+        {
+            pui32W[ui32Idx] = LOAD32_LE(pui8Data + (ui32Idx * 4));
+        }
+        ui32A = pui32State[0];
+        ui32B = pui32State[1];
+        ui32C = pui32State[2];
+        ui32D = pui32State[3];
+
+        //
+        // Perform the four fully unrolled rounds of sixteen steps.
+        //
+        MD5_STEP(F, ui32A, ui32B, ui32C, ui32D, pui32W[0], 0xD76AA478, 7);
+        MD5_STEP(F, ui32D, ui32A, ui32B, ui32C, pui32W[1], 0xE8C7B756, 12);
+        MD5_STEP(F, ui32C, ui32D, ui32A, ui32B, pui32W[2], 0x242070DB, 17);
+        MD5_STEP(F, ui32B, ui32C, ui32D, ui32A, pui32W[3], 0xC1BDCEEE, 22);
+        MD5_STEP(F, ui32A, ui32B, ui32C, ui32D, pui32W[4], 0xF57C0FAF, 7);
+        MD5_STEP(F, ui32D, ui32A, ui32B, ui32C, pui32W[5], 0x4787C62A, 12);
+        MD5_STEP(F, ui32C, ui32D, ui32A, ui32B, pui32W[6], 0xA8304613, 17);
+        MD5_STEP(F, ui32B, ui32C, ui32D, ui32A, pui32W[7], 0xFD469501, 22);
+        MD5_STEP(F, ui32A, ui32B, ui32C, ui32D, pui32W[8], 0x698098D8, 7);
+        MD5_STEP(F, ui32D, ui32A, ui32B, ui32C, pui32W[9], 0x8B44F7AF, 12);
+        MD5_STEP(F, ui32C, ui32D, ui32A, ui32B, pui32W[10], 0xFFFF5BB1, 17);
+        MD5_STEP(F, ui32B, ui32C, ui32D, ui32A, pui32W[11], 0x895CD7BE, 22);
+        MD5_STEP(F, ui32A, ui32B, ui32C, ui32D, pui32W[12], 0x6B901122, 7);
+        MD5_STEP(F, ui32D, ui32A, ui32B, ui32C, pui32W[13], 0xFD987193, 12);
+        MD5_STEP(F, ui32C, ui32D, ui32A, ui32B, pui32W[14], 0xA679438E, 17);
+        MD5_STEP(F, ui32B, ui32C, ui32D, ui32A, pui32W[15], 0x49B40821, 22);
+
+        MD5_STEP(G, ui32A, ui32B, ui32C, ui32D, pui32W[1], 0xF61E2562, 5);
+        MD5_STEP(G, ui32D, ui32A, ui32B, ui32C, pui32W[6], 0xC040B340, 9);
+        MD5_STEP(G, ui32C, ui32D, ui32A, ui32B, pui32W[11], 0x265E5A51, 14);
+        MD5_STEP(G, ui32B, ui32C, ui32D, ui32A, pui32W[0], 0xE9B6C7AA, 20);
+        MD5_STEP(G, ui32A, ui32B, ui32C, ui32D, pui32W[5], 0xD62F105D, 5);
+        MD5_STEP(G, ui32D, ui32A, ui32B, ui32C, pui32W[10], 0x02441453, 9);
+        MD5_STEP(G, ui32C, ui32D, ui32A, ui32B, pui32W[15], 0xD8A1E681, 14);
+        MD5_STEP(G, ui32B, ui32C, ui32D, ui32A, pui32W[4], 0xE7D3FBC8, 20);
+        MD5_STEP(G, ui32A, ui32B, ui32C, ui32D, pui32W[9], 0x21E1CDE6, 5);
+        MD5_STEP(G, ui32D, ui32A, ui32B, ui32C, pui32W[14], 0xC33707D6, 9);
+        MD5_STEP(G, ui32C, ui32D, ui32A, ui32B, pui32W[3], 0xF4D50D87, 14);
+        MD5_STEP(G, ui32B, ui32C, ui32D, ui32A, pui32W[8], 0x455A14ED, 20);
+        MD5_STEP(G, ui32A, ui32B, ui32C, ui32D, pui32W[13], 0xA9E3E905, 5);
+        MD5_STEP(G, ui32D, ui32A, ui32B, ui32C, pui32W[2], 0xFCEFA3F8, 9);
+        MD5_STEP(G, ui32C, ui32D, ui32A, ui32B, pui32W[7], 0x676F02D9, 14);
+        MD5_STEP(G, ui32B, ui32C, ui32D, ui32A, pui32W[12], 0x8D2A4C8A, 20);
+
+        MD5_STEP(H, ui32A, ui32B, ui32C, ui32D, pui32W[5], 0xFFFA3942, 4);
+        MD5_STEP(H, ui32D, ui32A, ui32B, ui32C, pui32W[8], 0x8771F681, 11);
+        MD5_STEP(H, ui32C, ui32D, ui32A, ui32B, pui32W[11], 0x6D9D6122, 16);
+        MD5_STEP(H, ui32B, ui32C, ui32D, ui32A, pui32W[14], 0xFDE5380C, 23);
+        MD5_STEP(H, ui32A, ui32B, ui32C, ui32D, pui32W[1], 0xA4BEEA44, 4);
+        MD5_STEP(H, ui32D, ui32A, ui32B, ui32C, pui32W[4], 0x4BDECFA9, 11);
+        MD5_STEP(H, ui32C, ui32D, ui32A, ui32B, pui32W[7], 0xF6BB4B60, 16);
+        MD5_STEP(H, ui32B, ui32C, ui32D, ui32A, pui32W[10], 0xBEBFBC70, 23);
+        MD5_STEP(H, ui32A, ui32B, ui32C, ui32D, pui32W[13], 0x289B7EC6, 4);
+        MD5_STEP(H, ui32D, ui32A, ui32B, ui32C, pui32W[0], 0xEAA127FA, 11);
+        MD5_STEP(H, ui32C, ui32D, ui32A, ui32B, pui32W[3], 0xD4EF3085, 16);
+        MD5_STEP(H, ui32B, ui32C, ui32D, ui32A, pui32W[6], 0x04881D05, 23);
+        MD5_STEP(H, ui32A, ui32B, ui32C, ui32D, pui32W[9], 0xD9D4D039, 4);
+        MD5_STEP(H, ui32D, ui32A, ui32B, ui32C, pui32W[12], 0xE6DB99E5, 11);
+        MD5_STEP(H, ui32C, ui32D, ui32A, ui32B, pui32W[15], 0x1FA27CF8, 16);
+        MD5_STEP(H, ui32B, ui32C, ui32D, ui32A, pui32W[2], 0xC4AC5665, 23);
+
+        MD5_STEP(I, ui32A, ui32B, ui32C, ui32D, pui32W[0], 0xF4292244, 6);
+        MD5_STEP(I, ui32D, ui32A, ui32B, ui32C, pui32W[7], 0x432AFF97, 10);
+        MD5_STEP(I, ui32C, ui32D, ui32A, ui32B, pui32W[14], 0xAB9423A7, 15);
+        MD5_STEP(I, ui32B, ui32C, ui32D, ui32A, pui32W[5], 0xFC93A039, 21);
+        MD5_STEP(I, ui32A, ui32B, ui32C, ui32D, pui32W[12], 0x655B59C3, 6);
+        MD5_STEP(I, ui32D, ui32A, ui32B, ui32C, pui32W[3], 0x8F0CCC92, 10);
+        MD5_STEP(I, ui32C, ui32D, ui32A, ui32B, pui32W[10], 0xFFEFF47D, 15);
+        MD5_STEP(I, ui32B, ui32C, ui32D, ui32A, pui32W[1], 0x85845DD1, 21);
+        MD5_STEP(I, ui32A, ui32B, ui32C, ui32D, pui32W[8], 0x6FA87E4F, 6);
+        MD5_STEP(I, ui32D, ui32A, ui32B, ui32C, pui32W[15], 0xFE2CE6E0, 10);
+        MD5_STEP(I, ui32C, ui32D, ui32A, ui32B, pui32W[6], 0xA3014314, 15);
+        MD5_STEP(I, ui32B, ui32C, ui32D, ui32A, pui32W[13], 0x4E0811A1, 21);
+        MD5_STEP(I, ui32A, ui32B, ui32C, ui32D, pui32W[4], 0xF7537E82, 6);
+        MD5_STEP(I, ui32D, ui32A, ui32B, ui32C, pui32W[11], 0xBD3AF235, 10);
+        MD5_STEP(I, ui32C, ui32D, ui32A, ui32B, pui32W[2], 0x2AD7D2BB, 15);
+        MD5_STEP(I, ui32B, ui32C, ui32D, ui32A, pui32W[9], 0xEB86D391, 21);
+
+        //
+        // Add the working variables back into the chaining state.
+        //
+        pui32State[0] += ui32A;
+        pui32State[1] += ui32B;
+        pui32State[2] += ui32C;
+        pui32State[3] += ui32D;
+
+        pui8Data += SW_SHAMD5_BLOCK_SIZE;
+    }
+}
+
+//*****************************************************************************
+//
+// Hashes complete blocks with the algorithm selected in the context.
+//
+//*****************************************************************************
+static void
+SWSHAMD5Blocks(tSWSHAMD5Context *psContext, const uint8_t *pui8Data,
+               uint32_t ui32Blocks)
+{
+    if(psContext->ui32Algo == SHAMD5_ALGO_MD5)
+    {
+        MD5Blocks(psContext->pui32State, pui8Data, ui32Blocks);
+    }
+    else if(psContext->ui32Algo == SHAMD5_ALGO_SHA1)
+    {
+        SHA1Blocks(psContext->pui32State, pui8Data, ui32Blocks);
+    }
+    else
+    {
+        SHA256Blocks(psContext->pui32State, pui8Data, ui32Blocks);
+    }
+}
+
+//*****************************************************************************
+//
+//! Returns the size of the digest produced by a hash algorithm.
+//!
+//! \param ui32Algo is the hash algorithm, which is one of
+//! \b SHAMD5_ALGO_MD5, \b SHAMD5_ALGO_SHA1, \b SHAMD5_ALGO_SHA224 or
+//! \b SHAMD5_ALGO_SHA256.
+//!
+//! \return Returns the digest size in bytes, or 0 if the algorithm is not
+//! supported by the software implementation.
+//
+//*****************************************************************************
+uint32_t
+SWSHAMD5DigestSizeGet(uint32_t ui32Algo)
+{
+    switch(ui32Algo)
+    {
+        case SHAMD5_ALGO_MD5:
+        {
+            return(16);
+        }
+
+        case SHAMD5_ALGO_SHA1:
+        {
+            return(20);
+        }
+
+        case SHAMD5_ALGO_SHA224:
+        {
+            return(28);
+        }
+
+        case SHAMD5_ALGO_SHA256:
+        {
+            return(32);
+        }
+
+        default:
+        {
+            return(0);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! Starts a software hash computation.
+//!
+//! \param psContext is a pointer to the hash context to initialize.
+//! \param ui32Algo is the hash algorithm, which is one of
+//! \b SHAMD5_ALGO_MD5, \b SHAMD5_ALGO_SHA1, \b SHAMD5_ALGO_SHA224 or
+//! \b SHAMD5_ALGO_SHA256.
+//!
+//! This function prepares a context for a new hash.  Data is then added with
+//! SWSHAMD5Update() and the digest is produced by SWSHAMD5Final().
+//!
+//! \return Returns \b true if the context was initialized or \b false if the
+//! algorithm is not supported.
+//
+//*****************************************************************************
+bool
+SWSHAMD5Init(tSWSHAMD5Context *psContext, uint32_t ui32Algo)
+{
+    const uint32_t *pui32Init;
+    uint32_t ui32Idx, ui32Count;
+
+    //
+    // Select the initial hash value.
+    //
+    switch(ui32Algo)
+    {
+        case SHAMD5_ALGO_MD5:
+        {
+            pui32Init = g_pui32MD5Init;
+            ui32Count = 4;
+            break;
+        }
+
+        case SHAMD5_ALGO_SHA1:
+        {
+            pui32Init = g_pui32SHA1Init;
+            ui32Count = 5;
+            break;
+        }
+
+        case SHAMD5_ALGO_SHA224:
+        {
+            pui32Init = g_pui32SHA224Init;
+            ui32Count = 8;
+            break;
+        }
+
+        case SHAMD5_ALGO_SHA256:
+        {
+            pui32Init = g_pui32SHA256Init;
+            ui32Count = 8;
+            break;
+        }
+
+        default:
+        {
+            return(false);
+        }
+    }
+
+    //
+    // Reset the context.
+    //
+    for(ui32Idx = 0; ui32Idx < ui32Count; ui32Idx++)
+    {
+        psContext->pui32State[ui32Idx] = pui32Init[ui32Idx];
+    }
+    psContext->ui32LengthLow = 0;
+    psContext->ui32LengthHigh = 0;
+    psContext->ui32Algo = ui32Algo;
+
+    //
+    // Success.
+    //
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Adds data to a software hash computation.
+//!
+//! \param psContext is a pointer to a context set up by SWSHAMD5Init().
+//! \param pui8Data is a pointer to the data to hash; it need not be word
+//! aligned.
+//! \param ui32Length is the number of bytes of data.
+//!
+//! This function may be called any number of times with data of any length.
+//! Complete blocks are hashed directly from the caller's buffer; only the
+//! bytes that do not fill a block are copied into the context.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SWSHAMD5Update(tSWSHAMD5Context *psContext, const uint8_t *pui8Data,
+               uint32_t ui32Length)
+{
+    uint8_t *pui8Block;
+    uint32_t ui32Used, ui32Blocks;
+
+    //
+    // Find the number of bytes already waiting in the partial block, then
+    // update the total length.
+    //
+    pui8Block = (uint8_t *)psContext->pui32Block;
+    ui32Used = psContext->ui32LengthLow % SW_SHAMD5_BLOCK_SIZE;
+    psContext->ui32LengthLow += ui32Length;
+    if(psContext->ui32LengthLow < ui32Length)
+    {
+        psContext->ui32LengthHigh++;
+    }
+
+    //
+    // Top up the partial block first, hashing it if it becomes full.
+    //
+    if(ui32Used)
+    {
+        while(ui32Length && (ui32Used < SW_SHAMD5_BLOCK_SIZE))
+        {
+            pui8Block[ui32Used++] = *pui8Data++;
+            ui32Length--;
+        }
+        if(ui32Used < SW_SHAMD5_BLOCK_SIZE)
+        {
+            return;
+        }
+        SWSHAMD5Blocks(psContext, pui8Block, 1);
+    }
+
+    //
+    // Hash as many whole blocks as possible straight from the input.
+    //
+    ui32Blocks = ui32Length / SW_SHAMD5_BLOCK_SIZE;
+    if(ui32Blocks)
+    {
+        SWSHAMD5Blocks(psContext, pui8Data, ui32Blocks);
+        pui8Data += ui32Blocks * SW_SHAMD5_BLOCK_SIZE;
+        ui32Length -= ui32Blocks * SW_SHAMD5_BLOCK_SIZE;
+    }
+
+    //
+    // Save any remaining bytes for later.
+    //
+    for(ui32Used = 0; ui32Used < ui32Length; ui32Used++)
+    {
+        pui8Block[ui32Used] = pui8Data[ui32Used];
+    }
+}
+
+//*****************************************************************************
+//
+//! Completes a software hash computation.
+//!
+//! \param psContext is a pointer to a context set up by SWSHAMD5Init().
+//! \param pui8Digest is a pointer to the buffer that receives the digest.
+//! It must hold SWSHAMD5DigestSizeGet() bytes for the algorithm in use.
+//!
+//! This function pads the message, hashes the final block and writes the
+//! digest in its standard byte order.  The context must be initialized again
+//! before it is reused.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SWSHAMD5Final(tSWSHAMD5Context *psContext, uint8_t *pui8Digest)
+{
+    uint8_t *pui8Block;
+    uint32_t ui32Used, ui32BitsLow, ui32BitsHigh, ui32Idx, ui32Size;
+
+    //
+    // Append the 0x80 terminator to the partial block.
+    //
+    pui8Block = (uint8_t *)psContext->pui32Block;
+    ui32Used = psContext->ui32LengthLow % SW_SHAMD5_BLOCK_SIZE;
+    pui8Block[ui32Used++] = 0x80;
+
+    //
+    // If there is no room for the 64-bit length, pad out and hash this block
+    // and put the length in a block of its own.
+    //
+    if(ui32Used > (SW_SHAMD5_BLOCK_SIZE - 8))
+    {
+        while(ui32Used < SW_SHAMD5_BLOCK_SIZE)
+        {
+            pui8Block[ui32Used++] = 0;
+        }
+        SWSHAMD5Blocks(psContext, pui8Block, 1);
+        ui32Used = 0;
+    }
+    while(ui32Used < (SW_SHAMD5_BLOCK_SIZE - 8))
+    {
+        pui8Block[ui32Used++] = 0;
+    }
+
+    //
+    // Append the message length in bits; little-endian for MD5 and
+    // big-endian for SHA.
+    //
+    ui32BitsLow = psContext->ui32LengthLow << 3;
+    ui32BitsHigh = ((psContext->ui32LengthHigh << 3) |
+                    (psContext->ui32LengthLow >> 29));
+    for(ui32Idx = 0; ui32Idx < 4; ui32Idx++)
+    {
+        if(psContext->ui32Algo == SHAMD5_ALGO_MD5)
+        {
+            pui8Block[56 + ui32Idx] = (uint8_t)(ui32BitsLow >> (8 * ui32Idx));
+            pui8Block[60 + ui32Idx] = (uint8_t)(ui32BitsHigh >> (8 * ui32Idx));
+        }
+        else
+        {
+            pui8Block[63 - ui32Idx] = (uint8_t)(ui32BitsLow >> (8 * ui32Idx));
+            pui8Block[59 - ui32Idx] = (uint8_t)(ui32BitsHigh >> (8 * ui32Idx));
+        }
+    }
+    SWSHAMD5Blocks(psContext, pui8Block, 1);
+
+    //
+    // Write out the digest in the byte order of the algorithm.
+    //
+    ui32Size = SWSHAMD5DigestSizeGet(psContext->ui32Algo);
+    for(ui32Idx = 0; ui32Idx < ui32Size; ui32Idx++)
+    {
+        ui32Used = psContext->pui32State[ui32Idx / 4];
+        if(psContext->ui32Algo == SHAMD5_ALGO_MD5)
+        {
+            pui8Digest[ui32Idx] = (uint8_t)(ui32Used >> (8 * (ui32Idx % 4)));
+        }
+        else
+        {
+            pui8Digest[ui32Idx] = (uint8_t)(ui32Used >>
+                                            (24 - (8 * (ui32Idx % 4))));
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
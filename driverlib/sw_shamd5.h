@@ -0,0 +1,115 @@
+//*****************************************************************************
+//
+// sw_shamd5.h - Prototypes for the software SHA and MD5 hash functions.
+//
+// Copyright (c) 2010-2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+//   Redistribution and use in source and binary forms, with or without
+//   modification, are permitted provided that the following conditions
+//   are met:
+// 
+//   Redistributions of source code must retain the above copyright
+//   notice, this list of conditions and the following disclaimer.
+// 
+//   Redistributions in binary form must reproduce the above copyright
+//   notice, this list of conditions and the following disclaimer in the
+//   documentation and/or other materials provided with the  
+//   distribution.
+// 
+//   Neither the name of Texas Instruments Incorporated nor the names of
+//   its contributors may be used to endorse or promote products derived
+//   from this software without specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Peripheral Driver Library.
+//
+
+#ifndef __DRIVERLIB_SW_SHAMD5_H__
+#define __DRIVERLIB_SW_SHAMD5_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+// The block size of all of the supported hash algorithms and the size of the
+// largest digest, both in bytes.
+//
+//*****************************************************************************
+#define SW_SHAMD5_BLOCK_SIZE    64
+#define SW_SHAMD5_DIGEST_MAX    32
+
+//*****************************************************************************
+//
+// The state of a software hash computation.  The algorithm is selected with
+// one of the SHAMD5_ALGO_* values from shamd5.h.  The contents of this
+// structure are private and must only be accessed through the SWSHAMD5
+// functions.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The chaining state of the hash.
+    //
+    uint32_t pui32State[8];
+
+    //
+    // The partial block that has not yet been hashed, kept word aligned.
+    //
+    uint32_t pui32Block[SW_SHAMD5_BLOCK_SIZE / 4];
+
+    //
+    // The number of bytes that have been added to the hash so far.
+    //
+    uint32_t ui32LengthLow;
+    uint32_t ui32LengthHigh;
+
+    //
+    // The hash algorithm in use.
+    //
+    uint32_t ui32Algo;
+}
+tSWSHAMD5Context;
+
+//*****************************************************************************
+//
+// Prototypes for the functions.
+//
+//*****************************************************************************
+extern uint32_t SWSHAMD5DigestSizeGet(uint32_t ui32Algo);
+extern bool SWSHAMD5Init(tSWSHAMD5Context *psContext, uint32_t ui32Algo);
+extern void SWSHAMD5Update(tSWSHAMD5Context *psContext,
+                           const uint8_t *pui8Data, uint32_t ui32Length);
+extern void SWSHAMD5Final(tSWSHAMD5Context *psContext, uint8_t *pui8Digest);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __DRIVERLIB_SW_SHAMD5_H__
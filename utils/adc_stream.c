@@ -0,0 +1,526 @@
+//*****************************************************************************
+//
+// adc_stream.c - Continuous ADC sampling with uDMA and block decimation.
+//
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Utility Library.
+//
+//*****************************************************************************
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_adc.h"
+#include "inc/hw_types.h"
+#include "driverlib/adc.h"
+#include "driverlib/debug.h"
+#include "driverlib/rom.h"
+#include "driverlib/rom_map.h"
+#include "driverlib/timer.h"
+#include "driverlib/udma.h"
+#include "utils/adc_stream.h"
+
+//*****************************************************************************
+//
+//! \addtogroup adc_stream_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Arms one of the uDMA control structures of the stream's channel to fill
+// the given block of the ring.
+//
+//*****************************************************************************
+static void
+ADCStreamBlockArm(tADCStream *psStream, uint32_t ui32Select,
+                  uint32_t ui32Block)
+{
+    MAP_uDMAChannelTransferSet(psStream->ui32DMAChannel | ui32Select,
+                               UDMA_MODE_PINGPONG,
+                               (void *)(psStream->ui32ADCBase + ADC_O_SSFIFO0 +
+                                        ((ADC_O_SSFIFO1 - ADC_O_SSFIFO0) *
+                                         psStream->ui32Sequence)),
+                               (psStream->pui16Blocks +
+                                ((ui32Block % psStream->ui32NumBlocks) *
+                                 psStream->ui32BlockSize)),
+                               psStream->ui32BlockSize);
+}
+
+//*****************************************************************************
+//
+//! Prepares a continuous ADC sampling stream.
+//!
+//! \param psStream is a pointer to the stream state structure.
+//! \param ui32ADCBase is the base address of the ADC module.
+//! \param ui32Sequence is the sample sequencer to use.
+//! \param ui32Channel is the input to sample, specified as one of the
+//! \b ADC_CTL_CH values, optionally ORed with \b ADC_CTL_D or \b ADC_CTL_TS.
+//! \param ui32DMAChannel is the uDMA channel assignment for the sample
+//! sequencer, such as \b UDMA_CH17_ADC0_3.
+//! \param pui16Blocks is the ring of sample blocks, which must hold
+//! \e ui32BlockSize * \e ui32NumBlocks samples.
+//! \param ui32BlockSize is the number of samples in each block, from 1 to
+//! 1024.
+//! \param ui32NumBlocks is the number of blocks in the ring, which must be at
+//! least 3.
+//!
+//! This function configures a sample sequencer to convert a single input on
+//! each timer trigger, and the uDMA controller to move each result into a
+//! ring of blocks in ping-pong mode.  Two blocks are always being filled by
+//! the uDMA controller and the remainder are available to the application, so
+//! the processor is involved only once per block rather than once per sample.
+//!
+//! The ADC, timer and uDMA peripherals must have been enabled, the uDMA
+//! control table set, and the input pin configured for analog use by the
+//! caller.  The caller must also enable the sample sequencer's interrupt in
+//! the interrupt controller and call ADCStreamIntHandler() from its handler.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ADCStreamInit(tADCStream *psStream, uint32_t ui32ADCBase,
+              uint32_t ui32Sequence, uint32_t ui32Channel,
+              uint32_t ui32DMAChannel, uint16_t *pui16Blocks,
+              uint32_t ui32BlockSize, uint32_t ui32NumBlocks)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psStream);
+    ASSERT(ui32Sequence < 4);
+    ASSERT(pui16Blocks);
+    ASSERT((ui32BlockSize > 0) && (ui32BlockSize <= 1024));
+    ASSERT(ui32NumBlocks >= 3);
+
+    psStream->ui32ADCBase = ui32ADCBase;
+    psStream->ui32Sequence = ui32Sequence;
+    psStream->ui32DMAChannel = ui32DMAChannel & 0x1f;
+    psStream->ui32TimerBase = 0;
+    psStream->pui16Blocks = pui16Blocks;
+    psStream->ui32BlockSize = ui32BlockSize;
+    psStream->ui32NumBlocks = ui32NumBlocks;
+    psStream->ui32Filled = 0;
+    psStream->ui32Consumed = 0;
+    psStream->ui32NextSelect = UDMA_PRI_SELECT;
+    psStream->ui32Overruns = 0;
+
+    //
+    // Convert the input once per timer trigger, requesting a uDMA transfer
+    // for each result.
+    //
+    MAP_ADCSequenceDisable(ui32ADCBase, ui32Sequence);
+    MAP_ADCSequenceConfigure(ui32ADCBase, ui32Sequence, ADC_TRIGGER_TIMER, 0);
+    MAP_ADCSequenceStepConfigure(ui32ADCBase, ui32Sequence, 0,
+                                 ui32Channel | ADC_CTL_IE | ADC_CTL_END);
+    MAP_ADCSequenceDMAEnable(ui32ADCBase, ui32Sequence);
+
+    //
+    // Set up the uDMA channel to move 16-bit results from the FIFO into
+    // consecutive locations of the ring.
+    //
+    MAP_uDMAChannelAssign(ui32DMAChannel);
+    MAP_uDMAChannelAttributeDisable(psStream->ui32DMAChannel,
+                                    (UDMA_ATTR_ALTSELECT | UDMA_ATTR_USEBURST |
+                                     UDMA_ATTR_HIGH_PRIORITY |
+                                     UDMA_ATTR_REQMASK));
+    MAP_uDMAChannelControlSet(psStream->ui32DMAChannel | UDMA_PRI_SELECT,
+                              (UDMA_SIZE_16 | UDMA_SRC_INC_NONE |
+                               UDMA_DST_INC_16 | UDMA_ARB_1));
+    MAP_uDMAChannelControlSet(psStream->ui32DMAChannel | UDMA_ALT_SELECT,
+                              (UDMA_SIZE_16 | UDMA_SRC_INC_NONE |
+                               UDMA_DST_INC_16 | UDMA_ARB_1));
+
+    //
+    // Fill the first two blocks of the ring.
+    //
+    ADCStreamBlockArm(psStream, UDMA_PRI_SELECT, 0);
+    ADCStreamBlockArm(psStream, UDMA_ALT_SELECT, 1);
+}
+
+//*****************************************************************************
+//
+//! Starts a continuous ADC sampling stream.
+//!
+//! \param psStream is a pointer to the stream state structure.
+//! \param ui32TimerBase is the base address of the timer used to trigger
+//! conversions.  Timer A of this timer is configured as a full-width periodic
+//! timer.
+//! \param ui32SysClock is the clock rate of the timer in Hz.
+//! \param ui32SampleRate is the desired sample rate in Hz.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ADCStreamStart(tADCStream *psStream, uint32_t ui32TimerBase,
+               uint32_t ui32SysClock, uint32_t ui32SampleRate)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psStream);
+    ASSERT(ui32SampleRate && (ui32SampleRate <= ui32SysClock));
+
+    psStream->ui32TimerBase = ui32TimerBase;
+
+    //
+    // Enable the sample sequencer, its interrupt (which signals the
+    // completion of each uDMA block) and the uDMA channel.
+    //
+    MAP_ADCIntClear(psStream->ui32ADCBase, psStream->ui32Sequence);
+    MAP_ADCIntEnable(psStream->ui32ADCBase, psStream->ui32Sequence);
+    MAP_ADCSequenceEnable(psStream->ui32ADCBase, psStream->ui32Sequence);
+    MAP_uDMAChannelEnable(psStream->ui32DMAChannel);
+
+    //
+    // Trigger a conversion at each timeout of the timer.
+    //
+    MAP_TimerConfigure(ui32TimerBase, TIMER_CFG_PERIODIC);
+    MAP_TimerLoadSet(ui32TimerBase, TIMER_A,
+                     (ui32SysClock / ui32SampleRate) - 1);
+    MAP_TimerControlTrigger(ui32TimerBase, TIMER_A, true);
+    MAP_TimerEnable(ui32TimerBase, TIMER_A);
+}
+
+//*****************************************************************************
+//
+//! Stops a continuous ADC sampling stream.
+//!
+//! \param psStream is a pointer to the stream state structure.
+//!
+//! This function stops the trigger timer and disables the sample sequencer
+//! and uDMA channel.  Blocks that were already filled remain available
+//! through ADCStreamBlockGet().
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ADCStreamStop(tADCStream *psStream)
+{
+    if(psStream->ui32TimerBase)
+    {
+        MAP_TimerDisable(psStream->ui32TimerBase, TIMER_A);
+    }
+    MAP_uDMAChannelDisable(psStream->ui32DMAChannel);
+    MAP_ADCIntDisable(psStream->ui32ADCBase, psStream->ui32Sequence);
+    MAP_ADCSequenceDisable(psStream->ui32ADCBase, psStream->ui32Sequence);
+}
+
+//*****************************************************************************
+//
+//! Handles the sample sequencer interrupt for an ADC stream.
+//!
+//! \param psStream is a pointer to the stream state structure.
+//!
+//! This function must be called from the interrupt handler of the stream's
+//! sample sequencer.  For each block that the uDMA controller has completed,
+//! it publishes the block to the application and re-arms the idle control
+//! structure with the block two places further around the ring.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ADCStreamIntHandler(tADCStream *psStream)
+{
+    MAP_ADCIntClear(psStream->ui32ADCBase, psStream->ui32Sequence);
+
+    //
+    // Handle the completed control structures in the order in which they
+    // were filled.  At most two can be complete if this interrupt was
+    // delayed.
+    //
+    while(MAP_uDMAChannelModeGet(psStream->ui32DMAChannel |
+                                 psStream->ui32NextSelect) == UDMA_MODE_STOP)
+    {
+        //
+        // Publish the block, then reuse the control structure for the block
+        // after the one that the other control structure is filling.
+        //
+        psStream->ui32Filled++;
+        ADCStreamBlockArm(psStream, psStream->ui32NextSelect,
+                          psStream->ui32Filled + 1);
+        psStream->ui32NextSelect ^= UDMA_ALT_SELECT;
+    }
+}
+
+//*****************************************************************************
+//
+//! Returns the oldest unconsumed block of an ADC stream.
+//!
+//! \param psStream is a pointer to the stream state structure.
+//!
+//! This function returns the next block of samples in the stream.  If the
+//! application has fallen so far behind that blocks have been overwritten,
+//! they are skipped and counted as overruns.  Once the block has been
+//! processed, it must be released with ADCStreamBlockRelease().
+//!
+//! \return Returns a pointer to the block's samples, or 0 if no new block is
+//! available.
+//
+//*****************************************************************************
+const uint16_t *
+ADCStreamBlockGet(tADCStream *psStream)
+{
+    uint32_t ui32Filled, ui32Behind;
+
+    ui32Filled = psStream->ui32Filled;
+    if(ui32Filled == psStream->ui32Consumed)
+    {
+        return(0);
+    }
+
+    //
+    // Skip any blocks that have been, or are being, overwritten.  Two blocks
+    // of the ring are always owned by the uDMA controller.
+    //
+    ui32Behind = ui32Filled - psStream->ui32Consumed;
+    if(ui32Behind > (psStream->ui32NumBlocks - 2))
+    {
+        psStream->ui32Overruns += ui32Behind - (psStream->ui32NumBlocks - 2);
+        psStream->ui32Consumed = ui32Filled - (psStream->ui32NumBlocks - 2);
+    }
+
+    return(psStream->pui16Blocks +
+           ((psStream->ui32Consumed % psStream->ui32NumBlocks) *
+            psStream->ui32BlockSize));
+}
+
+//*****************************************************************************
+//
+//! Releases the block returned by ADCStreamBlockGet().
+//!
+//! \param psStream is a pointer to the stream state structure.
+//!
+//! \return Returns \b true if the block was intact for the whole time it was
+//! held, or \b false if the uDMA controller began overwriting it because the
+//! application did not keep up, in which case the results computed from it
+//! should be discarded.
+//
+//*****************************************************************************
+bool
+ADCStreamBlockRelease(tADCStream *psStream)
+{
+    bool bIntact;
+
+    bIntact = ((psStream->ui32Filled + 1 - psStream->ui32Consumed) <
+               psStream->ui32NumBlocks);
+    if(!bIntact)
+    {
+        psStream->ui32Overruns++;
+    }
+    psStream->ui32Consumed++;
+
+    return(bIntact);
+}
+
+//*****************************************************************************
+//
+//! Returns the number of blocks lost to overruns.
+//!
+//! \param psStream is a pointer to the stream state structure.
+//!
+//! \return Returns the number of blocks that were overwritten before the
+//! application had finished with them.
+//
+//*****************************************************************************
+uint32_t
+ADCStreamOverrunsGet(tADCStream *psStream)
+{
+    return(psStream->ui32Overruns);
+}
+
+//*****************************************************************************
+//
+//! Initializes a block decimator.
+//!
+//! \param psDecimator is a pointer to the decimator state structure.
+//! \param ui32CICOrder is the order of the CIC filter, from 1 to 3.  An order
+//! of 1 averages each group of \e ui32CICRatio samples.
+//! \param ui32CICRatio is the decimation ratio of the CIC filter.  The CIC
+//! gain, \e ui32CICRatio raised to \e ui32CICOrder, must not exceed 2^20 so
+//! that 12-bit samples fit in the 32-bit integrators.
+//! \param pi16Taps is the FIR filter taps in 1.15 fixed-point format, or 0 to
+//! use the CIC output directly.  The taps would typically compensate for the
+//! droop of the CIC filter's passband.
+//! \param ui32NumTaps is the number of FIR filter taps, up to
+//! \b ADC_DECIMATOR_MAX_TAPS.
+//! \param ui32FIRRatio is the decimation ratio of the FIR filter.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+ADCDecimatorInit(tADCDecimator *psDecimator, uint32_t ui32CICOrder,
+                 uint32_t ui32CICRatio, const int16_t *pi16Taps,
+                 uint32_t ui32NumTaps, uint32_t ui32FIRRatio)
+{
+    uint32_t ui32Idx;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psDecimator);
+    ASSERT((ui32CICOrder >= 1) && (ui32CICOrder <= 3));
+    ASSERT(ui32CICRatio >= 1);
+    ASSERT(!pi16Taps || ((ui32NumTaps >= 1) &&
+                         (ui32NumTaps <= ADC_DECIMATOR_MAX_TAPS)));
+    ASSERT(!pi16Taps || (ui32FIRRatio >= 1));
+
+    psDecimator->ui32CICOrder = ui32CICOrder;
+    psDecimator->ui32CICRatio = ui32CICRatio;
+    psDecimator->ui32CICPhase = 0;
+    psDecimator->pi16Taps = pi16Taps;
+    psDecimator->ui32NumTaps = pi16Taps ? ui32NumTaps : 0;
+    psDecimator->ui32FIRRatio = ui32FIRRatio;
+    psDecimator->ui32FIRPhase = 0;
+    psDecimator->ui32HistoryIndex = 0;
+
+    //
+    // The DC gain of the CIC filter is the ratio raised to the order.
+    //
+    psDecimator->ui32CICGain = 1;
+    for(ui32Idx = 0; ui32Idx < ui32CICOrder; ui32Idx++)
+    {
+        psDecimator->ui32CICGain *= ui32CICRatio;
+        psDecimator->pui32Integrator[ui32Idx] = 0;
+        psDecimator->pui32Comb[ui32Idx] = 0;
+    }
+    ASSERT(psDecimator->ui32CICGain <= (1 << 20));
+
+    for(ui32Idx = 0; ui32Idx < (2 * ADC_DECIMATOR_MAX_TAPS); ui32Idx++)
+    {
+        psDecimator->pi32History[ui32Idx] = 0;
+    }
+}
+
+//*****************************************************************************
+//
+//! Decimates a block of ADC samples.
+//!
+//! \param psDecimator is a pointer to the decimator state structure.
+//! \param pui16In is the block of samples, such as one returned by
+//! ADCStreamBlockGet().
+//! \param ui32Count is the number of samples in the block.
+//! \param pi32Out is the buffer to store the decimated samples.  It must have
+//! room for \e ui32Count divided by the overall decimation ratio, plus one.
+//!
+//! This function passes the samples through the CIC filter and then the FIR
+//! filter in a single pass, reading each input sample exactly once.  The
+//! output is scaled to the same range as the input.  The filter states carry
+//! over from block to block, so blocks need not be a multiple of the
+//! decimation ratio.
+//!
+//! \return Returns the number of samples stored in \e pi32Out.
+//
+//*****************************************************************************
+uint32_t
+ADCDecimate(tADCDecimator *psDecimator, const uint16_t *pui16In,
+            uint32_t ui32Count, int32_t *pi32Out)
+{
+    uint32_t ui32Stage, ui32Value, ui32Prev, ui32Produced, ui32Idx;
+    const int32_t *pi32History;
+    int32_t i32Sample;
+    int64_t i64Acc;
+
+    ui32Produced = 0;
+
+    for(; ui32Count; ui32Count--)
+    {
+        //
+        // Run the integrators at the input rate.
+        //
+        ui32Value = *pui16In++;
+        for(ui32Stage = 0; ui32Stage < psDecimator->ui32CICOrder; ui32Stage++)
+        {
+            ui32Value += psDecimator->pui32Integrator[ui32Stage];
+            psDecimator->pui32Integrator[ui32Stage] = ui32Value;
+        }
+
+        if(++psDecimator->ui32CICPhase < psDecimator->ui32CICRatio)
+        {
+            continue;
+        }
+        psDecimator->ui32CICPhase = 0;
+
+        //
+        // Run the combs at the decimated rate and remove the CIC gain.
+        //
+        for(ui32Stage = 0; ui32Stage < psDecimator->ui32CICOrder; ui32Stage++)
+        {
+            ui32Prev = psDecimator->pui32Comb[ui32Stage];
+            psDecimator->pui32Comb[ui32Stage] = ui32Value;
+            ui32Value -= ui32Prev;
+        }
+        i32Sample = ui32Value / psDecimator->ui32CICGain;
+
+        //
+        // Use the CIC output directly if there is no FIR filter.
+        //
+        if(psDecimator->ui32NumTaps == 0)
+        {
+            pi32Out[ui32Produced++] = i32Sample;
+            continue;
+        }
+
+        //
+        // Add the sample to both copies of the FIR history.
+        //
+        ui32Idx = psDecimator->ui32HistoryIndex;
+        psDecimator->pi32History[ui32Idx] = i32Sample;
+        psDecimator->pi32History[ui32Idx + psDecimator->ui32NumTaps] =
+            i32Sample;
+        if(++ui32Idx == psDecimator->ui32NumTaps)
+        {
+            ui32Idx = 0;
+        }
+        psDecimator->ui32HistoryIndex = ui32Idx;
+
+        if(++psDecimator->ui32FIRPhase < psDecimator->ui32FIRRatio)
+        {
+            continue;
+        }
+        psDecimator->ui32FIRPhase = 0;
+
+        //
+        // Apply the taps to the most recent samples, oldest first.
+        //
+        pi32History = &psDecimator->pi32History[ui32Idx];
+        for(i64Acc = 0, ui32Idx = 0; ui32Idx < psDecimator->ui32NumTaps;
+            ui32Idx++)
+        {
+            i64Acc += (int64_t)pi32History[ui32Idx] *
+                      psDecimator->pi16Taps[ui32Idx];
+        }
+        pi32Out[ui32Produced++] = (int32_t)((i64Acc + 16384) >> 15);
+    }
+
+    return(ui32Produced);
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
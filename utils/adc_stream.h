@@ -0,0 +1,205 @@
+//*****************************************************************************
+//
+// adc_stream.h - Prototypes for the continuous ADC sampling engine.
+//
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Utility Library.
+//
+//*****************************************************************************
+//*****************************************************************************
+
+#ifndef __ADC_STREAM_H__
+#define __ADC_STREAM_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+//! \addtogroup adc_stream_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! The largest number of FIR filter taps supported by the decimator.
+//! Applications may override this by defining the label before including this
+//! header.
+//
+//*****************************************************************************
+#ifndef ADC_DECIMATOR_MAX_TAPS
+#define ADC_DECIMATOR_MAX_TAPS  32
+#endif
+
+//*****************************************************************************
+//
+//! The state of a continuous ADC sampling stream.  The members of this
+//! structure are private to the ADC stream module and must not be accessed by
+//! the application.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The ADC base address and sample sequencer used for the stream.
+    //
+    uint32_t ui32ADCBase;
+    uint32_t ui32Sequence;
+
+    //
+    // The uDMA channel that services the sample sequencer.
+    //
+    uint32_t ui32DMAChannel;
+
+    //
+    // The timer used to trigger conversions.
+    //
+    uint32_t ui32TimerBase;
+
+    //
+    // The ring of sample blocks, the number of samples in each block and the
+    // number of blocks in the ring.
+    //
+    uint16_t *pui16Blocks;
+    uint32_t ui32BlockSize;
+    uint32_t ui32NumBlocks;
+
+    //
+    // The number of blocks that have been filled by the uDMA controller and
+    // the number that have been consumed by the application.  Both count up
+    // continuously; the ring index is the count modulo the number of blocks.
+    //
+    volatile uint32_t ui32Filled;
+    volatile uint32_t ui32Consumed;
+
+    //
+    // The uDMA control structure, primary or alternate, that will complete
+    // next.
+    //
+    uint32_t ui32NextSelect;
+
+    //
+    // The number of blocks that were overwritten before being consumed.
+    //
+    uint32_t ui32Overruns;
+}
+tADCStream;
+
+//*****************************************************************************
+//
+//! The state of a block decimator, which is a cascaded integrator-comb (CIC)
+//! filter followed by an optional decimating FIR filter.  The members of this
+//! structure are private to the ADC stream module and must not be accessed by
+//! the application.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The order and decimation ratio of the CIC filter, and its DC gain.
+    //
+    uint32_t ui32CICOrder;
+    uint32_t ui32CICRatio;
+    uint32_t ui32CICGain;
+
+    //
+    // The CIC integrator and comb delay states.  These use modulo arithmetic
+    // so wrapping is harmless.
+    //
+    uint32_t pui32Integrator[3];
+    uint32_t pui32Comb[3];
+
+    //
+    // The number of input samples since the last CIC output.
+    //
+    uint32_t ui32CICPhase;
+
+    //
+    // The FIR filter taps in 1.15 fixed-point format, or 0 if the CIC output
+    // is used directly.
+    //
+    const int16_t *pi16Taps;
+    uint32_t ui32NumTaps;
+
+    //
+    // The decimation ratio of the FIR filter and the number of CIC outputs
+    // since the last FIR output.
+    //
+    uint32_t ui32FIRRatio;
+    uint32_t ui32FIRPhase;
+
+    //
+    // The FIR filter history, stored twice so that the taps can always be
+    // applied to a contiguous run of samples.
+    //
+    int32_t pi32History[2 * ADC_DECIMATOR_MAX_TAPS];
+    uint32_t ui32HistoryIndex;
+}
+tADCDecimator;
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Prototypes for the ADC stream functions.
+//
+//*****************************************************************************
+extern void ADCStreamInit(tADCStream *psStream, uint32_t ui32ADCBase,
+                          uint32_t ui32Sequence, uint32_t ui32Channel,
+                          uint32_t ui32DMAChannel, uint16_t *pui16Blocks,
+                          uint32_t ui32BlockSize, uint32_t ui32NumBlocks);
+extern void ADCStreamStart(tADCStream *psStream, uint32_t ui32TimerBase,
+                           uint32_t ui32SysClock, uint32_t ui32SampleRate);
+extern void ADCStreamStop(tADCStream *psStream);
+extern void ADCStreamIntHandler(tADCStream *psStream);
+extern const uint16_t *ADCStreamBlockGet(tADCStream *psStream);
+extern bool ADCStreamBlockRelease(tADCStream *psStream);
+extern uint32_t ADCStreamOverrunsGet(tADCStream *psStream);
+extern void ADCDecimatorInit(tADCDecimator *psDecimator,
+                             uint32_t ui32CICOrder, uint32_t ui32CICRatio,
+                             const int16_t *pi16Taps, uint32_t ui32NumTaps,
+                             uint32_t ui32FIRRatio);
+extern uint32_t ADCDecimate(tADCDecimator *psDecimator,
+                            const uint16_t *pui16In, uint32_t ui32Count,
+                            int32_t *pi32Out);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __ADC_STREAM_H__
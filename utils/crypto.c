@@ -0,0 +1,625 @@
+//*****************************************************************************
+//
+// crypto.c - Dispatch between the hardware and software crypto engines.
+//
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Utility Library.
+//
+//*****************************************************************************
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/aes.h"
+#include "driverlib/rom.h"
+#include "driverlib/rom_map.h"
+#include "driverlib/shamd5.h"
+#include "driverlib/sw_aes.h"
+#include "driverlib/sw_shamd5.h"
+#include "driverlib/sysctl.h"
+#include "utils/crypto.h"
+
+//*****************************************************************************
+//
+//! \addtogroup crypto_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// True if the device has the AES and SHA/MD5 modules and they have been
+// enabled by CryptoInit().
+//
+//*****************************************************************************
+static bool g_bCryptoHardware = false;
+
+//*****************************************************************************
+//
+// Returns true if a pointer is word aligned, which the hardware modules
+// need since they are fed a word at a time.
+//
+//*****************************************************************************
+#define CRYPTO_ALIGNED(pvPtr)   ((((uint32_t)(pvPtr)) & 3) == 0)
+
+//*****************************************************************************
+//
+// Copies a number of bytes; used for the small IV and digest buffers.
+//
+//*****************************************************************************
+static void
+CryptoCopy(uint8_t *pui8Dest, const uint8_t *pui8Src, uint32_t ui32Count)
+{
+    while(ui32Count--)
+    {
+        *pui8Dest++ = *pui8Src++;
+    }
+}
+
+//*****************************************************************************
+//
+// Adds a block count to a 128-bit big-endian counter, as used by CTR mode.
+//
+//*****************************************************************************
+static void
+CryptoCounterAdd(uint8_t *pui8Counter, uint32_t ui32Count)
+{
+    uint32_t ui32Idx, ui32Sum;
+
+    for(ui32Idx = CRYPTO_AES_BLOCK_SIZE; ui32Idx && ui32Count; ui32Idx--)
+    {
+        ui32Sum = pui8Counter[ui32Idx - 1] + (ui32Count & 0xff);
+        pui8Counter[ui32Idx - 1] = (uint8_t)ui32Sum;
+        ui32Count = (ui32Count >> 8) + (ui32Sum >> 8);
+    }
+}
+
+//*****************************************************************************
+//
+// Returns the AES module key size configuration for a key length in bits.
+//
+//*****************************************************************************
+static uint32_t
+CryptoAESKeySize(uint32_t ui32KeyBits)
+{
+    if(ui32KeyBits == 128)
+    {
+        return(AES_CFG_KEY_SIZE_128BIT);
+    }
+    else if(ui32KeyBits == 192)
+    {
+        return(AES_CFG_KEY_SIZE_192BIT);
+    }
+    else
+    {
+        return(AES_CFG_KEY_SIZE_256BIT);
+    }
+}
+
+//*****************************************************************************
+//
+//! Initializes the crypto dispatch layer.
+//!
+//! This function checks whether the device has the CCM module, which holds
+//! the AES and SHA/MD5 hardware accelerators.  If it does, the module is
+//! enabled and all subsequent requests that the hardware can handle are sent
+//! to it.  Otherwise, or before this function is called, all requests are
+//! handled by the software implementations in sw_aes.c and sw_shamd5.c.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+CryptoInit(void)
+{
+    //
+    // Enable the CCM module if the device has one.
+    //
+    if(MAP_SysCtlPeripheralPresent(SYSCTL_PERIPH_CCM0))
+    {
+        MAP_SysCtlPeripheralEnable(SYSCTL_PERIPH_CCM0);
+        while(!MAP_SysCtlPeripheralReady(SYSCTL_PERIPH_CCM0))
+        {
+        }
+        g_bCryptoHardware = true;
+    }
+    else
+    {
+        g_bCryptoHardware = false;
+    }
+}
+
+//*****************************************************************************
+//
+//! Reports whether the hardware crypto modules are in use.
+//!
+//! \return Returns \b true if CryptoInit() found and enabled the AES and
+//! SHA/MD5 modules, or \b false if the software implementations are used.
+//
+//*****************************************************************************
+bool
+CryptoHardwarePresent(void)
+{
+    return(g_bCryptoHardware);
+}
+
+//*****************************************************************************
+//
+//! Prepares an AES key for use with CryptoAESProcess().
+//!
+//! \param psContext is a pointer to the key context to fill.
+//! \param pui8Key is a pointer to the key bytes.
+//! \param ui32KeyBits is the key size in bits; 128, 192 or 256.
+//!
+//! The key is kept in raw form for the hardware and is also expanded for the
+//! software implementation, so the context can be used with either.
+//!
+//! \return Returns \b true if the key was set or \b false if the key size is
+//! not valid.
+//
+//*****************************************************************************
+bool
+CryptoAESKeySet(tCryptoAESContext *psContext, const uint8_t *pui8Key,
+                uint32_t ui32KeyBits)
+{
+    //
+    // Expand the key for the software implementation, which also validates
+    // the key size.
+    //
+    if(!SWAESKeySet(&psContext->sSoftware, pui8Key, ui32KeyBits))
+    {
+        return(false);
+    }
+
+    //
+    // Keep a word-aligned copy of the key to load into the AES module.
+    //
+    CryptoCopy((uint8_t *)psContext->pui32Key, pui8Key, ui32KeyBits / 8);
+    psContext->ui32KeyBits = ui32KeyBits;
+
+    //
+    // Success.
+    //
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Encrypts or decrypts data with AES.
+//!
+//! \param psContext is a pointer to a key context set up by
+//! CryptoAESKeySet().
+//! \param ui32Mode is the block cipher mode; one of \b CRYPTO_AES_ECB,
+//! \b CRYPTO_AES_CBC or \b CRYPTO_AES_CTR.
+//! \param bEncrypt is \b true to encrypt or \b false to decrypt.  It is
+//! ignored in CTR mode, where both are the same operation.
+//! \param pui8IV is a pointer to the 16-byte initialization vector for CBC
+//! mode or the initial big-endian counter block for CTR mode.  It is not
+//! used in ECB mode and may be \b NULL.
+//! \param pui8Src is a pointer to the input data.
+//! \param pui8Dest is a pointer to the output buffer; it may be the same as
+//! \e pui8Src.
+//! \param ui32Length is the number of bytes to process, which must be a
+//! multiple of 16.
+//!
+//! On return \e pui8IV holds the chaining value for the next call, so a long
+//! message can be processed in several pieces.
+//!
+//! The request is sent to the AES module when the device has one and the
+//! source and destination buffers are word aligned.  Otherwise the
+//! table-driven software implementation is used.  The hardware path polls the
+//! AES module and must not be used from more than one context at a time.
+//!
+//! \return Returns \b true if the data was processed or \b false if the mode
+//! or length is not valid.
+//
+//*****************************************************************************
+bool
+CryptoAESProcess(tCryptoAESContext *psContext, uint32_t ui32Mode,
+                 bool bEncrypt, uint8_t *pui8IV, const uint8_t *pui8Src,
+                 uint8_t *pui8Dest, uint32_t ui32Length)
+{
+    uint32_t pui32IV[CRYPTO_AES_BLOCK_SIZE / 4], ui32Idx, ui32Config;
+    uint8_t pui8Block[CRYPTO_AES_BLOCK_SIZE];
+
+    //
+    // Check the arguments.
+    //
+    if(((ui32Mode != CRYPTO_AES_ECB) && (ui32Mode != CRYPTO_AES_CBC) &&
+        (ui32Mode != CRYPTO_AES_CTR)) ||
+       ((ui32Length % CRYPTO_AES_BLOCK_SIZE) != 0))
+    {
+        return(false);
+    }
+    if(ui32Length == 0)
+    {
+        return(true);
+    }
+
+    //
+    // CTR mode only ever uses the forward cipher.
+    //
+    if(ui32Mode == CRYPTO_AES_CTR)
+    {
+        bEncrypt = true;
+    }
+
+    //
+    // Use the AES module if it is present and can read the buffers.
+    //
+    if(g_bCryptoHardware && CRYPTO_ALIGNED(pui8Src) &&
+       CRYPTO_ALIGNED(pui8Dest))
+    {
+        //
+        // For in-place CBC decryption, the last ciphertext block is the next
+        // IV and must be saved before it is overwritten.
+        //
+        if((ui32Mode == CRYPTO_AES_CBC) && !bEncrypt)
+        {
+            CryptoCopy(pui8Block,
+                       pui8Src + ui32Length - CRYPTO_AES_BLOCK_SIZE,
+                       CRYPTO_AES_BLOCK_SIZE);
+        }
+
+        //
+        // Configure the module and run the data through it.
+        //
+        ui32Config = ((bEncrypt ? AES_CFG_DIR_ENCRYPT : AES_CFG_DIR_DECRYPT) |
+                      CryptoAESKeySize(psContext->ui32KeyBits) | ui32Mode);
+        if(ui32Mode == CRYPTO_AES_CTR)
+        {
+            ui32Config |= AES_CFG_CTR_WIDTH_128;
+        }
+        MAP_AESReset(AES_BASE);
+        MAP_AESConfigSet(AES_BASE, ui32Config);
+        MAP_AESKey1Set(AES_BASE, psContext->pui32Key,
+                       CryptoAESKeySize(psContext->ui32KeyBits));
+        if(ui32Mode != CRYPTO_AES_ECB)
+        {
+            CryptoCopy((uint8_t *)pui32IV, pui8IV, CRYPTO_AES_BLOCK_SIZE);
+            MAP_AESIVSet(AES_BASE, pui32IV);
+        }
+        MAP_AESDataProcess(AES_BASE, (uint32_t *)pui8Src,
+                           (uint32_t *)pui8Dest, ui32Length);
+
+        //
+        // Update the chaining value for the next call.
+        //
+        if(ui32Mode == CRYPTO_AES_CBC)
+        {
+            CryptoCopy(pui8IV,
+                       (bEncrypt ?
+                        (pui8Dest + ui32Length - CRYPTO_AES_BLOCK_SIZE) :
+                        pui8Block), CRYPTO_AES_BLOCK_SIZE);
+        }
+        else if(ui32Mode == CRYPTO_AES_CTR)
+        {
+            CryptoCounterAdd(pui8IV, ui32Length / CRYPTO_AES_BLOCK_SIZE);
+        }
+
+        return(true);
+    }
+
+    //
+    // Otherwise process the data a block at a time in software.
+    //
+    for(; ui32Length; ui32Length -= CRYPTO_AES_BLOCK_SIZE)
+    {
+        if(ui32Mode == CRYPTO_AES_ECB)
+        {
+            if(bEncrypt)
+            {
+                SWAESEncryptBlock(&psContext->sSoftware, pui8Src, pui8Dest);
+            }
+            else
+            {
+                SWAESDecryptBlock(&psContext->sSoftware, pui8Src, pui8Dest);
+            }
+        }
+        else if(ui32Mode == CRYPTO_AES_CTR)
+        {
+            //
+            // Encrypt the counter to produce the key stream for this block.
+            //
+            SWAESEncryptBlock(&psContext->sSoftware, pui8IV, pui8Block);
+            for(ui32Idx = 0; ui32Idx < CRYPTO_AES_BLOCK_SIZE; ui32Idx++)
+            {
+                pui8Dest[ui32Idx] = pui8Src[ui32Idx] ^ pui8Block[ui32Idx];
+            }
+            CryptoCounterAdd(pui8IV, 1);
+        }
+        else if(bEncrypt)
+        {
+            //
+            // Chain the previous ciphertext block into this one.
+            //
+            for(ui32Idx = 0; ui32Idx < CRYPTO_AES_BLOCK_SIZE; ui32Idx++)
+            {
+                pui8Block[ui32Idx] = pui8Src[ui32Idx] ^ pui8IV[ui32Idx];
+            }
+            SWAESEncryptBlock(&psContext->sSoftware, pui8Block, pui8Dest);
+            CryptoCopy(pui8IV, pui8Dest, CRYPTO_AES_BLOCK_SIZE);
+        }
+        else
+        {
+            //
+            // Save the ciphertext block as the next IV before decrypting it,
+            // since the output may overwrite it.
+            //
+            CryptoCopy(pui8Block, pui8Src, CRYPTO_AES_BLOCK_SIZE);
+            SWAESDecryptBlock(&psContext->sSoftware, pui8Src, pui8Dest);
+            for(ui32Idx = 0; ui32Idx < CRYPTO_AES_BLOCK_SIZE; ui32Idx++)
+            {
+                pui8Dest[ui32Idx] ^= pui8IV[ui32Idx];
+            }
+            CryptoCopy(pui8IV, pui8Block, CRYPTO_AES_BLOCK_SIZE);
+        }
+
+        pui8Src += CRYPTO_AES_BLOCK_SIZE;
+        pui8Dest += CRYPTO_AES_BLOCK_SIZE;
+    }
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Computes the hash of a message.
+//!
+//! \param ui32Algo is the hash algorithm; one of \b SHAMD5_ALGO_MD5,
+//! \b SHAMD5_ALGO_SHA1, \b SHAMD5_ALGO_SHA224 or \b SHAMD5_ALGO_SHA256.
+//! \param pui8Data is a pointer to the message.
+//! \param ui32Length is the length of the message in bytes.
+//! \param pui8Digest is a pointer to the buffer that receives the digest,
+//! which must be large enough for the selected algorithm.
+//!
+//! The request is sent to the SHA/MD5 module when the device has one and the
+//! message is word aligned.  Otherwise the unrolled software implementation
+//! is used.  Messages that arrive in pieces should be hashed with
+//! CryptoHashInit(), CryptoHashUpdate() and CryptoHashFinal() instead of
+//! being gathered into one buffer first.
+//!
+//! \return Returns \b true if the digest was computed or \b false if the
+//! algorithm is not available.
+//
+//*****************************************************************************
+bool
+CryptoHash(uint32_t ui32Algo, const uint8_t *pui8Data, uint32_t ui32Length,
+           uint8_t *pui8Digest)
+{
+    tSWSHAMD5Context sContext;
+    uint32_t pui32Result[SW_SHAMD5_DIGEST_MAX / 4];
+
+    //
+    // Use the SHA/MD5 module if it is present and can read the message.  An
+    // empty message is always hashed in software since the module needs at
+    // least one word of input to start.
+    //
+    if(g_bCryptoHardware && CRYPTO_ALIGNED(pui8Data) && ui32Length)
+    {
+        MAP_SHAMD5Reset(SHAMD5_BASE);
+        MAP_SHAMD5ConfigSet(SHAMD5_BASE, ui32Algo);
+        MAP_SHAMD5DataProcess(SHAMD5_BASE, (uint32_t *)pui8Data, ui32Length,
+                              pui32Result);
+
+        //
+        // The module returns the digest in byte order.
+        //
+        CryptoCopy(pui8Digest, (uint8_t *)pui32Result,
+                   ((ui32Algo == SHAMD5_ALGO_MD5) ? 16 :
+                    (ui32Algo == SHAMD5_ALGO_SHA1) ? 20 :
+                    (ui32Algo == SHAMD5_ALGO_SHA224) ? 28 : 32));
+        return(true);
+    }
+
+    //
+    // Otherwise compute the hash in software.
+    //
+    if(!SWSHAMD5Init(&sContext, ui32Algo))
+    {
+        return(false);
+    }
+    SWSHAMD5Update(&sContext, pui8Data, ui32Length);
+    SWSHAMD5Final(&sContext, pui8Digest);
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Starts an incremental hash computation.
+//!
+//! \param psContext is a pointer to the hash context to initialize.
+//! \param ui32Algo is the hash algorithm; one of \b SHAMD5_ALGO_MD5,
+//! \b SHAMD5_ALGO_SHA1, \b SHAMD5_ALGO_SHA224 or \b SHAMD5_ALGO_SHA256.
+//!
+//! This function starts a hash that is fed with CryptoHashUpdate() as the
+//! data becomes available, for example as each block of a firmware image is
+//! received, and completed with CryptoHashFinal().  Any number of contexts
+//! may be in use at once.
+//!
+//! Incremental hashes always use the software implementation, since the
+//! SHA/MD5 module driver needs the whole message in a single request.
+//!
+//! \return Returns \b true if the context was initialized or \b false if
+//! the algorithm is not supported.
+//
+//*****************************************************************************
+bool
+CryptoHashInit(tCryptoHashContext *psContext, uint32_t ui32Algo)
+{
+    psContext->bHMAC = false;
+    return(SWSHAMD5Init(&psContext->sInner, ui32Algo));
+}
+
+//*****************************************************************************
+//
+//! Starts an incremental HMAC computation.
+//!
+//! \param psContext is a pointer to the hash context to initialize.
+//! \param ui32Algo is the underlying hash algorithm; one of
+//! \b SHAMD5_ALGO_MD5, \b SHAMD5_ALGO_SHA1, \b SHAMD5_ALGO_SHA224 or
+//! \b SHAMD5_ALGO_SHA256.
+//! \param pui8Key is a pointer to the HMAC key.
+//! \param ui32KeyLength is the length of the key in bytes.  Keys longer than
+//! the 64-byte block size are hashed first, as RFC 2104 requires.
+//!
+//! This function starts an HMAC that is fed with CryptoHashUpdate() and
+//! completed with CryptoHashFinal(), in the same way as a plain hash.  Both
+//! padded keys are absorbed here, so the key is not kept in the context.
+//!
+//! \return Returns \b true if the context was initialized or \b false if
+//! the algorithm is not supported.
+//
+//*****************************************************************************
+bool
+CryptoHMACInit(tCryptoHashContext *psContext, uint32_t ui32Algo,
+               const uint8_t *pui8Key, uint32_t ui32KeyLength)
+{
+    uint8_t pui8Pad[SW_SHAMD5_BLOCK_SIZE];
+    uint32_t ui32Idx;
+
+    //
+    // Start both hashes, which also validates the algorithm.
+    //
+    if(!SWSHAMD5Init(&psContext->sInner, ui32Algo) ||
+       !SWSHAMD5Init(&psContext->sOuter, ui32Algo))
+    {
+        return(false);
+    }
+
+    //
+    // Reduce a long key to its digest, then zero pad it to the block size.
+    //
+    if(ui32KeyLength > SW_SHAMD5_BLOCK_SIZE)
+    {
+        SWSHAMD5Update(&psContext->sOuter, pui8Key, ui32KeyLength);
+        SWSHAMD5Final(&psContext->sOuter, pui8Pad);
+        ui32KeyLength = SWSHAMD5DigestSizeGet(ui32Algo);
+        SWSHAMD5Init(&psContext->sOuter, ui32Algo);
+    }
+    else
+    {
+        CryptoCopy(pui8Pad, pui8Key, ui32KeyLength);
+    }
+    for(ui32Idx = ui32KeyLength; ui32Idx < SW_SHAMD5_BLOCK_SIZE; ui32Idx++)
+    {
+        pui8Pad[ui32Idx] = 0;
+    }
+
+    //
+    // Absorb the inner padded key, then turn the pad into the outer padded
+    // key and absorb that.
+    //
+    for(ui32Idx = 0; ui32Idx < SW_SHAMD5_BLOCK_SIZE; ui32Idx++)
+    {
+        pui8Pad[ui32Idx] ^= 0x36;
+    }
+    SWSHAMD5Update(&psContext->sInner, pui8Pad, SW_SHAMD5_BLOCK_SIZE);
+    for(ui32Idx = 0; ui32Idx < SW_SHAMD5_BLOCK_SIZE; ui32Idx++)
+    {
+        pui8Pad[ui32Idx] ^= 0x36 ^ 0x5c;
+    }
+    SWSHAMD5Update(&psContext->sOuter, pui8Pad, SW_SHAMD5_BLOCK_SIZE);
+
+    //
+    // Do not leave key material on the stack.
+    //
+    for(ui32Idx = 0; ui32Idx < SW_SHAMD5_BLOCK_SIZE; ui32Idx++)
+    {
+        pui8Pad[ui32Idx] = 0;
+    }
+
+    psContext->bHMAC = true;
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Adds data to an incremental hash or HMAC computation.
+//!
+//! \param psContext is a pointer to a context set up by CryptoHashInit() or
+//! CryptoHMACInit().
+//! \param pui8Data is a pointer to the data, which need not be word aligned.
+//! \param ui32Length is the number of bytes of data.
+//!
+//! This function may be called any number of times with chunks of any size.
+//! Only the bytes that do not complete a 64-byte block are buffered; whole
+//! blocks are hashed directly from \e pui8Data.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+CryptoHashUpdate(tCryptoHashContext *psContext, const uint8_t *pui8Data,
+                 uint32_t ui32Length)
+{
+    SWSHAMD5Update(&psContext->sInner, pui8Data, ui32Length);
+}
+
+//*****************************************************************************
+//
+//! Completes an incremental hash or HMAC computation.
+//!
+//! \param psContext is a pointer to a context set up by CryptoHashInit() or
+//! CryptoHMACInit().
+//! \param pui8Digest is a pointer to the buffer that receives the digest or
+//! HMAC tag.  It must be large enough for the algorithm in use; 32 bytes is
+//! enough for any of them.
+//!
+//! The context must be initialized again before it is reused.
+//!
+//! \return Returns the number of bytes written to \e pui8Digest.
+//
+//*****************************************************************************
+uint32_t
+CryptoHashFinal(tCryptoHashContext *psContext, uint8_t *pui8Digest)
+{
+    uint8_t pui8Inner[SW_SHAMD5_DIGEST_MAX];
+    uint32_t ui32Size;
+
+    ui32Size = SWSHAMD5DigestSizeGet(psContext->sInner.ui32Algo);
+
+    //
+    // A plain hash is finished once the message has been padded.
+    //
+    if(!psContext->bHMAC)
+    {
+        SWSHAMD5Final(&psContext->sInner, pui8Digest);
+        return(ui32Size);
+    }
+
+    //
+    // For HMAC, hash the inner digest with the outer padded key.
+    //
+    SWSHAMD5Final(&psContext->sInner, pui8Inner);
+    SWSHAMD5Update(&psContext->sOuter, pui8Inner, ui32Size);
+    SWSHAMD5Final(&psContext->sOuter, pui8Digest);
+
+    return(ui32Size);
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -0,0 +1,163 @@
+//*****************************************************************************
+//
+// crypto.h - Prototypes for the hardware/software crypto dispatch layer.
+//
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Utility Library.
+//
+//*****************************************************************************
+//*****************************************************************************
+
+#ifndef __CRYPTO_H__
+#define __CRYPTO_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/sw_aes.h"
+#include "driverlib/sw_shamd5.h"
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+//! \addtogroup crypto_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! The AES block cipher modes supported by CryptoAESProcess().  These are the
+//! corresponding AES_CFG_MODE_* values from aes.h.
+//
+//*****************************************************************************
+#define CRYPTO_AES_ECB          0x00000000
+#define CRYPTO_AES_CBC          0x00000020
+#define CRYPTO_AES_CTR          0x00000040
+
+//*****************************************************************************
+//
+//! The size of an AES block, and therefore of the initialization vector or
+//! counter, in bytes.
+//
+//*****************************************************************************
+#define CRYPTO_AES_BLOCK_SIZE   16
+
+//*****************************************************************************
+//
+//! An AES key prepared by CryptoAESKeySet().  The members of this structure
+//! are private to the crypto module and must not be accessed by the
+//! application.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The expanded key used when the software implementation is selected.
+    //
+    tSWAESContext sSoftware;
+
+    //
+    // The raw key, loaded into the AES module for each request when the
+    // hardware is used.
+    //
+    uint32_t pui32Key[8];
+
+    //
+    // The key size in bits.
+    //
+    uint32_t ui32KeyBits;
+}
+tCryptoAESContext;
+
+//*****************************************************************************
+//
+//! The state of an incremental hash or HMAC computation started by
+//! CryptoHashInit() or CryptoHMACInit().  The members of this structure are
+//! private to the crypto module and must not be accessed by the application.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The hash of the message, preceded by the inner padded key for HMAC.
+    //
+    tSWSHAMD5Context sInner;
+
+    //
+    // For HMAC, the hash state after the outer padded key has been absorbed.
+    //
+    tSWSHAMD5Context sOuter;
+
+    //
+    // True if this context computes an HMAC rather than a plain hash.
+    //
+    bool bHMAC;
+}
+tCryptoHashContext;
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Prototypes for the APIs.
+//
+//*****************************************************************************
+extern void CryptoInit(void);
+extern bool CryptoHardwarePresent(void);
+extern bool CryptoAESKeySet(tCryptoAESContext *psContext,
+                            const uint8_t *pui8Key, uint32_t ui32KeyBits);
+extern bool CryptoAESProcess(tCryptoAESContext *psContext, uint32_t ui32Mode,
+                             bool bEncrypt, uint8_t *pui8IV,
+                             const uint8_t *pui8Src, uint8_t *pui8Dest,
+                             uint32_t ui32Length);
+extern bool CryptoHash(uint32_t ui32Algo, const uint8_t *pui8Data,
+                       uint32_t ui32Length, uint8_t *pui8Digest);
+extern bool CryptoHashInit(tCryptoHashContext *psContext, uint32_t ui32Algo);
+extern bool CryptoHMACInit(tCryptoHashContext *psContext, uint32_t ui32Algo,
+                           const uint8_t *pui8Key, uint32_t ui32KeyLength);
+extern void CryptoHashUpdate(tCryptoHashContext *psContext,
+                             const uint8_t *pui8Data, uint32_t ui32Length);
+extern uint32_t CryptoHashFinal(tCryptoHashContext *psContext,
+                                uint8_t *pui8Digest);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __CRYPTO_H__
@@ -0,0 +1,441 @@
+//*****************************************************************************
+//
+// flash_stream.c - Double-buffered streaming writer for flash images.
+//
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Utility Library.
+//
+//*****************************************************************************
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "inc/hw_types.h"
+#include "driverlib/debug.h"
+#include "driverlib/flash.h"
+#include "driverlib/rom.h"
+#include "driverlib/rom_map.h"
+#include "driverlib/sw_crc.h"
+#include "driverlib/sysctl.h"
+#include "utils/flash_stream.h"
+
+//*****************************************************************************
+//
+//! \addtogroup flash_stream_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! Prepares to stream an image into a region of flash.
+//!
+//! \param psStream is a pointer to the stream state structure.
+//! \param ui32Start is the address of the first byte of the flash region to be
+//! written.  This must be the start of an erase block in the flash.
+//! \param ui32End is the address of the first byte after the end of the flash
+//! region to be written.
+//!
+//! This function initializes a stream which programs data into flash as it
+//! arrives, for example from the pfnPutData callback of a TFTP PUT request.
+//! Incoming data is copied into one of two RAM buffers by FlashStreamWrite()
+//! while the other buffer is programmed into flash by FlashStreamService().
+//! Sectors are erased ahead of the programming cursor so that neither erase
+//! nor program time has to be paid before a network acknowledgment can be
+//! sent, allowing the update rate to be bound by the network rather than by
+//! the flash.  A CRC-32 of the data is computed as it is written.
+//!
+//! No flash is erased by this function; sectors are erased on demand as the
+//! stream advances.  Any flash error status left by an earlier operation is
+//! cleared.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+FlashStreamInit(tFlashStream *psStream, uint32_t ui32Start, uint32_t ui32End)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psStream);
+    ASSERT(ui32End > ui32Start);
+
+    //
+    // Clear the stream state.
+    //
+    memset(psStream, 0, sizeof(tFlashStream));
+
+    //
+    // Discard any error left behind by an earlier flash operation, since
+    // FlashStreamService() treats a latched error as a failure of this stream.
+    //
+    MAP_FlashIntClear(FLASH_INT_ACCESS | FLASH_INT_VOLTAGE_ERR |
+                      FLASH_INT_DATA_ERR | FLASH_INT_ERASE_ERR |
+                      FLASH_INT_PROGRAM_ERR);
+
+    //
+    // Save the region to be written.
+    //
+    psStream->ui32SectorSize = MAP_SysCtlFlashSectorSizeGet();
+    ASSERT(!(ui32Start & (psStream->ui32SectorSize - 1)));
+    psStream->ui32Start = ui32Start;
+    psStream->ui32End = ui32End;
+    psStream->ui32EraseAddr = ui32Start;
+    psStream->ui32ProgAddr = ui32Start;
+
+    //
+    // Start the running CRC.
+    //
+    psStream->ui32Crc = 0xFFFFFFFF;
+}
+
+//*****************************************************************************
+//
+//! Advances any pending flash erase and program operations.
+//!
+//! \param psStream is a pointer to the stream state structure.
+//!
+//! This function starts the next flash operation required by the stream if
+//! the flash controller is idle.  It never waits for an operation to complete
+//! so may be called from the application's main loop or from a periodic timer
+//! to keep the flash busy while data is being received.  Sectors are erased
+//! no more than FLASH_STREAM_ERASE_AHEAD bytes ahead of the data which has
+//! been programmed.
+//!
+//! \return Returns \b true if the stream still has work to do and \b false
+//! once all buffered data has been programmed.
+//
+//*****************************************************************************
+bool
+FlashStreamService(tFlashStream *psStream)
+{
+    uint32_t ui32Prog, ui32Count, ui32Limit;
+
+    //
+    // Nothing can be started while the flash controller is busy.
+    //
+    if(FlashBusy())
+    {
+        return(true);
+    }
+
+    //
+    // Check the result of the previous operation.  If anything has gone
+    // wrong, abandon the stream.
+    //
+    if(FlashOperationStatus() != 0)
+    {
+        psStream->i32Status = -1;
+    }
+    if(psStream->i32Status != 0)
+    {
+        psStream->bProgPending = false;
+        return(false);
+    }
+
+    //
+    // Work out where the data in the pending buffer ends, or where the
+    // cursor will be once it has been programmed.
+    //
+    ui32Prog = psStream->ui32Fill ^ 1;
+    ui32Limit = psStream->ui32ProgAddr;
+    if(psStream->bProgPending)
+    {
+        ui32Limit += (psStream->pui32Count[ui32Prog] -
+                      psStream->ui32ProgOffset);
+    }
+
+    //
+    // If the pending data reaches into a sector which has not been erased,
+    // erase that sector first.
+    //
+    if(psStream->bProgPending && (psStream->ui32EraseAddr < ui32Limit))
+    {
+        FlashEraseNonBlocking(psStream->ui32EraseAddr);
+        psStream->ui32EraseAddr += psStream->ui32SectorSize;
+        return(true);
+    }
+
+    //
+    // Program the next write-buffer-sized chunk of the pending data.
+    //
+    if(psStream->bProgPending)
+    {
+        ui32Count = FlashProgramNonBlocking(
+                        psStream->pui32Buffer[ui32Prog] +
+                        (psStream->ui32ProgOffset / 4),
+                        psStream->ui32ProgAddr,
+                        psStream->pui32Count[ui32Prog] -
+                        psStream->ui32ProgOffset);
+        psStream->ui32ProgAddr += ui32Count;
+        psStream->ui32ProgOffset += ui32Count;
+
+        //
+        // Release the buffer once all of it has been handed to the flash
+        // controller.
+        //
+        if(psStream->ui32ProgOffset == psStream->pui32Count[ui32Prog])
+        {
+            psStream->bProgPending = false;
+            psStream->ui32ProgOffset = 0;
+            psStream->pui32Count[ui32Prog] = 0;
+        }
+        return(true);
+    }
+
+    //
+    // With nothing to program, use the idle time to erase ahead of the
+    // cursor so that the next buffer can be programmed straight away.
+    //
+    if((psStream->ui32EraseAddr < psStream->ui32End) &&
+       (psStream->ui32EraseAddr <
+        (psStream->ui32ProgAddr + FLASH_STREAM_ERASE_AHEAD)))
+    {
+        FlashEraseNonBlocking(psStream->ui32EraseAddr);
+        psStream->ui32EraseAddr += psStream->ui32SectorSize;
+        return(true);
+    }
+
+    return(false);
+}
+
+//*****************************************************************************
+//
+// Hands the buffer currently being filled to the programming side of the
+// stream, waiting for the previous buffer to be programmed if necessary.
+//
+//*****************************************************************************
+static void
+FlashStreamSwap(tFlashStream *psStream)
+{
+    //
+    // Wait for the other buffer to become free.
+    //
+    while(psStream->bProgPending)
+    {
+        FlashStreamService(psStream);
+    }
+
+    //
+    // Swap the buffers and start programming the newly filled one.
+    //
+    psStream->bProgPending = true;
+    psStream->ui32ProgOffset = 0;
+    psStream->ui32Fill ^= 1;
+    psStream->pui32Count[psStream->ui32Fill] = 0;
+    FlashStreamService(psStream);
+}
+
+//*****************************************************************************
+//
+//! Writes data to a flash stream.
+//!
+//! \param psStream is a pointer to the stream state structure.
+//! \param pui8Data is a pointer to the data to be written.
+//! \param ui32Count is the number of bytes to be written.
+//!
+//! This function appends data to the stream.  The data is copied into the
+//! current staging buffer and included in the running CRC; when the buffer
+//! fills, it is handed over to be programmed into flash and the other buffer
+//! becomes the staging buffer.  This function only waits for the flash if
+//! both buffers are full, which happens only if data arrives faster than it
+//! can be programmed.  There are no alignment requirements on the data.
+//!
+//! \return Returns 0 on success or -1 if the data does not fit in the flash
+//! region or a previous erase or program operation failed.
+//
+//*****************************************************************************
+int32_t
+FlashStreamWrite(tFlashStream *psStream, const uint8_t *pui8Data,
+                 uint32_t ui32Count)
+{
+    uint32_t ui32Space, ui32Copy;
+    uint8_t *pui8Buffer;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psStream);
+    ASSERT(pui8Data || !ui32Count);
+
+    //
+    // Refuse data once the stream has failed or if it would overrun the
+    // region.
+    //
+    if((psStream->i32Status != 0) ||
+       (ui32Count > ((psStream->ui32End - psStream->ui32Start) -
+                     psStream->ui32Length)))
+    {
+        psStream->i32Status = -1;
+        return(-1);
+    }
+
+    //
+    // There is nothing to do for an empty write.  Crc32() must not be called
+    // with a zero count since it does not handle one for unaligned data.
+    //
+    if(ui32Count == 0)
+    {
+        return(psStream->i32Status);
+    }
+
+    //
+    // Update the running CRC and length.
+    //
+    psStream->ui32Crc = Crc32(psStream->ui32Crc, pui8Data, ui32Count);
+    psStream->ui32Length += ui32Count;
+
+    //
+    // Copy the data into the staging buffers.
+    //
+    while(ui32Count)
+    {
+        //
+        // Copy as much as fits into the current buffer.
+        //
+        pui8Buffer = (uint8_t *)psStream->pui32Buffer[psStream->ui32Fill];
+        ui32Space = FLASH_STREAM_BUFFER_SIZE -
+                    psStream->pui32Count[psStream->ui32Fill];
+        ui32Copy = (ui32Count < ui32Space) ? ui32Count : ui32Space;
+        memcpy(pui8Buffer + psStream->pui32Count[psStream->ui32Fill],
+               pui8Data, ui32Copy);
+        psStream->pui32Count[psStream->ui32Fill] += ui32Copy;
+        pui8Data += ui32Copy;
+        ui32Count -= ui32Copy;
+
+        //
+        // If the buffer is full, start programming it.
+        //
+        if(psStream->pui32Count[psStream->ui32Fill] ==
+           FLASH_STREAM_BUFFER_SIZE)
+        {
+            FlashStreamSwap(psStream);
+        }
+    }
+
+    //
+    // Keep the flash busy with whatever work is outstanding.
+    //
+    FlashStreamService(psStream);
+
+    return(psStream->i32Status);
+}
+
+//*****************************************************************************
+//
+//! Completes a flash stream.
+//!
+//! \param psStream is a pointer to the stream state structure.
+//!
+//! This function programs any data remaining in the staging buffers into
+//! flash and waits for all flash operations to complete.  If the total length
+//! of the stream is not a multiple of four bytes, the final word is padded
+//! with 0xFF bytes.
+//!
+//! \return Returns 0 if the whole stream was written successfully or -1 if an
+//! erase or program error occurred.
+//
+//*****************************************************************************
+int32_t
+FlashStreamFlush(tFlashStream *psStream)
+{
+    uint8_t *pui8Buffer;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psStream);
+
+    //
+    // Pad the last partial word in the staging buffer, if any, and hand the
+    // buffer over to be programmed.
+    //
+    if(psStream->pui32Count[psStream->ui32Fill])
+    {
+        pui8Buffer = (uint8_t *)psStream->pui32Buffer[psStream->ui32Fill];
+        while(psStream->pui32Count[psStream->ui32Fill] & 3)
+        {
+            pui8Buffer[psStream->pui32Count[psStream->ui32Fill]++] = 0xFF;
+        }
+        FlashStreamSwap(psStream);
+    }
+
+    //
+    // Wait until everything has been programmed.  Note that
+    // FlashStreamService() goes idle once there is no more data to program
+    // and the erase-ahead window has been erased.
+    //
+    while(psStream->bProgPending || FlashBusy())
+    {
+        FlashStreamService(psStream);
+    }
+
+    //
+    // Pick up the status of the final operation.
+    //
+    if(FlashOperationStatus() != 0)
+    {
+        psStream->i32Status = -1;
+    }
+
+    return(psStream->i32Status);
+}
+
+//*****************************************************************************
+//
+//! Returns the CRC-32 of the data written to a flash stream.
+//!
+//! \param psStream is a pointer to the stream state structure.
+//!
+//! This function returns the CRC-32 (as computed by Crc32()) of all data
+//! passed to FlashStreamWrite() so far, excluding any padding added by
+//! FlashStreamFlush().  It may be called at any time.
+//!
+//! \return Returns the CRC-32 of the stream data.
+//
+//*****************************************************************************
+uint32_t
+FlashStreamCRCGet(tFlashStream *psStream)
+{
+    return(psStream->ui32Crc ^ 0xFFFFFFFF);
+}
+
+//*****************************************************************************
+//
+//! Returns the number of bytes written to a flash stream.
+//!
+//! \param psStream is a pointer to the stream state structure.
+//!
+//! \return Returns the number of bytes passed to FlashStreamWrite() so far.
+//
+//*****************************************************************************
+uint32_t
+FlashStreamLengthGet(tFlashStream *psStream)
+{
+    return(psStream->ui32Length);
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -0,0 +1,181 @@
+//*****************************************************************************
+//
+// flash_stream.h - Prototypes for the streaming flash image writer.
+//
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Utility Library.
+//
+//*****************************************************************************
+//*****************************************************************************
+
+#ifndef __FLASH_STREAM_H__
+#define __FLASH_STREAM_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+//! \addtogroup flash_stream_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! The size, in bytes, of each of the two buffers used to stage incoming data
+//! before it is programmed into flash.  This must be a multiple of 4 and is
+//! most efficient as a multiple of the 128 byte flash write buffer size.
+//! Applications may override this by defining the label before including this
+//! header.
+//
+//*****************************************************************************
+#ifndef FLASH_STREAM_BUFFER_SIZE
+#define FLASH_STREAM_BUFFER_SIZE 1024
+#endif
+
+//*****************************************************************************
+//
+//! The number of bytes ahead of the programming cursor which are erased in
+//! advance of the data arriving.  Erasing ahead allows sector erase time to
+//! overlap with data reception rather than delaying the first program
+//! operation in each sector.
+//
+//*****************************************************************************
+#ifndef FLASH_STREAM_ERASE_AHEAD
+#define FLASH_STREAM_ERASE_AHEAD (2 * FLASH_STREAM_BUFFER_SIZE)
+#endif
+
+//*****************************************************************************
+//
+//! The state of a streaming flash write.  The members of this structure are
+//! private to the flash stream module and must not be accessed by the
+//! application.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The first and one-past-last addresses of the flash region which is
+    // being written.
+    //
+    uint32_t ui32Start;
+    uint32_t ui32End;
+
+    //
+    // The erase sector size of the flash.
+    //
+    uint32_t ui32SectorSize;
+
+    //
+    // The address of the next sector to be erased.  All sectors below this
+    // address within the region have been erased.
+    //
+    uint32_t ui32EraseAddr;
+
+    //
+    // The address at which the next word will be programmed.
+    //
+    uint32_t ui32ProgAddr;
+
+    //
+    // The staging buffers.  One is filled with incoming data while the other
+    // is programmed into flash.
+    //
+    uint32_t pui32Buffer[2][FLASH_STREAM_BUFFER_SIZE / 4];
+
+    //
+    // The number of bytes held in each of the staging buffers.
+    //
+    uint32_t pui32Count[2];
+
+    //
+    // The index of the buffer currently being filled.
+    //
+    uint32_t ui32Fill;
+
+    //
+    // The number of bytes of the other buffer that have been handed to the
+    // flash controller, or 0 if that buffer is not waiting to be programmed.
+    //
+    uint32_t ui32ProgOffset;
+
+    //
+    // Indicates that the buffer not being filled holds data waiting to be
+    // programmed.
+    //
+    bool bProgPending;
+
+    //
+    // The running CRC-32 of all data written to the stream.
+    //
+    uint32_t ui32Crc;
+
+    //
+    // The total number of bytes written to the stream.
+    //
+    uint32_t ui32Length;
+
+    //
+    // Zero if all operations have succeeded so far or -1 if an erase or
+    // program error occurred or the region was overrun.
+    //
+    int32_t i32Status;
+}
+tFlashStream;
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Prototypes for the streaming flash writer functions.
+//
+//*****************************************************************************
+extern void FlashStreamInit(tFlashStream *psStream, uint32_t ui32Start,
+                            uint32_t ui32End);
+extern int32_t FlashStreamWrite(tFlashStream *psStream,
+                                const uint8_t *pui8Data, uint32_t ui32Count);
+extern bool FlashStreamService(tFlashStream *psStream);
+extern int32_t FlashStreamFlush(tFlashStream *psStream);
+extern uint32_t FlashStreamCRCGet(tFlashStream *psStream);
+extern uint32_t FlashStreamLengthGet(tFlashStream *psStream);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __FLASH_STREAM_H__
@@ -180,6 +180,22 @@ extern void lwIPHostTimerHandler(void);
 //*****************************************************************************
 #define LINK_TMR_INTERVAL       10
 
+//*****************************************************************************
+//
+// The default receive interrupt moderation settings.  When the poll budget is
+// non-zero, a receive interrupt masks further receive interrupts and the
+// descriptor ring is polled until it stays empty or the budget of polling
+// passes is used up.  The watchdog value is passed to
+// EMACRxWatchdogTimerSet().
+//
+//*****************************************************************************
+#ifndef EMAC_RX_POLL_BUDGET
+#define EMAC_RX_POLL_BUDGET     0
+#endif
+#ifndef EMAC_RX_WATCHDOG
+#define EMAC_RX_WATCHDOG        0
+#endif
+
 //*****************************************************************************
 //
 // Set the PHY configuration to the default (internal) option if necessary.
@@ -373,6 +389,37 @@ static uint32_t g_ui32NetMask;
 //*****************************************************************************
 static uint32_t g_ui32GWAddr;
 
+//*****************************************************************************
+//
+// The maximum number of receive polling passes made per Ethernet interrupt,
+// or zero if receive interrupt moderation is disabled.
+//
+//*****************************************************************************
+#if NO_SYS
+static uint32_t g_ui32RxPollBudget = EMAC_RX_POLL_BUDGET;
+#endif
+
+//*****************************************************************************
+//
+// A flag indicating that the receive descriptor ring is being polled with the
+// receive interrupt masked.
+//
+//*****************************************************************************
+#if NO_SYS
+static volatile bool g_bRxPolling = false;
+#endif
+
+//*****************************************************************************
+//
+// The number of receive interrupts taken and receive polling passes made,
+// used to tune the moderation settings.
+//
+//*****************************************************************************
+#if NO_SYS
+static uint32_t g_ui32RxInterrupts = 0;
+static uint32_t g_ui32RxPolls = 0;
+#endif
+
 //*****************************************************************************
 //
 // The stack size for the interrupt task.
@@ -430,6 +477,60 @@ lwIPInterruptTask(void *pvArg)
 }
 #endif
 
+//*****************************************************************************
+//
+// This function polls the receive descriptor ring with the receive interrupt
+// masked, returning true if frames are still arriving when the budget is used
+// up.  In that case the receive interrupt is left masked and the caller must
+// arrange for polling to continue.
+//
+//*****************************************************************************
+#if NO_SYS
+static bool
+lwIPRxPoll(uint32_t ui32Status)
+{
+    uint32_t ui32Pass;
+
+    //
+    // Mask the receive interrupt while the ring is being polled.
+    //
+    MAP_EMACIntDisable(EMAC0_BASE, EMAC_INT_RECEIVE);
+
+    for(ui32Pass = 1; ; ui32Pass++)
+    {
+        //
+        // Process the frames in the ring, along with any other sources that
+        // were reported on the first pass.
+        //
+        tivaif_interrupt(&g_sNetIF, ui32Status);
+        g_ui32RxPolls++;
+
+        //
+        // Stop polling once no more frames have arrived.  Any frame that
+        // arrives after this check sets the raw status, so the interrupt
+        // fires as soon as it is unmasked.
+        //
+        if(!(MAP_EMACIntStatus(EMAC0_BASE, false) & EMAC_INT_RECEIVE))
+        {
+            MAP_EMACIntEnable(EMAC0_BASE, EMAC_INT_RECEIVE);
+            return(false);
+        }
+
+        //
+        // Frames are still arriving, so give up the processor if the budget
+        // has been used.
+        //
+        if(ui32Pass >= g_ui32RxPollBudget)
+        {
+            return(true);
+        }
+
+        MAP_EMACIntClear(EMAC0_BASE, EMAC_INT_RECEIVE);
+        ui32Status = EMAC_INT_RECEIVE;
+    }
+}
+#endif
+
 //*****************************************************************************
 //
 // This function performs a periodic check of the link status and responds
@@ -905,6 +1006,11 @@ lwIPInit(uint32_t ui32SysClkHz, const uint8_t *pui8MAC, uint32_t ui32IPAddr,
     g_ui32NetMask = ui32NetMask;
     g_ui32GWAddr = ui32GWAddr;
 
+    //
+    // Set the receive interrupt watchdog.
+    //
+    MAP_EMACRxWatchdogTimerSet(EMAC0_BASE, EMAC_RX_WATCHDOG);
+
     //
     // Initialize lwIP.  The remainder of initialization is done immediately if
     // not using a RTOS and it is deferred to the TCP/IP thread's context if
@@ -1016,6 +1122,17 @@ lwIPEthernetIntHandler(void)
     //
     ui32Status = MAP_EMACIntStatus(EMAC0_BASE, true);
 
+    //
+    // If the receive ring is being polled, the receive interrupt is masked
+    // so its status must be added back in.
+    //
+#if NO_SYS
+    if(g_bRxPolling)
+    {
+        ui32Status |= EMAC_INT_RECEIVE;
+    }
+#endif
+
     //
     // If the interrupt really came from the Ethernet and not our
     // timer, clear it.
@@ -1049,11 +1166,45 @@ lwIPEthernetIntHandler(void)
     //
 #if NO_SYS
     //
-    // No RTOS is being used.  If a transmit/receive interrupt was active,
-    // run the low-level interrupt handler.
+    // No RTOS is being used.  If receive interrupt moderation is enabled and
+    // a receive interrupt was active, poll the receive ring.  If frames are
+    // still arriving when the poll budget runs out, leave the receive
+    // interrupt masked and pend this handler to continue polling once any
+    // other pending interrupts have been serviced.
     //
-    if(ui32Status)
+    if((ui32Status & EMAC_INT_RECEIVE) && g_ui32RxPollBudget)
     {
+        if(!g_bRxPolling)
+        {
+            g_ui32RxInterrupts++;
+        }
+        g_bRxPolling = lwIPRxPoll(ui32Status);
+        if(g_bRxPolling)
+        {
+            HWREG(NVIC_SW_TRIG) |= INT_EMAC0 - 16;
+        }
+    }
+
+    //
+    // Otherwise, if a transmit/receive interrupt was active, run the low-level
+    // interrupt handler.
+    //
+    else if(ui32Status)
+    {
+        //
+        // Unmask the receive interrupt if moderation was disabled while the
+        // ring was being polled.
+        //
+        if(g_bRxPolling)
+        {
+            g_bRxPolling = false;
+            MAP_EMACIntEnable(EMAC0_BASE, EMAC_INT_RECEIVE);
+        }
+        if(ui32Status & EMAC_INT_RECEIVE)
+        {
+            g_ui32RxInterrupts++;
+            g_ui32RxPolls++;
+        }
         tivaif_interrupt(&g_sNetIF, ui32Status);
     }
 
@@ -1089,6 +1240,75 @@ lwIPEthernetIntHandler(void)
 #endif
 }
 
+//*****************************************************************************
+//
+//! Configures receive interrupt moderation.
+//!
+//! \param ui32Budget is the maximum number of passes over the receive
+//! descriptor ring made for each receive interrupt, or 0 to take an interrupt
+//! for every receive event.
+//! \param ui8Watchdog is the receive interrupt watchdog timeout, expressed as
+//! a number of 256 system clock periods, or 0 to disable the watchdog.
+//!
+//! When \e ui32Budget is non-zero, a receive interrupt masks further receive
+//! interrupts and the receive ring is polled until no new frames have arrived
+//! during a pass.  If frames are still arriving after \e ui32Budget passes,
+//! the receive interrupt stays masked and polling continues in the next pass
+//! of the Ethernet interrupt handler, which is pended by software so that
+//! other interrupts and the lwIP timers are serviced in between.  Under heavy
+//! load this replaces an interrupt per frame with one interrupt per burst, at
+//! the cost of up to one pass of extra latency for the first frame of a
+//! burst.
+//!
+//! \e ui8Watchdog is programmed with EMACRxWatchdogTimerSet().  It delays
+//! the receive interrupt for frames received into descriptors that have
+//! \b DES1_RX_CTRL_DISABLE_INT set, allowing further frames to accumulate
+//! before the first poll.
+//!
+//! Polling applies when lwIP is used without an RTOS.  With an RTOS, frames
+//! are already processed by the Ethernet interrupt task with the Ethernet
+//! interrupts masked.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+lwIPRxModerationSet(uint32_t ui32Budget, uint8_t ui8Watchdog)
+{
+#if NO_SYS
+    g_ui32RxPollBudget = ui32Budget;
+#endif
+    MAP_EMACRxWatchdogTimerSet(EMAC0_BASE, ui8Watchdog);
+}
+
+//*****************************************************************************
+//
+//! Returns receive interrupt moderation statistics.
+//!
+//! \param pui32Interrupts is a pointer to storage for the number of receive
+//! interrupts taken.
+//! \param pui32Polls is a pointer to storage for the number of passes made
+//! over the receive descriptor ring.
+//!
+//! This function returns counts that can be compared with the number of
+//! frames received to tune lwIPRxModerationSet().  Both counts are zero when
+//! lwIP is used with an RTOS.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+lwIPRxModerationStatsGet(uint32_t *pui32Interrupts, uint32_t *pui32Polls)
+{
+#if NO_SYS
+    *pui32Interrupts = g_ui32RxInterrupts;
+    *pui32Polls = g_ui32RxPolls;
+#else
+    *pui32Interrupts = 0;
+    *pui32Polls = 0;
+#endif
+}
+
 //*****************************************************************************
 //
 //! Returns the IP address for this interface.
@@ -101,6 +101,9 @@ extern void lwIPInit(uint32_t ui32SysClkHz, const uint8_t *pui8Mac,
 extern void lwIPTimerCallbackRegister(tHardwareTimerHandler pfnTimerFunc);
 extern void lwIPTimer(uint32_t ui32TimeMS);
 extern void lwIPEthernetIntHandler(void);
+extern void lwIPRxModerationSet(uint32_t ui32Budget, uint8_t ui8Watchdog);
+extern void lwIPRxModerationStatsGet(uint32_t *pui32Interrupts,
+                                     uint32_t *pui32Polls);
 extern uint32_t lwIPLocalIPAddrGet(void);
 extern uint32_t lwIPLocalNetMaskGet(void);
 extern uint32_t lwIPLocalGWAddrGet(void);
@@ -28,6 +28,8 @@
 //
 //*****************************************************************************
 #include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
 
 //*****************************************************************************
 //
@@ -35,6 +37,12 @@
 //
 //*****************************************************************************
 #include "utils/ptpdlib.h"
+#include "utils/uartstdio.h"
+#include "utils/ustdlib.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/emac.h"
+#include "driverlib/rom.h"
+#include "driverlib/rom_map.h"
 
 //*****************************************************************************
 //
@@ -54,3 +62,514 @@
 #include "ptpd-1.1.0/src/dep-tiva/ptpd_servo.c"
 #include "ptpd-1.1.0/src/dep-tiva/ptpd_msg.c"
 #include "ptpd-1.1.0/src/dep-tiva/ptpd_net.c"
+
+//*****************************************************************************
+//
+// The default PI servo gains, in parts per billion of frequency correction
+// per nanosecond of offset, in 16.16 fixed-point format.  These suit a Sync
+// interval of one second.
+//
+//*****************************************************************************
+#ifndef PTP_SERVO_KP
+#define PTP_SERVO_KP            0x0000b333      // 0.7
+#endif
+#ifndef PTP_SERVO_KI
+#define PTP_SERVO_KI            0x00004ccd      // 0.3
+#endif
+
+//*****************************************************************************
+//
+// The largest frequency correction that the servo applies, in parts per
+// billion.
+//
+//*****************************************************************************
+#ifndef PTP_SERVO_MAX_PPB
+#define PTP_SERVO_MAX_PPB       500000
+#endif
+
+//*****************************************************************************
+//
+// The default outlier rejection settings.  A measurement is rejected if it
+// exceeds both the minimum limit and the given multiple of the recent mean
+// deviation, unless the maximum number of consecutive measurements has
+// already been rejected, in which case the clock is assumed to have stepped.
+//
+//*****************************************************************************
+#ifndef PTP_SERVO_OUTLIER_MIN_NS
+#define PTP_SERVO_OUTLIER_MIN_NS                                              \
+                                1000
+#endif
+#ifndef PTP_SERVO_OUTLIER_FACTOR
+#define PTP_SERVO_OUTLIER_FACTOR                                              \
+                                4
+#endif
+#ifndef PTP_SERVO_OUTLIER_MAX_REJECTS
+#define PTP_SERVO_OUTLIER_MAX_REJECTS                                         \
+                                3
+#endif
+
+//*****************************************************************************
+//
+// The state of the PI servo.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The addend value that gives the nominal clock rate.
+    //
+    uint32_t ui32Addend;
+
+    //
+    // The proportional and integral gains, in 16.16 fixed-point format.
+    //
+    int32_t i32Kp;
+    int32_t i32Ki;
+
+    //
+    // The integral term, in parts per billion in 16.16 fixed-point format.
+    //
+    int64_t i64Integral;
+
+    //
+    // The frequency correction currently applied, in parts per billion.
+    //
+    int32_t i32FreqPPB;
+
+    //
+    // The filtered one-way path delay in nanoseconds, or -1 if no delay has
+    // been measured yet.
+    //
+    int32_t i32Delay;
+
+    //
+    // The mean absolute deviation of accepted offsets and delays, in 28.4
+    // fixed-point nanoseconds.
+    //
+    uint32_t ui32OffsetSpread;
+    uint32_t ui32DelaySpread;
+
+    //
+    // The number of consecutive offsets and delays that have been rejected.
+    //
+    uint32_t ui32OffsetRejects;
+    uint32_t ui32DelayRejects;
+
+    //
+    // The outlier rejection settings.
+    //
+    uint32_t ui32MinLimit;
+    uint32_t ui32Factor;
+    uint32_t ui32MaxRejects;
+
+    //
+    // The ring of recent samples and the index where the next is written.
+    //
+    tPTPServoSample psStats[PTP_SERVO_STATS_SIZE];
+    uint32_t ui32StatsIndex;
+    uint32_t ui32StatsCount;
+}
+tPTPServo;
+
+static tPTPServo g_sPTPServo;
+
+//*****************************************************************************
+//
+// Decides whether a measurement is an outlier, given its deviation from the
+// expected value, and updates the mean deviation and rejection count.
+// Returns true if the measurement should be used.
+//
+//*****************************************************************************
+static bool
+PTPServoAccept(uint32_t ui32Deviation, uint32_t *pui32Spread,
+               uint32_t *pui32Rejects)
+{
+    uint32_t ui32Limit;
+
+    //
+    // Limit the contribution of a single large value to the mean deviation.
+    //
+    if(ui32Deviation > 0x07ffffff)
+    {
+        ui32Deviation = 0x07ffffff;
+    }
+
+    //
+    // The first measurement seeds the mean deviation.
+    //
+    if(*pui32Spread == 0)
+    {
+        *pui32Spread = (ui32Deviation << 4) | 1;
+        return(true);
+    }
+
+    //
+    // Reject a measurement that is well outside the recent spread, but only a
+    // limited number of times in a row so that a genuine step is followed.
+    //
+    ui32Limit = (*pui32Spread >> 4) * g_sPTPServo.ui32Factor;
+    if(ui32Limit < g_sPTPServo.ui32MinLimit)
+    {
+        ui32Limit = g_sPTPServo.ui32MinLimit;
+    }
+    if((ui32Deviation > ui32Limit) &&
+       (*pui32Rejects < g_sPTPServo.ui32MaxRejects))
+    {
+        (*pui32Rejects)++;
+        return(false);
+    }
+    *pui32Rejects = 0;
+
+    //
+    // Track the mean deviation with a time constant of eight measurements.
+    //
+    *pui32Spread += (int32_t)((ui32Deviation << 4) - *pui32Spread) >> 3;
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Records a sample in the statistics ring.  The delay is the measurement for
+// a delay sample and the filtered delay for an offset sample.
+//
+//*****************************************************************************
+static void
+PTPServoRecord(int32_t i32Offset, int32_t i32Delay, uint8_t ui8Flags)
+{
+    tPTPServoSample *psSample;
+
+    psSample = &g_sPTPServo.psStats[g_sPTPServo.ui32StatsIndex];
+    psSample->i32OffsetNs = i32Offset;
+    psSample->i32DelayNs = i32Delay;
+    psSample->i32FreqPPB = g_sPTPServo.i32FreqPPB;
+    psSample->ui8Flags = ui8Flags;
+
+    g_sPTPServo.ui32StatsIndex = ((g_sPTPServo.ui32StatsIndex + 1) %
+                                  PTP_SERVO_STATS_SIZE);
+    if(g_sPTPServo.ui32StatsCount < PTP_SERVO_STATS_SIZE)
+    {
+        g_sPTPServo.ui32StatsCount++;
+    }
+}
+
+//*****************************************************************************
+//
+//! Initializes the PI servo.
+//!
+//! \param ui32Addend is the IEEE-1588 timer addend value that gives the
+//! nominal clock rate, as programmed with EMACTimestampAddendSet().
+//!
+//! This function resets the servo to its default gains and outlier rejection
+//! settings and clears its statistics.  The servo disciplines the IEEE-1588
+//! timer of the Ethernet MAC in fine update mode by adjusting the addend
+//! value around \e ui32Addend.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+PTPServoInit(uint32_t ui32Addend)
+{
+    g_sPTPServo.ui32Addend = ui32Addend;
+    g_sPTPServo.i32Kp = PTP_SERVO_KP;
+    g_sPTPServo.i32Ki = PTP_SERVO_KI;
+    g_sPTPServo.i64Integral = 0;
+    g_sPTPServo.i32FreqPPB = 0;
+    g_sPTPServo.i32Delay = -1;
+    g_sPTPServo.ui32OffsetSpread = 0;
+    g_sPTPServo.ui32DelaySpread = 0;
+    g_sPTPServo.ui32OffsetRejects = 0;
+    g_sPTPServo.ui32DelayRejects = 0;
+    g_sPTPServo.ui32MinLimit = PTP_SERVO_OUTLIER_MIN_NS;
+    g_sPTPServo.ui32Factor = PTP_SERVO_OUTLIER_FACTOR;
+    g_sPTPServo.ui32MaxRejects = PTP_SERVO_OUTLIER_MAX_REJECTS;
+    g_sPTPServo.ui32StatsIndex = 0;
+    g_sPTPServo.ui32StatsCount = 0;
+}
+
+//*****************************************************************************
+//
+//! Sets the PI servo gains.
+//!
+//! \param i32Kp is the proportional gain.
+//! \param i32Ki is the integral gain.
+//!
+//! Both gains are expressed as parts per billion of frequency correction per
+//! nanosecond of offset, in 16.16 fixed-point format, and are applied once per
+//! offset measurement.  Larger gains converge faster but pass more of the
+//! measurement noise through to the clock.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+PTPServoGainsSet(int32_t i32Kp, int32_t i32Ki)
+{
+    g_sPTPServo.i32Kp = i32Kp;
+    g_sPTPServo.i32Ki = i32Ki;
+}
+
+//*****************************************************************************
+//
+//! Sets the servo's outlier rejection parameters.
+//!
+//! \param ui32MinLimitNs is the deviation, in nanoseconds, below which a
+//! measurement is never rejected.
+//! \param ui32Factor is the multiple of the recent mean deviation above which
+//! a measurement is rejected.
+//! \param ui32MaxRejects is the maximum number of consecutive measurements
+//! that are rejected, or 0 to disable outlier rejection.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+PTPServoOutlierSet(uint32_t ui32MinLimitNs, uint32_t ui32Factor,
+                   uint32_t ui32MaxRejects)
+{
+    g_sPTPServo.ui32MinLimit = ui32MinLimitNs;
+    g_sPTPServo.ui32Factor = ui32Factor;
+    g_sPTPServo.ui32MaxRejects = ui32MaxRejects;
+}
+
+//*****************************************************************************
+//
+//! Passes a path delay measurement to the servo.
+//!
+//! \param i32DelayNs is the measured one-way path delay in nanoseconds,
+//! computed from the hardware timestamps of a Delay_Req exchange.
+//!
+//! This function filters the path delay, ignoring outliers such as those
+//! caused by queuing in a switch.
+//!
+//! \return Returns \b true if the measurement was used or \b false if it was
+//! rejected as an outlier.
+//
+//*****************************************************************************
+bool
+PTPServoDelayUpdate(int32_t i32DelayNs)
+{
+    int32_t i32Diff;
+
+    //
+    // The first measurement seeds the filter.
+    //
+    if(g_sPTPServo.i32Delay < 0)
+    {
+        g_sPTPServo.i32Delay = (i32DelayNs < 0) ? 0 : i32DelayNs;
+        PTPServoRecord(0, i32DelayNs, PTP_SERVO_SAMPLE_DELAY);
+        return(true);
+    }
+
+    //
+    // Check the measurement against the filtered delay.
+    //
+    i32Diff = i32DelayNs - g_sPTPServo.i32Delay;
+    if(!PTPServoAccept((i32Diff < 0) ? -i32Diff : i32Diff,
+                       &g_sPTPServo.ui32DelaySpread,
+                       &g_sPTPServo.ui32DelayRejects))
+    {
+        PTPServoRecord(0, i32DelayNs,
+                       PTP_SERVO_SAMPLE_DELAY | PTP_SERVO_SAMPLE_REJECT);
+        return(false);
+    }
+
+    //
+    // Filter the delay with a time constant of eight measurements.
+    //
+    g_sPTPServo.i32Delay += i32Diff / 8;
+    if(g_sPTPServo.i32Delay < 0)
+    {
+        g_sPTPServo.i32Delay = 0;
+    }
+    PTPServoRecord(0, i32DelayNs, PTP_SERVO_SAMPLE_DELAY);
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Passes an offset from master measurement to the servo.
+//!
+//! \param i32OffsetNs is the offset of the local clock from the master clock
+//! in nanoseconds, computed from the hardware timestamps of a Sync message
+//! and corrected for the path delay returned by PTPServoDelayGet().
+//!
+//! This function runs one iteration of the PI servo and programs the
+//! resulting frequency correction into the IEEE-1588 timer's addend register.
+//! Offsets larger than a few milliseconds should be removed by stepping the
+//! clock with EMACTimestampSysTimeUpdate() before the servo is used.
+//!
+//! \return Returns \b true if the measurement was used or \b false if it was
+//! rejected as an outlier.
+//
+//*****************************************************************************
+bool
+PTPServoOffsetUpdate(int32_t i32OffsetNs)
+{
+    int64_t i64Freq, i64Limit;
+
+    //
+    // Check the measurement against the expected offset of zero.
+    //
+    if(!PTPServoAccept((i32OffsetNs < 0) ? -i32OffsetNs : i32OffsetNs,
+                       &g_sPTPServo.ui32OffsetSpread,
+                       &g_sPTPServo.ui32OffsetRejects))
+    {
+        PTPServoRecord(i32OffsetNs, g_sPTPServo.i32Delay,
+                       PTP_SERVO_SAMPLE_OFFSET | PTP_SERVO_SAMPLE_REJECT);
+        return(false);
+    }
+
+    //
+    // Update the integral term, limiting it to the correction range so that
+    // it does not wind up while the clock is being pulled in.
+    //
+    i64Limit = (int64_t)PTP_SERVO_MAX_PPB << 16;
+    g_sPTPServo.i64Integral += (int64_t)g_sPTPServo.i32Ki * i32OffsetNs;
+    if(g_sPTPServo.i64Integral > i64Limit)
+    {
+        g_sPTPServo.i64Integral = i64Limit;
+    }
+    else if(g_sPTPServo.i64Integral < -i64Limit)
+    {
+        g_sPTPServo.i64Integral = -i64Limit;
+    }
+
+    //
+    // A positive offset means the local clock is ahead, so slow it down.
+    //
+    i64Freq = -(((int64_t)g_sPTPServo.i32Kp * i32OffsetNs) +
+                g_sPTPServo.i64Integral) >> 16;
+    if(i64Freq > PTP_SERVO_MAX_PPB)
+    {
+        i64Freq = PTP_SERVO_MAX_PPB;
+    }
+    else if(i64Freq < -PTP_SERVO_MAX_PPB)
+    {
+        i64Freq = -PTP_SERVO_MAX_PPB;
+    }
+    g_sPTPServo.i32FreqPPB = (int32_t)i64Freq;
+
+    //
+    // Scale the nominal addend by the frequency correction.
+    //
+    MAP_EMACTimestampAddendSet(EMAC0_BASE,
+                               (uint32_t)(g_sPTPServo.ui32Addend +
+                                          (((int64_t)g_sPTPServo.ui32Addend *
+                                            i64Freq) / 1000000000)));
+
+    PTPServoRecord(i32OffsetNs, g_sPTPServo.i32Delay, PTP_SERVO_SAMPLE_OFFSET);
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Returns the filtered path delay.
+//!
+//! \return Returns the filtered one-way path delay in nanoseconds, or -1 if
+//! no delay has been measured.
+//
+//*****************************************************************************
+int32_t
+PTPServoDelayGet(void)
+{
+    return(g_sPTPServo.i32Delay);
+}
+
+//*****************************************************************************
+//
+//! Returns a sample from the servo statistics ring.
+//!
+//! \param ui32Index is the age of the sample, where 0 is the most recent.
+//! \param psSample is a pointer to storage for the sample.
+//!
+//! \return Returns \b true if the sample exists or \b false if fewer than
+//! \e ui32Index + 1 samples have been recorded.
+//
+//*****************************************************************************
+bool
+PTPServoStatsGet(uint32_t ui32Index, tPTPServoSample *psSample)
+{
+    if(ui32Index >= g_sPTPServo.ui32StatsCount)
+    {
+        return(false);
+    }
+
+    *psSample = g_sPTPServo.psStats[(g_sPTPServo.ui32StatsIndex +
+                                     PTP_SERVO_STATS_SIZE - 1 - ui32Index) %
+                                    PTP_SERVO_STATS_SIZE];
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Prints the servo statistics ring.
+//!
+//! \param argc is the number of arguments.
+//! \param argv is the argument list.  An optional first argument gives the
+//! number of samples to print.
+//!
+//! This function is a command line handler, suitable for the application's
+//! \b g_psCmdTable, that prints the recent offset and path delay samples
+//! along with the frequency correction and a summary of the accepted offsets
+//! using UARTprintf().
+//!
+//! \return Returns 0.
+//
+//*****************************************************************************
+int
+CmdPTPServoStats(int argc, char *argv[])
+{
+    tPTPServoSample sSample;
+    uint32_t ui32Count, ui32Idx, ui32Accepted;
+    int32_t i32Min, i32Max;
+
+    ui32Count = PTP_SERVO_STATS_SIZE;
+    if(argc > 1)
+    {
+        ui32Count = ustrtoul(argv[1], 0, 0);
+    }
+
+    UARTprintf("   offset(ns)  delay(ns)  freq(ppb)\n");
+
+    i32Min = INT_MAX;
+    i32Max = INT_MIN;
+    ui32Accepted = 0;
+    for(ui32Idx = 0; (ui32Idx < ui32Count) &&
+                     PTPServoStatsGet(ui32Idx, &sSample); ui32Idx++)
+    {
+        if(sSample.ui8Flags & PTP_SERVO_SAMPLE_OFFSET)
+        {
+            UARTprintf("%12d %10d %10d%s\n", sSample.i32OffsetNs,
+                       sSample.i32DelayNs, sSample.i32FreqPPB,
+                       ((sSample.ui8Flags & PTP_SERVO_SAMPLE_REJECT) ?
+                        " rejected" : ""));
+            if(!(sSample.ui8Flags & PTP_SERVO_SAMPLE_REJECT))
+            {
+                i32Min = (sSample.i32OffsetNs < i32Min) ?
+                         sSample.i32OffsetNs : i32Min;
+                i32Max = (sSample.i32OffsetNs > i32Max) ?
+                         sSample.i32OffsetNs : i32Max;
+                ui32Accepted++;
+            }
+        }
+        else if(sSample.ui8Flags & PTP_SERVO_SAMPLE_DELAY)
+        {
+            UARTprintf("%12s %10d %10s delay%s\n", "", sSample.i32DelayNs, "",
+                       ((sSample.ui8Flags & PTP_SERVO_SAMPLE_REJECT) ?
+                        " rejected" : ""));
+        }
+    }
+
+    if(ui32Accepted)
+    {
+        UARTprintf("offset range %d..%d ns over %d samples\n", i32Min,
+                   i32Max, ui32Accepted);
+    }
+
+    return(0);
+}
@@ -43,6 +43,70 @@ extern "C"
 //*****************************************************************************
 #include "ptpd-1.1.0/src/ptpd.h"
 
+//*****************************************************************************
+//
+// The number of recent samples kept by the servo statistics ring.
+//
+//*****************************************************************************
+#ifndef PTP_SERVO_STATS_SIZE
+#define PTP_SERVO_STATS_SIZE    32
+#endif
+
+//*****************************************************************************
+//
+// Flags reported in the ui8Flags field of tPTPServoSample.
+//
+//*****************************************************************************
+#define PTP_SERVO_SAMPLE_OFFSET 0x01    // The offset was measured
+#define PTP_SERVO_SAMPLE_DELAY  0x02    // The path delay was measured
+#define PTP_SERVO_SAMPLE_REJECT 0x04    // The measurement was an outlier
+
+//*****************************************************************************
+//
+// A sample recorded in the servo statistics ring.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The measured offset from master in nanoseconds.
+    //
+    int32_t i32OffsetNs;
+
+    //
+    // The one-way path delay in nanoseconds: the measured delay for a path
+    // delay sample, or the filtered delay used for an offset sample.
+    //
+    int32_t i32DelayNs;
+
+    //
+    // The frequency correction applied after the measurement, in parts per
+    // billion.
+    //
+    int32_t i32FreqPPB;
+
+    //
+    // A combination of PTP_SERVO_SAMPLE_* flags describing the sample.
+    //
+    uint8_t ui8Flags;
+}
+tPTPServoSample;
+
+//*****************************************************************************
+//
+// Prototypes for the PI servo.
+//
+//*****************************************************************************
+extern void PTPServoInit(uint32_t ui32Addend);
+extern void PTPServoGainsSet(int32_t i32Kp, int32_t i32Ki);
+extern void PTPServoOutlierSet(uint32_t ui32MinLimitNs, uint32_t ui32Factor,
+                               uint32_t ui32MaxRejects);
+extern bool PTPServoDelayUpdate(int32_t i32DelayNs);
+extern bool PTPServoOffsetUpdate(int32_t i32OffsetNs);
+extern int32_t PTPServoDelayGet(void);
+extern bool PTPServoStatsGet(uint32_t ui32Index, tPTPServoSample *psSample);
+extern int CmdPTPServoStats(int argc, char *argv[]);
+
 //*****************************************************************************
 //
 // Mark the end of the C bindings section for C++ compilers.
@@ -3229,6 +3229,259 @@ SMBusMasterIntProcess(tSMBus *psSMBus)
     return(SMBUS_OK);
 }
 
+//*****************************************************************************
+//
+// Starts transfers from the transfer queue, beginning with the current one,
+// until one is successfully initiated or the end of the queue is reached.
+// Returns true if a transfer was initiated.
+//
+//*****************************************************************************
+static bool
+SMBusMasterQueueNext(tSMBus *psSMBus)
+{
+    tSMBusTransfer *psTransfer;
+    tSMBusStatus eStatus;
+
+    //
+    // Loop through the remaining transfers in the queue.
+    //
+    while(psSMBus->ui8TransferIndex < psSMBus->ui8TransferCount)
+    {
+        psTransfer = &(psSMBus->psTransferQueue[psSMBus->ui8TransferIndex]);
+
+        //
+        // Initiate this transfer using the corresponding protocol function.
+        //
+        switch(psTransfer->ui8Type)
+        {
+            case SMBUS_XFER_BYTE_WORD_READ:
+            {
+                eStatus = SMBusMasterByteWordRead(psSMBus,
+                                                  psTransfer->ui8TargetAddress,
+                                                  psTransfer->ui8Command,
+                                                  psTransfer->pui8Data,
+                                                  psTransfer->ui8Size);
+                break;
+            }
+
+            case SMBUS_XFER_BLOCK_READ:
+            {
+                eStatus = SMBusMasterBlockRead(psSMBus,
+                                               psTransfer->ui8TargetAddress,
+                                               psTransfer->ui8Command,
+                                               psTransfer->pui8Data);
+                break;
+            }
+
+            case SMBUS_XFER_BYTE_WORD_WRITE:
+            {
+                eStatus = SMBusMasterByteWordWrite(psSMBus,
+                                                   psTransfer->ui8TargetAddress,
+                                                   psTransfer->ui8Command,
+                                                   psTransfer->pui8Data,
+                                                   psTransfer->ui8Size);
+                break;
+            }
+
+            case SMBUS_XFER_BLOCK_WRITE:
+            {
+                eStatus = SMBusMasterBlockWrite(psSMBus,
+                                                psTransfer->ui8TargetAddress,
+                                                psTransfer->ui8Command,
+                                                psTransfer->pui8Data,
+                                                psTransfer->ui8Size);
+                break;
+            }
+
+            default:
+            {
+                eStatus = SMBUS_MASTER_ERROR;
+                break;
+            }
+        }
+
+        //
+        // The transfer is now under way, so wait for it to complete.
+        //
+        if(eStatus == SMBUS_OK)
+        {
+            psTransfer->eStatus = SMBUS_TRANSFER_IN_PROGRESS;
+            return(true);
+        }
+
+        //
+        // Otherwise, this transfer could not be started.  Record the reason
+        // and move on to the next one.
+        //
+        psTransfer->eStatus = eStatus;
+        psSMBus->ui8TransferIndex++;
+    }
+
+    //
+    // There are no more transfers in the queue.
+    //
+    psSMBus->psTransferQueue = 0;
+    return(false);
+}
+
+//*****************************************************************************
+//
+//! Initiates a list of master transfers to be performed back to back.
+//!
+//! \param psSMBus specifies the SMBus configuration structure.
+//! \param psTransfers is a pointer to the list of transfers.
+//! \param ui8Count is the number of transfers in the list.
+//!
+//! This function starts a sequence of master transfers, such as polling a set
+//! of registers from one or more devices.  Each transfer is performed using
+//! the same protocol as the corresponding SMBusMasterxxxx function.  As each
+//! transfer completes, SMBusMasterQueueIntProcess() records its result in the
+//! \e eStatus member of its tSMBusTransfer and starts the next transfer from
+//! within the interrupt handler, so that there is no gap on the bus waiting
+//! for the application to issue the next request.  A transfer that fails does
+//! not prevent the remaining transfers from being performed.
+//!
+//! The PEC setting (see SMBusPECEnable()) applies to all of the transfers.
+//! PEC is computed using the table-driven Crc8CCITT() function.
+//!
+//! The list of transfers must remain valid until
+//! SMBusMasterQueueIntProcess() returns \b SMBUS_TRANSFER_COMPLETE.
+//!
+//! \return Returns \b SMBUS_PERIPHERAL_BUSY if a list of transfers is already
+//! in progress, the status of the first transfer if none of the transfers
+//! could be initiated, or \b SMBUS_OK if the transfers have been initiated.
+//
+//*****************************************************************************
+tSMBusStatus
+SMBusMasterQueueStart(tSMBus *psSMBus, tSMBusTransfer *psTransfers,
+                      uint8_t ui8Count)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psTransfers);
+    ASSERT(ui8Count != 0);
+
+    //
+    // Make sure that a list of transfers is not already in progress.
+    //
+    if(psSMBus->psTransferQueue != 0)
+    {
+        return(SMBUS_PERIPHERAL_BUSY);
+    }
+
+    //
+    // Save the list of transfers.
+    //
+    psSMBus->psTransferQueue = psTransfers;
+    psSMBus->ui8TransferCount = ui8Count;
+    psSMBus->ui8TransferIndex = 0;
+
+    //
+    // Start the first transfer that can be started.  If none could be, return
+    // the reason that the first one failed.
+    //
+    if(!SMBusMasterQueueNext(psSMBus))
+    {
+        return(psTransfers[0].eStatus);
+    }
+
+    //
+    // Return to the caller.
+    //
+    return(SMBUS_OK);
+}
+
+//*****************************************************************************
+//
+//! Master ISR processing function for a list of SMBus transfers.
+//!
+//! \param psSMBus specifies the SMBus configuration structure.
+//!
+//! This function must be called in the application interrupt service routine
+//! (ISR) in place of SMBusMasterIntProcess() while a list of transfers started
+//! by SMBusMasterQueueStart() is in progress.  It processes the master
+//! interrupt and, when the current transfer has completed, records its result
+//! and starts the next transfer in the list.
+//!
+//! When there is no list of transfers in progress, this function behaves
+//! exactly like SMBusMasterIntProcess().
+//!
+//! \return Returns \b SMBUS_TRANSFER_COMPLETE when the last transfer in the
+//! list has completed, or \b SMBUS_OK if transfers are still in progress.
+//! The results of the individual transfers are found in their \e eStatus
+//! members.
+//
+//*****************************************************************************
+tSMBusStatus
+SMBusMasterQueueIntProcess(tSMBus *psSMBus)
+{
+    tSMBusTransfer *psTransfer;
+    tSMBusStatus eStatus;
+
+    //
+    // If there is no list of transfers in progress, simply process the
+    // interrupt.
+    //
+    if(psSMBus->psTransferQueue == 0)
+    {
+        return(SMBusMasterIntProcess(psSMBus));
+    }
+
+    //
+    // Process the interrupt for the current transfer.
+    //
+    psTransfer = &(psSMBus->psTransferQueue[psSMBus->ui8TransferIndex]);
+    eStatus = SMBusMasterIntProcess(psSMBus);
+
+    //
+    // Save the first error reported for this transfer.  A NACK produces an
+    // error on two consecutive interrupts, the second once the STOP has been
+    // sent.
+    //
+    if((eStatus != SMBUS_OK) &&
+       (psTransfer->eStatus == SMBUS_TRANSFER_IN_PROGRESS))
+    {
+        psTransfer->eStatus = eStatus;
+    }
+
+    //
+    // Nothing more to do if the current transfer is still in progress.
+    //
+    if(HWREGBITB(&psSMBus->ui16Flags, FLAG_TRANSFER_IN_PROGRESS))
+    {
+        return(SMBUS_OK);
+    }
+
+    //
+    // The current transfer has completed.  Record its result and, for reads,
+    // the number of bytes received.
+    //
+    if(psTransfer->eStatus == SMBUS_TRANSFER_IN_PROGRESS)
+    {
+        psTransfer->eStatus = SMBUS_OK;
+    }
+    if((psTransfer->ui8Type == SMBUS_XFER_BYTE_WORD_READ) ||
+       (psTransfer->ui8Type == SMBUS_XFER_BLOCK_READ))
+    {
+        psTransfer->ui8Size = psSMBus->ui8RxIndex;
+    }
+
+    //
+    // Start the next transfer in the list.
+    //
+    psSMBus->ui8TransferIndex++;
+    if(SMBusMasterQueueNext(psSMBus))
+    {
+        return(SMBUS_OK);
+    }
+
+    //
+    // All of the transfers in the list have completed.
+    //
+    return(SMBUS_TRANSFER_COMPLETE);
+}
+
 //*****************************************************************************
 //
 //! Enables the appropriate master interrupts for stack processing.
@@ -3394,6 +3647,9 @@ SMBusMasterInit(tSMBus *psSMBus, uint32_t ui32I2CBase,
     psSMBus->ui8TxIndex = 0;
     psSMBus->ui8RxSize = 0;
     psSMBus->ui8RxIndex = 0;
+    psSMBus->psTransferQueue = 0;
+    psSMBus->ui8TransferCount = 0;
+    psSMBus->ui8TransferIndex = 0;
 
     //
     // Enable and initialize the I2C master module Using the system clock.
@@ -266,6 +266,25 @@ typedef struct
     //! application to keep track of the ARP session.
     //
     uint16_t ui16Flags;
+
+    //
+    //! The list of transfers being performed by SMBusMasterQueueStart.  This
+    //! member should not be accessed or modified by the application.
+    //
+    struct tSMBusTransfer *psTransferQueue;
+
+    //
+    //! The number of transfers in psTransferQueue.  This member should not be
+    //! accessed or modified by the application.
+    //
+    uint8_t ui8TransferCount;
+
+    //
+    //! The index of the transfer in psTransferQueue that is currently being
+    //! performed.  This member should not be accessed or modified by the
+    //! application.
+    //
+    uint8_t ui8TransferIndex;
 }
 tSMBus;
 
@@ -303,6 +322,52 @@ typedef enum
 }
 tSMBusStatus;
 
+//*****************************************************************************
+//
+//! This structure describes one transfer in a list of transfers performed by
+//! SMBusMasterQueueStart().
+//
+//*****************************************************************************
+typedef struct tSMBusTransfer
+{
+    //
+    //! The type of the transfer, which is one of \b SMBUS_XFER_BYTE_WORD_READ,
+    //! \b SMBUS_XFER_BLOCK_READ, \b SMBUS_XFER_BYTE_WORD_WRITE, or
+    //! \b SMBUS_XFER_BLOCK_WRITE.
+    //
+    uint8_t ui8Type;
+
+    //
+    //! The slave address of the target device.
+    //
+    uint8_t ui8TargetAddress;
+
+    //
+    //! The command byte sent at the start of the transfer.
+    //
+    uint8_t ui8Command;
+
+    //
+    //! The number of bytes to transfer.  This is not used for block reads;
+    //! instead it is updated with the number of bytes received from the
+    //! slave once the transfer has completed.
+    //
+    uint8_t ui8Size;
+
+    //
+    //! The buffer from which data is sent or into which data is received.
+    //
+    uint8_t *pui8Data;
+
+    //
+    //! The result of the transfer.  This is \b SMBUS_TRANSFER_IN_PROGRESS
+    //! until the transfer has completed, after which it is \b SMBUS_OK or the
+    //! error returned by SMBusMasterIntProcess() for this transfer.
+    //
+    tSMBusStatus eStatus;
+}
+tSMBusTransfer;
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
@@ -310,6 +375,16 @@ tSMBusStatus;
 //
 //*****************************************************************************
 
+//*****************************************************************************
+//
+// Values for the ui8Type member of tSMBusTransfer.
+//
+//*****************************************************************************
+#define SMBUS_XFER_BYTE_WORD_READ           0
+#define SMBUS_XFER_BLOCK_READ               1
+#define SMBUS_XFER_BYTE_WORD_WRITE          2
+#define SMBUS_XFER_BLOCK_WRITE              3
+
 //*****************************************************************************
 //
 // ARP Commands
@@ -419,6 +494,10 @@ extern tSMBusStatus SMBusMasterARPNotifyMaster(tSMBus *psSMBus,
                                                uint8_t *pui8Data);
 extern tSMBusStatus SMBusMasterARPPrepareToARP(tSMBus *psSMBus);
 extern tSMBusStatus SMBusMasterIntProcess(tSMBus *psSMBus);
+extern tSMBusStatus SMBusMasterQueueStart(tSMBus *psSMBus,
+                                          tSMBusTransfer *psTransfers,
+                                          uint8_t ui8Count);
+extern tSMBusStatus SMBusMasterQueueIntProcess(tSMBus *psSMBus);
 extern void SMBusMasterIntEnable(tSMBus *psSMBus);
 extern void SMBusMasterInit(tSMBus *psSMBus, uint32_t ui32I2CBase,
                             uint32_t ui32SMBusClock);
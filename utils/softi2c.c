@@ -88,6 +88,154 @@
 #define SOFTI2C_FLAG_DATA_ACK   6
 #define SOFTI2C_FLAG_RECEIVE    7
 
+//*****************************************************************************
+//
+// Issues the command to transfer the given byte of the current transaction.
+//
+//*****************************************************************************
+static void
+SoftI2CTransferByte(tSoftI2C *psI2C, uint32_t ui32Idx)
+{
+    tSoftI2CTransfer *psTransfer;
+    uint32_t ui32Cmd;
+
+    //
+    // Every byte requires a data phase.
+    //
+    psTransfer = psI2C->psTransfer;
+    ui32Cmd = SOFTI2C_CMD_BURST_SEND_CONT;
+
+    //
+    // The first byte of each phase of the transaction is preceded by a start
+    // (or repeated-start) and the slave address.
+    //
+    if((ui32Idx == 0) || (ui32Idx == psTransfer->ui32WriteCount))
+    {
+        ui32Cmd |= 1 << SOFTI2C_FLAG_START;
+        psI2C->ui8SlaveAddr = psTransfer->ui8SlaveAddr;
+        HWREGBITB(&(psI2C->ui8Flags), SOFTI2C_FLAG_RECEIVE) =
+            (ui32Idx == psTransfer->ui32WriteCount) ? 1 : 0;
+    }
+
+    //
+    // The last byte of the transaction is followed by a stop.  Otherwise,
+    // received bytes are ACKed so that the slave sends the next byte.
+    //
+    if(ui32Idx == (psTransfer->ui32WriteCount + psTransfer->ui32ReadCount - 1))
+    {
+        ui32Cmd |= 1 << SOFTI2C_FLAG_STOP;
+    }
+    else if(ui32Idx >= psTransfer->ui32WriteCount)
+    {
+        ui32Cmd |= 1 << SOFTI2C_FLAG_ACK;
+    }
+
+    //
+    // Get the byte to be written.
+    //
+    if(ui32Idx < psTransfer->ui32WriteCount)
+    {
+        psI2C->ui8Data = psTransfer->pui8WriteData[ui32Idx];
+    }
+
+    //
+    // Issue the command, which is started on the next tick.
+    //
+    psI2C->ui8Flags = (psI2C->ui8Flags & 0xf0) | ui32Cmd;
+}
+
+//*****************************************************************************
+//
+// Handles the completion of a command by the state machine.  When a
+// transaction is in progress, the next command of the transaction is issued
+// directly instead of asserting the SoftI2C ``interrupt''.
+//
+//*****************************************************************************
+static void
+SoftI2CCommandDone(tSoftI2C *psI2C)
+{
+    tSoftI2CTransfer *psTransfer;
+    uint32_t ui32Total;
+
+    //
+    // If there is no transaction in progress, set the SoftI2C ``interrupt''.
+    //
+    psTransfer = psI2C->psTransfer;
+    if(psTransfer == 0)
+    {
+        psI2C->ui8IntStatus = 1;
+        return;
+    }
+
+    //
+    // See if the command that completed transferred a byte (rather than
+    // being the stop that follows an error).
+    //
+    ui32Total = psTransfer->ui32WriteCount + psTransfer->ui32ReadCount;
+    if(psI2C->ui32TransferCount != ui32Total)
+    {
+        //
+        // Save the byte if it was read from the slave.
+        //
+        if(psI2C->ui32TransferCount >= psTransfer->ui32WriteCount)
+        {
+            psTransfer->pui8ReadData[psI2C->ui32TransferCount -
+                                     psTransfer->ui32WriteCount] =
+                psI2C->ui8Data;
+        }
+        psI2C->ui32TransferCount++;
+
+        //
+        // See if the slave failed to ACK the address or the data byte.
+        //
+        if(HWREGBITB(&(psI2C->ui8Flags), SOFTI2C_FLAG_ADDR_ACK) == 1)
+        {
+            psI2C->ui8TransferStatus = SOFTI2C_ERR_ADDR_ACK;
+        }
+        else if(HWREGBITB(&(psI2C->ui8Flags), SOFTI2C_FLAG_DATA_ACK) == 1)
+        {
+            psI2C->ui8TransferStatus = SOFTI2C_ERR_DATA_ACK;
+        }
+
+        //
+        // Abandon the rest of the transaction on an error, generating a stop
+        // unless the command that failed already included one.
+        //
+        if((psI2C->ui8TransferStatus != SOFTI2C_ERR_NONE) &&
+           (psI2C->ui32TransferCount != ui32Total))
+        {
+            psI2C->ui32TransferCount = ui32Total;
+            psI2C->ui8Flags = ((psI2C->ui8Flags & 0xf0) |
+                               SOFTI2C_CMD_BURST_SEND_ERROR_STOP);
+            return;
+        }
+
+        //
+        // Issue the command for the next byte, if there is one.
+        //
+        if(psI2C->ui32TransferCount != ui32Total)
+        {
+            SoftI2CTransferByte(psI2C, psI2C->ui32TransferCount);
+            return;
+        }
+    }
+
+    //
+    // The transaction has completed, so allow another to be started (which
+    // may be done by the callback).
+    //
+    psI2C->psTransfer = 0;
+
+    //
+    // Call the transaction's callback function, if it has one.
+    //
+    if(psTransfer->pfnCallback != 0)
+    {
+        psTransfer->pfnCallback(psTransfer->pvCallbackData,
+                                psI2C->ui8TransferStatus);
+    }
+}
+
 //*****************************************************************************
 //
 //! Performs the periodic update of the SoftI2C module.
@@ -518,10 +666,9 @@ SoftI2CTimerTick(tSoftI2C *psI2C)
                 else
                 {
                     //
-                    // Since the requested operations have completed, set the
-                    // SoftI2C ``interrupt''.
+                    // The requested operations have completed.
                     //
-                    psI2C->ui8IntStatus = 1;
+                    SoftI2CCommandDone(psI2C);
 
                     //
                     // Advance to the idle state.
@@ -655,10 +802,9 @@ SoftI2CTimerTick(tSoftI2C *psI2C)
                 else
                 {
                     //
-                    // Since the requested operations have completed, set the
-                    // SoftI2C ``interrupt''.
+                    // The requested operations have completed.
                     //
-                    psI2C->ui8IntStatus = 1;
+                    SoftI2CCommandDone(psI2C);
 
                     //
                     // Advance to the idle state.
@@ -792,10 +938,9 @@ SoftI2CTimerTick(tSoftI2C *psI2C)
                 else
                 {
                     //
-                    // Since the requested operations have completed, set the
-                    // SoftI2C ``interrupt''.
+                    // The requested operations have completed.
                     //
-                    psI2C->ui8IntStatus = 1;
+                    SoftI2CCommandDone(psI2C);
 
                     //
                     // Advance to the idle state.
@@ -853,10 +998,9 @@ SoftI2CTimerTick(tSoftI2C *psI2C)
             HWREGBITB(&(psI2C->ui8Flags), SOFTI2C_FLAG_STOP) = 0;
 
             //
-            // Since the requested operations have completed, set the SoftI2C
-            // ``interrupt''.
+            // The requested operations have completed.
             //
-            psI2C->ui8IntStatus = 1;
+            SoftI2CCommandDone(psI2C);
 
             //
             // Advance to the idle state.
@@ -942,6 +1086,11 @@ SoftI2CInit(tSoftI2C *psI2C)
     //
     psI2C->ui8Flags = 0;
 
+    //
+    // There is no transaction in progress at the start.
+    //
+    psI2C->psTransfer = 0;
+
     //
     // Start the SoftI2C state machine in the idle state.
     //
@@ -1166,7 +1315,8 @@ SoftI2CSlaveAddrSet(tSoftI2C *psI2C, uint8_t ui8SlaveAddr,
 //! \param psI2C specifies the SoftI2C data structure.
 //!
 //! This function returns an indication of whether or not the SoftI2C module is
-//! busy transmitting or receiving data.
+//! busy transmitting or receiving data.  The SoftI2C module is busy for the
+//! entire duration of a transaction started by SoftI2CTransfer().
 //!
 //! \return Returns \b true if the SoftI2C module is busy; otherwise, returns
 //! \b false.
@@ -1178,7 +1328,7 @@ SoftI2CBusy(tSoftI2C *psI2C)
     //
     // Return the busy status.
     //
-    if(psI2C->ui8State != SOFTI2C_STATE_IDLE)
+    if((psI2C->ui8State != SOFTI2C_STATE_IDLE) || (psI2C->psTransfer != 0))
     {
         return(true);
     }
@@ -1313,6 +1463,73 @@ SoftI2CDataGet(tSoftI2C *psI2C)
     return(psI2C->ui8Data);
 }
 
+//*****************************************************************************
+//
+//! Starts a multi-byte transaction on the SoftI2C module.
+//!
+//! \param psI2C specifies the SoftI2C data structure.
+//! \param psTransfer is the transaction to be performed.
+//!
+//! This function starts a complete I2C transaction which writes a block of
+//! bytes to a slave, reads a block of bytes from a slave, or writes and then
+//! reads (with a repeated start between the two phases), as is typically used
+//! to read a register or a FIFO from a sensor.  The individual bytes of the
+//! transaction are sequenced by SoftI2CTimerTick() itself, so the
+//! application is not involved until the whole transaction has completed.
+//!
+//! When the transaction has completed, the callback function in the
+//! transaction structure is called from within SoftI2CTimerTick() with the
+//! error status of the transaction.  If the slave does not ACK its address or
+//! a byte that is written to it, the transaction is abandoned and a stop
+//! condition is generated.  The callback may start another transaction.
+//!
+//! The SoftI2C ``interrupt'' is not asserted for the commands that make up
+//! the transaction, and SoftI2CControl() must not be used while a transaction
+//! is in progress.
+//!
+//! \return Returns \b true if the transaction was started or \b false if the
+//! SoftI2C module is busy.
+//
+//*****************************************************************************
+bool
+SoftI2CTransfer(tSoftI2C *psI2C, tSoftI2CTransfer *psTransfer)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psTransfer);
+    ASSERT(!(psTransfer->ui8SlaveAddr & 0x80));
+    ASSERT((psTransfer->ui32WriteCount + psTransfer->ui32ReadCount) != 0);
+    ASSERT((psTransfer->ui32WriteCount == 0) || psTransfer->pui8WriteData);
+    ASSERT((psTransfer->ui32ReadCount == 0) || psTransfer->pui8ReadData);
+
+    //
+    // Fail if a transaction or a command is already in progress.
+    //
+    if((psI2C->psTransfer != 0) || (psI2C->ui8State != SOFTI2C_STATE_IDLE) ||
+       ((psI2C->ui8Flags & 0x0f) != 0))
+    {
+        return(false);
+    }
+
+    //
+    // Save the transaction.
+    //
+    psI2C->psTransfer = psTransfer;
+    psI2C->ui32TransferCount = 0;
+    psI2C->ui8TransferStatus = SOFTI2C_ERR_NONE;
+
+    //
+    // Issue the command for the first byte.
+    //
+    SoftI2CTransferByte(psI2C, 0);
+
+    //
+    // Success.
+    //
+    return(true);
+}
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
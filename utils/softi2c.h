@@ -43,6 +43,58 @@ extern "C"
 //
 //*****************************************************************************
 
+//*****************************************************************************
+//
+//! This structure describes a transaction performed by SoftI2CTransfer().  Up
+//! to two phases are performed: a write of \e ui32WriteCount bytes followed,
+//! after a repeated start, by a read of \e ui32ReadCount bytes.  Either phase
+//! can be omitted by setting its count to zero.  The structure must remain
+//! valid until the transaction has completed.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The address of the slave device to be accessed.
+    //
+    uint8_t ui8SlaveAddr;
+
+    //
+    //! The bytes to be written to the slave.
+    //
+    const uint8_t *pui8WriteData;
+
+    //
+    //! The number of bytes to be written to the slave.
+    //
+    uint32_t ui32WriteCount;
+
+    //
+    //! The buffer into which the bytes read from the slave are stored.
+    //
+    uint8_t *pui8ReadData;
+
+    //
+    //! The number of bytes to be read from the slave.
+    //
+    uint32_t ui32ReadCount;
+
+    //
+    //! The function that is called when the transaction has completed.  The
+    //! second argument is the error status of the transaction, as one of
+    //! \b SOFTI2C_ERR_NONE, \b SOFTI2C_ERR_ADDR_ACK, or
+    //! \b SOFTI2C_ERR_DATA_ACK.  If this member is zero, no function is
+    //! called.
+    //
+    void (*pfnCallback)(void *pvCallbackData, uint32_t ui32Status);
+
+    //
+    //! The value that is passed to the callback function.
+    //
+    void *pvCallbackData;
+}
+tSoftI2CTransfer;
+
 //*****************************************************************************
 //
 //! This structure contains the state of a single instance of a SoftI2C module.
@@ -115,6 +167,26 @@ typedef struct
     //! should not be accessed or modified by the application.
     //
     uint8_t ui8IntStatus;
+
+    //
+    //! The error status of the transaction that is currently being performed.
+    //! This member should not be accessed or modified by the application.
+    //
+    uint8_t ui8TransferStatus;
+
+    //
+    //! The transaction that is currently being performed, or zero if the
+    //! SoftI2C module is being controlled with SoftI2CControl().  This member
+    //! should not be accessed or modified by the application.
+    //
+    tSoftI2CTransfer *psTransfer;
+
+    //
+    //! The number of bytes of the current transaction that have been
+    //! transferred.  This member should not be accessed or modified by the
+    //! application.
+    //
+    uint32_t ui32TransferCount;
 }
 tSoftI2C;
 
@@ -182,6 +254,7 @@ extern void SoftI2CSDAGPIOSet(tSoftI2C *psI2C, uint32_t ui32Base,
 extern void SoftI2CSlaveAddrSet(tSoftI2C *psI2C, uint8_t ui8SlaveAddr,
                                 bool bReceive);
 extern void SoftI2CTimerTick(tSoftI2C *psI2C);
+extern bool SoftI2CTransfer(tSoftI2C *psI2C, tSoftI2CTransfer *psTransfer);
 
 //*****************************************************************************
 //
@@ -32,6 +32,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "inc/hw_types.h"
+#include "driverlib/debug.h"
 #include "driverlib/gpio.h"
 #include "driverlib/rom.h"
 #include "driverlib/rom_map.h"
@@ -172,6 +173,12 @@ SoftSSIConfigSet(tSoftSSI *psSSI, uint8_t ui8Protocol,
     //
     psSSI->ui8IdleCount = 0;
 
+    //
+    // Abandon any transfer that was in progress.
+    //
+    psSSI->psTransfer = 0;
+    psSSI->ui8TransferWord = 0;
+
     //
     // Disable the SoftSSI module.
     //
@@ -271,6 +278,82 @@ SoftSSIRxInt(tSoftSSI *psSSI)
     }
 }
 
+//*****************************************************************************
+//
+// Determines if there is a word waiting to be transferred, either from the
+// current transfer or from the transmit FIFO.
+//
+//*****************************************************************************
+static bool
+SoftSSITxPending(tSoftSSI *psSSI)
+{
+    //
+    // A transfer takes priority over the transmit FIFO.
+    //
+    if(psSSI->psTransfer != 0)
+    {
+        return(psSSI->ui32TransferCount != psSSI->psTransfer->ui32Count);
+    }
+
+    //
+    // Otherwise, see if there is data in the transmit FIFO.
+    //
+    return(psSSI->ui16TxBufferRead != psSSI->ui16TxBufferWrite);
+}
+
+//*****************************************************************************
+//
+// Loads the next word to be transferred into the shift register.
+//
+//*****************************************************************************
+static void
+SoftSSITxLoad(tSoftSSI *psSSI)
+{
+    uint16_t ui16Data;
+
+    //
+    // Get the next word from the current transfer, if there is one, or from
+    // the transmit FIFO.  Where the word came from is remembered so that the
+    // received word is stored in the matching place, even if a transfer is
+    // started while a word from the transmit FIFO is being transferred.
+    //
+    if(psSSI->psTransfer != 0)
+    {
+        psSSI->ui8TransferWord = 1;
+
+        if(psSSI->psTransfer->pui16TxData != 0)
+        {
+            ui16Data =
+                psSSI->psTransfer->pui16TxData[psSSI->ui32TransferCount];
+        }
+        else
+        {
+            ui16Data = 0;
+        }
+    }
+    else
+    {
+        psSSI->ui8TransferWord = 0;
+
+        ui16Data = psSSI->pui16TxBuffer[psSSI->ui16TxBufferRead];
+    }
+
+    //
+    // Left-justify the word so that the MSB is shifted out first.
+    //
+    psSSI->ui16TxData = ui16Data << (16 - psSSI->ui8Bits);
+
+    //
+    // Initialize the receive buffer to zero.
+    //
+    psSSI->ui16RxData = 0;
+
+    //
+    // Initialize the count of bits tranferred.
+    //
+    psSSI->ui8CurrentBit = 0;
+}
+
 //*****************************************************************************
 //
 //! Performs the periodic update of the SoftSSI module.
@@ -291,6 +374,7 @@ SoftSSIRxInt(tSoftSSI *psSSI)
 void
 SoftSSITimerTick(tSoftSSI *psSSI)
 {
+    tSoftSSITransfer *psTransfer;
     uint16_t ui16Temp;
 
     //
@@ -308,7 +392,7 @@ SoftSSITimerTick(tSoftSSI *psSSI)
             // transmit FIFO.
             //
             if(((psSSI->ui8Flags & SOFTSSI_FLAG_ENABLE) != 0) &&
-               (psSSI->ui16TxBufferRead != psSSI->ui16TxBufferWrite))
+               SoftSSITxPending(psSSI))
             {
                 //
                 // Assert the Fss signal if it is configured.
@@ -360,21 +444,9 @@ SoftSSITimerTick(tSoftSSI *psSSI)
         case SOFTSSI_STATE_START:
         {
             //
-            // Get the next word to transfer from the transmit FIFO.
-            //
-            psSSI->ui16TxData =
-                (psSSI->pui16TxBuffer[psSSI->ui16TxBufferRead] <<
-                 (16 - psSSI->ui8Bits));
-
-            //
-            // Initialize the receive buffer to zero.
+            // Get the next word to transfer.
             //
-            psSSI->ui16RxData = 0;
-
-            //
-            // Initialize the count of bits tranferred.
-            //
-            psSSI->ui8CurrentBit = 0;
+            SoftSSITxLoad(psSSI);
 
             //
             // Write the first bit of the transmit word to the Tx pin.
@@ -441,6 +513,36 @@ SoftSSITimerTick(tSoftSSI *psSSI)
                 //
                 psSSI->ui8State = SOFTSSI_STATE_OUT;
             }
+
+            //
+            // Otherwise, see if a word of a transfer has been completed.
+            //
+            else if(psSSI->ui8TransferWord != 0)
+            {
+                //
+                // Store the received word into the transfer's receive buffer,
+                // if it has one.
+                //
+                if(psSSI->psTransfer->pui16RxData != 0)
+                {
+                    psSSI->psTransfer->pui16RxData[psSSI->ui32TransferCount] =
+                        psSSI->ui16RxData;
+                }
+
+                //
+                // The words of a transfer are sent back to back, with Fss
+                // held asserted, regardless of the SPI mode.
+                //
+                if(++psSSI->ui32TransferCount != psSSI->psTransfer->ui32Count)
+                {
+                    SoftSSITxLoad(psSSI);
+                    psSSI->ui8State = SOFTSSI_STATE_OUT;
+                }
+                else
+                {
+                    psSSI->ui8State = SOFTSSI_STATE_STOP1;
+                }
+            }
             else
             {
                 //
@@ -501,29 +603,19 @@ SoftSSITimerTick(tSoftSSI *psSSI)
                 //
                 // See if the next word should be transmitted immediately.
                 // This will occur when there is data in the transmit FIFO, the
-                // SoftSSI module is enabled, and the SoftSSI module is in SPI
-                // mode 1 or 3.
+                // SoftSSI module is enabled, the SoftSSI module is in SPI
+                // mode 1 or 3, and no transfer has been started in the
+                // meantime (which gets its own assertion of the Fss signal).
                 //
                 if(((psSSI->ui8Flags & SOFTSSI_FLAG_ENABLE) != 0) &&
                    ((psSSI->ui8Flags & SOFTSSI_FLAG_SPH) != 0) &&
+                   (psSSI->psTransfer == 0) &&
                    (psSSI->ui16TxBufferRead != psSSI->ui16TxBufferWrite))
                 {
                     //
                     // Get the next word to transfer from the transmit FIFO.
                     //
-                    psSSI->ui16TxData =
-                        (psSSI->pui16TxBuffer[psSSI->ui16TxBufferRead] <<
-                         (16 - psSSI->ui8Bits));
-
-                    //
-                    // Initialize the receive buffer to zero.
-                    //
-                    psSSI->ui16RxData = 0;
-
-                    //
-                    // Initialize the count of bits tranferred.
-                    //
-                    psSSI->ui8CurrentBit = 0;
+                    SoftSSITxLoad(psSSI);
 
                     //
                     // Move to the data output state.
@@ -630,9 +722,36 @@ SoftSSITimerTick(tSoftSSI *psSSI)
             psSSI->ui8IdleCount = 0;
 
             //
-            // See if the end of transfer "interrupt" should be generated.
+            // See if a transfer has just completed.  A transfer that was
+            // started while a word from the transmit FIFO was being
+            // transferred has not been started yet, and is picked up by the
+            // idle state.
+            //
+            if(psSSI->ui8TransferWord != 0)
+            {
+                psTransfer = psSSI->psTransfer;
+
+                //
+                // The transfer is complete, so allow the transmit FIFO to be
+                // used again (or another transfer to be started by the
+                // callback).
+                //
+                psSSI->psTransfer = 0;
+
+                //
+                // Call the transfer's callback function, if it has one.
+                //
+                if(psTransfer->pfnCallback != 0)
+                {
+                    psTransfer->pfnCallback(psTransfer->pvCallbackData);
+                }
+            }
+
+            //
+            // Otherwise, see if the end of transfer "interrupt" should be
+            // generated.
             //
-            if(psSSI->ui16TxBufferRead == psSSI->ui16TxBufferWrite)
+            else if(psSSI->ui16TxBufferRead == psSSI->ui16TxBufferWrite)
             {
                 psSSI->ui8IntStatus |= SOFTSSI_TXEOT;
             }
@@ -1076,8 +1195,7 @@ SoftSSIBusy(tSoftSSI *psSSI)
     //
     return(((psSSI->ui8State == SOFTSSI_STATE_IDLE) &&
             (((psSSI->ui8Flags & SOFTSSI_FLAG_ENABLE) == 0) ||
-             (psSSI->ui16TxBufferRead == psSSI->ui16TxBufferWrite))) ? false :
-           true);
+             !SoftSSITxPending(psSSI))) ? false : true);
 }
 
 //*****************************************************************************
@@ -1289,6 +1407,296 @@ SoftSSIRxBufferSet(tSoftSSI *psSSI, uint16_t *pui16RxBuffer,
     psSSI->ui16RxBufferWrite = 0;
 }
 
+//*****************************************************************************
+//
+//! Starts a multi-word transfer on a SoftSSI module.
+//!
+//! \param psSSI specifies the SoftSSI data structure.
+//! \param psTransfer is the transfer to be performed.
+//!
+//! This function starts a transfer of a block of words directly between
+//! caller-supplied buffers and the SoftSSI bus, bypassing the transmit and
+//! receive FIFOs.  This allows, for example, a sensor's data FIFO to be read
+//! with a single call instead of feeding the transmit FIFO and draining the
+//! receive FIFO from the ``interrupt'' callback.
+//!
+//! The Fss signal is asserted for the entire transfer and the words are
+//! transferred back to back in all SPI modes.  When the transfer has completed
+//! and the Fss signal has been deasserted, the callback function in the
+//! transfer structure is called from within SoftSSITimerTick().  The callback
+//! may start another transfer.
+//!
+//! The transfer starts on the next call to SoftSSITimerTick() once the
+//! SoftSSI module is idle and enabled; any data in the transmit FIFO is sent
+//! after the transfer has completed.  The \b SOFTSSI_TXEOT ``interrupt'' is
+//! not generated for the transfer.
+//!
+//! \return Returns \b true if the transfer was started or \b false if another
+//! transfer is already in progress.
+//
+//*****************************************************************************
+bool
+SoftSSITransfer(tSoftSSI *psSSI, tSoftSSITransfer *psTransfer)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psTransfer);
+    ASSERT(psTransfer->ui32Count != 0);
+
+    //
+    // Fail if there is already a transfer in progress.
+    //
+    if(psSSI->psTransfer != 0)
+    {
+        return(false);
+    }
+
+    //
+    // Save the transfer.  This can be done while a word from the transmit
+    // FIFO is being transferred since that word is marked as coming from the
+    // FIFO when it is loaded, and the transfer is then started once that word
+    // has been completed.
+    //
+    psSSI->ui32TransferCount = 0;
+    psSSI->psTransfer = psTransfer;
+
+    //
+    // Success.
+    //
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Gets the address to which a SoftSSI edge buffer is written.
+//!
+//! \param psSSI specifies the SoftSSI data structure.
+//!
+//! This function returns the address of the GPIO data register to which the
+//! entries of a buffer built by SoftSSIEdgeBufferBuild() must be written, one
+//! entry at twice the desired SoftSSI clock rate.  Typically this is done with
+//! a uDMA channel that is triggered by a timer, which allows the SoftSSI data
+//! to be clocked out with no processor involvement.  The address only changes
+//! the Fss, Clk, and Tx pins of the GPIO port.
+//!
+//! Edge buffers can only be used when the Fss (if used), Clk, and Tx pins are
+//! all on the same GPIO port.
+//!
+//! \return Returns the address of the GPIO data register, or zero if the pins
+//! are not all on the same GPIO port.
+//
+//*****************************************************************************
+uint32_t
+SoftSSIEdgeBufferAddrGet(tSoftSSI *psSSI)
+{
+    uint32_t ui32Base;
+
+    //
+    // Make sure that the pins are all on the same GPIO port.
+    //
+    ui32Base = psSSI->ui32ClkGPIO & 0xfffff000;
+    if(((psSSI->ui32TxGPIO & 0xfffff000) != ui32Base) ||
+       ((psSSI->ui32FssGPIO != 0) &&
+        ((psSSI->ui32FssGPIO & 0xfffff000) != ui32Base)))
+    {
+        return(0);
+    }
+
+    //
+    // Return the data register address that is masked to the three pins.
+    //
+    return(ui32Base | (psSSI->ui32ClkGPIO & 0x00000fff) |
+           (psSSI->ui32TxGPIO & 0x00000fff) |
+           (psSSI->ui32FssGPIO & 0x00000fff));
+}
+
+//*****************************************************************************
+//
+//! Builds a buffer of GPIO pin states for transmitting data from a SoftSSI
+//! module.
+//!
+//! \param psSSI specifies the SoftSSI data structure.
+//! \param pui16Data is a pointer to the words to be transmitted.
+//! \param ui32Count is the number of words to be transmitted.
+//! \param pui8Edges is a pointer to the buffer into which the pin states are
+//! written.
+//! \param ui32Size is the size of the \e pui8Edges buffer, in bytes.
+//!
+//! This function computes ahead of time the sequence of values that
+//! SoftSSITimerTick() would write to the Fss, Clk, and Tx pins while
+//! transferring the given words, using the current configuration of the
+//! SoftSSI module.  The words are transferred back to back with the Fss signal
+//! asserted throughout, as for SoftSSITransfer().  The resulting buffer can
+//! then be written to the address returned by SoftSSIEdgeBufferAddrGet() by
+//! the uDMA controller.
+//!
+//! The buffer requires (2 * \e ui32Count * bits-per-word) + 3 bytes.  The
+//! SoftSSI module itself must be idle and must not be ticked while the buffer
+//! is being played out.
+//!
+//! \return Returns the number of bytes written to \e pui8Edges, or zero if
+//! the buffer is too small or the pins are not on the same GPIO port.
+//
+//*****************************************************************************
+uint32_t
+SoftSSIEdgeBufferBuild(tSoftSSI *psSSI, const uint16_t *pui16Data,
+                       uint32_t ui32Count, uint8_t *pui8Edges,
+                       uint32_t ui32Size)
+{
+    uint32_t ui32Fss, ui32Clk, ui32Tx, ui32Value, ui32Idx, ui32Bit, ui32Data;
+    uint32_t ui32Len;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pui16Data);
+    ASSERT(pui8Edges);
+
+    //
+    // Make sure that the pins are on the same port and that the buffer is
+    // large enough.
+    //
+    ui32Len = (2 * ui32Count * psSSI->ui8Bits) + 3;
+    if((SoftSSIEdgeBufferAddrGet(psSSI) == 0) || (ui32Size < ui32Len))
+    {
+        return(0);
+    }
+
+    //
+    // Get the bit-packed representation of each pin.
+    //
+    ui32Fss = (psSSI->ui32FssGPIO & 0x000003fc) >> 2;
+    ui32Clk = (psSSI->ui32ClkGPIO & 0x000003fc) >> 2;
+    ui32Tx = (psSSI->ui32TxGPIO & 0x000003fc) >> 2;
+
+    //
+    // Start with the Clk signal in its idle state and the Tx pin low, then
+    // assert Fss.
+    //
+    ui32Value = (psSSI->ui8Flags & SOFTSSI_FLAG_SPO) ? ui32Clk : 0;
+    *pui8Edges++ = ui32Value;
+
+    //
+    // Loop through the words to be transferred.
+    //
+    for(ui32Idx = 0; ui32Idx < ui32Count; ui32Idx++)
+    {
+        //
+        // Left-justify the word so that the MSB is shifted out first.
+        //
+        ui32Data = pui16Data[ui32Idx] << (16 - psSSI->ui8Bits);
+
+        //
+        // Loop through the bits of this word.
+        //
+        for(ui32Bit = 0; ui32Bit < psSSI->ui8Bits; ui32Bit++)
+        {
+            //
+            // Write the next bit to the Tx pin.  For the first bit of the
+            // transfer, the Clk signal is only toggled in SPI mode 1 or 3; it
+            // is always toggled otherwise.
+            //
+            ui32Value = ((ui32Value & ~ui32Tx) |
+                         ((ui32Data & 0x8000) ? ui32Tx : 0));
+            if((ui32Idx != 0) || (ui32Bit != 0) ||
+               ((psSSI->ui8Flags & SOFTSSI_FLAG_SPH) != 0))
+            {
+                ui32Value ^= ui32Clk;
+            }
+            *pui8Edges++ = ui32Value;
+            ui32Data <<= 1;
+
+            //
+            // Toggle the Clk signal while the slave's bit is read.
+            //
+            ui32Value ^= ui32Clk;
+            *pui8Edges++ = ui32Value;
+        }
+    }
+
+    //
+    // Set the Tx pin low and return the Clk signal to its idle state, then
+    // deassert Fss.
+    //
+    ui32Value &= ~ui32Tx;
+    if((psSSI->ui8Flags & SOFTSSI_FLAG_SPH) == 0)
+    {
+        ui32Value ^= ui32Clk;
+    }
+    *pui8Edges++ = ui32Value;
+    *pui8Edges = ui32Value | ui32Fss;
+
+    //
+    // Return the number of bytes in the buffer.
+    //
+    return(ui32Len);
+}
+
+//*****************************************************************************
+//
+//! Extracts the received words from a buffer of sampled GPIO pin states.
+//!
+//! \param psSSI specifies the SoftSSI data structure.
+//! \param pui8Samples is a pointer to the sampled pin states.
+//! \param ui32Count is the number of words that were transferred.
+//! \param pui16Data is a pointer to the buffer into which the received words
+//! are written.
+//!
+//! This function is the receive counterpart of SoftSSIEdgeBufferBuild().
+//! While the edge buffer is played out, a second uDMA channel, triggered
+//! just before each entry of the edge buffer is written, can copy the GPIO
+//! port data register into a sample buffer of the same size as the edge
+//! buffer.  This function then reads the Rx pin from the samples at the
+//! points where SoftSSITimerTick() would have read it.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SoftSSIEdgeBufferDecode(tSoftSSI *psSSI, const uint8_t *pui8Samples,
+                        uint32_t ui32Count, uint16_t *pui16Data)
+{
+    uint32_t ui32Rx, ui32Idx, ui32Bit, ui32Data;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(pui8Samples);
+    ASSERT(pui16Data);
+
+    //
+    // Get the bit-packed representation of the Rx pin.
+    //
+    ui32Rx = (psSSI->ui32RxGPIO & 0x000003fc) >> 2;
+
+    //
+    // The Rx pin is read before each second toggle of the Clk signal, which
+    // begins with the third entry of the edge buffer.
+    //
+    pui8Samples += 2;
+
+    //
+    // Loop through the words that were transferred.
+    //
+    for(ui32Idx = 0; ui32Idx < ui32Count; ui32Idx++)
+    {
+        //
+        // Shift in the bits of this word.
+        //
+        for(ui32Data = 0, ui32Bit = 0; ui32Bit < psSSI->ui8Bits; ui32Bit++)
+        {
+            ui32Data = (ui32Data << 1) | ((*pui8Samples & ui32Rx) ? 1 : 0);
+            pui8Samples += 2;
+        }
+
+        //
+        // Save this word.
+        //
+        *pui16Data++ = ui32Data;
+    }
+}
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
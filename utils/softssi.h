@@ -43,6 +43,46 @@ extern "C"
 //
 //*****************************************************************************
 
+//*****************************************************************************
+//
+//! This structure describes a multi-word transfer performed by
+//! SoftSSITransfer().  The structure must remain valid until the transfer has
+//! completed.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The words to be transmitted.  If this member is zero, zeros are
+    //! transmitted instead.
+    //
+    const uint16_t *pui16TxData;
+
+    //
+    //! The buffer into which the received words are stored.  If this member
+    //! is zero, the received words are discarded.
+    //
+    uint16_t *pui16RxData;
+
+    //
+    //! The number of words to be transferred.
+    //
+    uint32_t ui32Count;
+
+    //
+    //! The function that is called when the transfer has completed and the
+    //! Fss signal has been deasserted.  If this member is zero, no function
+    //! is called.
+    //
+    void (*pfnCallback)(void *pvCallbackData);
+
+    //
+    //! The value that is passed to the callback function.
+    //
+    void *pvCallbackData;
+}
+tSoftSSITransfer;
+
 //*****************************************************************************
 //
 //! This structure contains the state of a single instance of a SoftSSI module.
@@ -200,6 +240,27 @@ typedef struct
     //! the application.
     //
     uint8_t ui8IdleCount;
+
+    //
+    //! Non-zero if the word being transferred belongs to the current transfer,
+    //! or zero if it came from the transmit FIFO.  This member should not be
+    //! accessed or modified by the application.
+    //
+    uint8_t ui8TransferWord;
+
+    //
+    //! The transfer that is currently being performed, or zero if the
+    //! transmit FIFO is in use.  This member should not be accessed or
+    //! modified by the application.
+    //
+    tSoftSSITransfer *psTransfer;
+
+    //
+    //! The number of words of the current transfer that have been
+    //! transferred.  This member should not be accessed or modified by the
+    //! application.
+    //
+    uint32_t ui32TransferCount;
 }
 tSoftSSI;
 
@@ -263,6 +324,15 @@ extern void SoftSSIRxGPIOSet(tSoftSSI *psSSI, uint32_t ui32Base,
                              uint8_t ui8Pin);
 extern bool SoftSSISpaceAvail(tSoftSSI *psSSI);
 extern void SoftSSITimerTick(tSoftSSI *psSSI);
+extern bool SoftSSITransfer(tSoftSSI *psSSI, tSoftSSITransfer *psTransfer);
+extern uint32_t SoftSSIEdgeBufferAddrGet(tSoftSSI *psSSI);
+extern uint32_t SoftSSIEdgeBufferBuild(tSoftSSI *psSSI,
+                                       const uint16_t *pui16Data,
+                                       uint32_t ui32Count, uint8_t *pui8Edges,
+                                       uint32_t ui32Size);
+extern void SoftSSIEdgeBufferDecode(tSoftSSI *psSSI,
+                                    const uint8_t *pui8Samples,
+                                    uint32_t ui32Count, uint16_t *pui16Data);
 extern void SoftSSITxBufferSet(tSoftSSI *psSSI, uint16_t *pui16TxBuffer,
                                uint16_t ui16Len);
 extern void SoftSSITxGPIOSet(tSoftSSI *psSSI, uint32_t ui32Base,
@@ -32,6 +32,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
+#include "inc/hw_gpio.h"
 #include "inc/hw_ints.h"
 #include "inc/hw_memmap.h"
 #include "inc/hw_sysctl.h"
@@ -47,47 +48,27 @@
 
 //*****************************************************************************
 //
-// The states in the SoftUART transmit state machine.  The code depends upon
-// the fact that the value of TXSTATE_DATA_n is n + 1, and that TXSTATE_DATA_0
-// is 1.
+// The states in the SoftUART transmit state machine.  While in the shift
+// state, the remaining bits of the current character frame are held in the
+// ui16TxFrame structure member and are shifted out one per timer tick.
 //
 //*****************************************************************************
 #define SOFTUART_TXSTATE_IDLE   0
-#define SOFTUART_TXSTATE_DATA_0 1
-#define SOFTUART_TXSTATE_DATA_1 2
-#define SOFTUART_TXSTATE_DATA_2 3
-#define SOFTUART_TXSTATE_DATA_3 4
-#define SOFTUART_TXSTATE_DATA_4 5
-#define SOFTUART_TXSTATE_DATA_5 6
-#define SOFTUART_TXSTATE_DATA_6 7
-#define SOFTUART_TXSTATE_DATA_7 8
-#define SOFTUART_TXSTATE_START  9
-#define SOFTUART_TXSTATE_PARITY 10
-#define SOFTUART_TXSTATE_STOP_0 11
-#define SOFTUART_TXSTATE_STOP_1 12
-#define SOFTUART_TXSTATE_BREAK  13
-
-//*****************************************************************************
-//
-// The states of the SoftUART receive state machine.  The code depends upon the
-// the fact that the value of RXSTATE_DATA_n is n, and that RXSTATE_DATA_0 is
-// 0.
-//
-//*****************************************************************************
-#define SOFTUART_RXSTATE_DATA_0 0
-#define SOFTUART_RXSTATE_DATA_1 1
-#define SOFTUART_RXSTATE_DATA_2 2
-#define SOFTUART_RXSTATE_DATA_3 3
-#define SOFTUART_RXSTATE_DATA_4 4
-#define SOFTUART_RXSTATE_DATA_5 5
-#define SOFTUART_RXSTATE_DATA_6 6
-#define SOFTUART_RXSTATE_DATA_7 7
-#define SOFTUART_RXSTATE_IDLE   8
-#define SOFTUART_RXSTATE_PARITY 9
-#define SOFTUART_RXSTATE_STOP_0 10
-#define SOFTUART_RXSTATE_STOP_1 11
-#define SOFTUART_RXSTATE_BREAK  12
-#define SOFTUART_RXSTATE_DELAY  13
+#define SOFTUART_TXSTATE_SHIFT  1
+#define SOFTUART_TXSTATE_BREAK  2
+
+//*****************************************************************************
+//
+// The states of the SoftUART receive state machine.  While in the shift
+// state, the bits of the current character frame (following the start bit)
+// are collected in the ui16RxFrame structure member and decoded once the
+// whole frame has been received.
+//
+//*****************************************************************************
+#define SOFTUART_RXSTATE_IDLE   0
+#define SOFTUART_RXSTATE_SHIFT  1
+#define SOFTUART_RXSTATE_BREAK  2
+#define SOFTUART_RXSTATE_DELAY  3
 
 //*****************************************************************************
 //
@@ -166,6 +147,115 @@ SoftUARTInit(tSoftUART *psUART)
     psUART->ui16Config = SOFTUART_CONFIG_TXLVL_4 | SOFTUART_CONFIG_RXLVL_4;
 }
 
+//*****************************************************************************
+//
+// Computes the number of bits that follow the start bit in each character
+// frame (the data bits, the optional parity bit and the stop bits) for the
+// current configuration.
+//
+//*****************************************************************************
+static void
+SoftUARTFrameBitsSet(tSoftUART *psUART)
+{
+    psUART->ui8FrameBits =
+        (((psUART->ui16Config & SOFTUART_CONFIG_WLEN_MASK) >>
+          SOFTUART_CONFIG_WLEN_S) + 5 +
+         (((psUART->ui16Config & SOFTUART_CONFIG_PAR_MASK) !=
+           SOFTUART_CONFIG_PAR_NONE) ? 1 : 0) +
+         (((psUART->ui16Config & SOFTUART_CONFIG_STOP_MASK) ==
+           SOFTUART_CONFIG_STOP_TWO) ? 2 : 1));
+}
+
+//*****************************************************************************
+//
+// Returns the parity bit to be sent with, or expected with, a data byte for
+// the current configuration.  This must only be called if parity is enabled.
+//
+//*****************************************************************************
+static uint32_t
+SoftUARTParityGet(tSoftUART *psUART, uint32_t ui32Data)
+{
+    switch(psUART->ui16Config & SOFTUART_CONFIG_PAR_MASK)
+    {
+        //
+        // The parity bit is fixed.
+        //
+        case SOFTUART_CONFIG_PAR_ONE:
+        {
+            return(1);
+        }
+        case SOFTUART_CONFIG_PAR_ZERO:
+        {
+            return(0);
+        }
+
+        //
+        // Find the even parity for the data byte by inverting the odd parity.
+        //
+        case SOFTUART_CONFIG_PAR_EVEN:
+        {
+            return(((g_pui32ParityOdd[ui32Data >> 5] >> (ui32Data & 31)) & 1) ^
+                   1);
+        }
+
+        //
+        // Find the odd parity for the data byte.
+        //
+        default:
+        {
+            return((g_pui32ParityOdd[ui32Data >> 5] >> (ui32Data & 31)) & 1);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Serializes the next character from the transmit buffer into a frame that is
+// shifted out, LSB first, by SoftUARTTxTimerTick().  The start bit is staged
+// as the next value to be written to the Tx pin and the remaining bits (data,
+// parity and stop) are left in the frame.
+//
+//*****************************************************************************
+static void
+SoftUARTTxFrameBuild(tSoftUART *psUART)
+{
+    uint32_t ui32Data, ui32Frame, ui32WordLen;
+
+    //
+    // Get the next byte to be transmitted, limited to the word length.
+    //
+    ui32WordLen = (((psUART->ui16Config & SOFTUART_CONFIG_WLEN_MASK) >>
+                    SOFTUART_CONFIG_WLEN_S) + 5);
+    ui32Data = (psUART->pui8TxBuffer[psUART->ui16TxBufferRead] &
+                ((1 << ui32WordLen) - 1));
+
+    //
+    // Start with all ones so that the stop bits (and a parity bit of one) are
+    // already in place, then insert the data bits.
+    //
+    ui32Frame = (0xffffffff << ui32WordLen) | ui32Data;
+
+    //
+    // Insert the parity bit, if enabled.
+    //
+    if((psUART->ui16Config & SOFTUART_CONFIG_PAR_MASK) !=
+       SOFTUART_CONFIG_PAR_NONE)
+    {
+        if(!SoftUARTParityGet(psUART, ui32Data))
+        {
+            ui32Frame &= ~(1 << ui32WordLen);
+        }
+    }
+
+    //
+    // Save the frame and stage the start bit.
+    //
+    psUART->ui16TxFrame = ui32Frame;
+    psUART->ui8TxBits = psUART->ui8FrameBits;
+    psUART->ui8TxNext = 0;
+    psUART->ui8TxState = SOFTUART_TXSTATE_SHIFT;
+}
+
 //*****************************************************************************
 //
 //! Sets the configuration of a SoftUART module.
@@ -248,6 +338,7 @@ SoftUARTConfigSet(tSoftUART *psUART, uint32_t ui32Config)
     //
     psUART->ui16Config = ((psUART->ui16Config & SOFTUART_CONFIG_EXT_M) |
                           (ui32Config & SOFTUART_CONFIG_BASE_M));
+    SoftUARTFrameBitsSet(psUART);
 
     //
     // Enable the SoftUART module.
@@ -269,469 +360,136 @@ SoftUARTConfigSet(tSoftUART *psUART, uint32_t ui32Config)
 
 //*****************************************************************************
 //
-//! Performs the periodic update of the SoftUART transmitter.
-//!
-//! \param psUART specifies the SoftUART data structure.
-//!
-//! This function performs the periodic, time-based updates to the SoftUART
-//! transmitter.  The transmission of data from the SoftUART is performed by
-//! the state machine in this function.
-//!
-//! This function must be called at the desired SoftUART baud rate.  For
-//! example, to run the SoftUART at 115,200 baud, this function must be called
-//! at a 115,200 Hz rate.
-//!
-//! \return None.
+// Handles the transmitter once the last bit of a character frame has been
+// written to the Tx pin, or while it is idle or sending a break.  This
+// advances the transmit buffer, starts the next character if there is one and
+// generates the transmit "interrupts".
 //
 //*****************************************************************************
-void
-SoftUARTTxTimerTick(tSoftUART *psUART)
+static void
+SoftUARTTxFrameNext(tSoftUART *psUART)
 {
     uint32_t ui32Temp;
 
     //
-    // Write the next value to the Tx data line.  This value was computed on
-    // the previous timer tick, which helps to reduce the jitter on the Tx
-    // edges (which is important since a UART connection does not contain a
-    // clock signal).
-    //
-    HWREG(psUART->ui32TxGPIO) = psUART->ui8TxNext;
-
-    //
-    // Determine the current state of the state machine.
+    // See if the last bit of a character frame (the final stop bit) was just
+    // written.
     //
-    switch(psUART->ui8TxState)
+    if(psUART->ui8TxState == SOFTUART_TXSTATE_SHIFT)
     {
         //
-        // The state machine is idle.
+        // The data byte has been completely transferred, so advance the read
+        // pointer.
         //
-        case SOFTUART_TXSTATE_IDLE:
+        psUART->ui16TxBufferRead++;
+        if(psUART->ui16TxBufferRead == psUART->ui16TxBufferLen)
         {
-            //
-            // See if the SoftUART module is enabled.
-            //
-            if(!(psUART->ui8Flags & SOFTUART_FLAG_ENABLE))
-            {
-                //
-                // The SoftUART module is not enabled, so do nothing and stay
-                // in the idle state.
-                //
-                break;
-            }
-
-            //
-            // See if the break signal should be asserted.
-            //
-            else if(psUART->ui8Flags & SOFTUART_FLAG_TXBREAK)
-            {
-                //
-                // The data line should be driven low while in the break state.
-                //
-                psUART->ui8TxNext = 0;
-
-                //
-                // Move to the break state.
-                //
-                psUART->ui8TxState = SOFTUART_TXSTATE_BREAK;
-            }
-
-            //
-            // Otherwise, see if there is data in the transmit buffer.
-            //
-            else if(psUART->ui16TxBufferRead != psUART->ui16TxBufferWrite)
-            {
-                //
-                // The data line should be driven low to indicate a start bit.
-                //
-                psUART->ui8TxNext = 0;
-
-                //
-                // Move to the start bit state.
-                //
-                psUART->ui8TxState = SOFTUART_TXSTATE_START;
-            }
-
-            //
-            // This state has been handled.
-            //
-            break;
+            psUART->ui16TxBufferRead = 0;
         }
 
         //
-        // The state machine is in the start bit state.
+        // Determine the number of characters in the transmit buffer.
         //
-        case SOFTUART_TXSTATE_START:
+        if(psUART->ui16TxBufferRead > psUART->ui16TxBufferWrite)
         {
-            //
-            // Get the next byte to be transmitted.
-            //
-            psUART->ui8TxData = psUART->pui8TxBuffer[psUART->ui16TxBufferRead];
-
-            //
-            // The next value to be written to the data line is the LSB of the
-            // next data byte.
-            //
-            psUART->ui8TxNext = (psUART->ui8TxData & 1) ? 255 : 0;
-
-            //
-            // Move to the data bit 0 state.
-            //
-            psUART->ui8TxState = SOFTUART_TXSTATE_DATA_0;
-
-            //
-            // This state has been handled.
-            //
-            break;
+            ui32Temp = (psUART->ui16TxBufferLen -
+                        (psUART->ui16TxBufferRead -
+                         psUART->ui16TxBufferWrite));
+        }
+        else
+        {
+            ui32Temp = (psUART->ui16TxBufferWrite -
+                        psUART->ui16TxBufferRead);
         }
 
         //
-        // In each of these states, a bit of the data byte must be output.
-        // This depends upon TXSTATE_DATA_n and TXSTATE_DATA_(n+1) being
-        // consecutively numbered.
+        // If the transmit buffer fullness just crossed the programmed level,
+        // generate a transmit "interrupt".
         //
-        case SOFTUART_TXSTATE_DATA_0:
-        case SOFTUART_TXSTATE_DATA_1:
-        case SOFTUART_TXSTATE_DATA_2:
-        case SOFTUART_TXSTATE_DATA_3:
+        if(ui32Temp == psUART->ui16TxBufferLevel)
         {
-            //
-            // The next value to be written to the data line is the next bit of
-            // the data byte.
-            //
-            psUART->ui8TxNext =
-                (psUART->ui8TxData & (1 << psUART->ui8TxState)) ? 255 : 0;
-
-            //
-            // Advance to the next state.
-            //
-            psUART->ui8TxState++;
-
-            //
-            // This state has been handled.
-            //
-            break;
+            psUART->ui16IntStatus |= SOFTUART_INT_TX;
         }
 
         //
-        // In each of these states, a bit of the data byte must be output.
-        // Additionally, based on the configuration of the SoftUART, this bit
-        // might be the last data bit of the data byte.  This depends upon
-        // TXSTATE_DATA_n and TXSTATE_DATA_(n+1) being consecutively numbered.
+        // Go back to the idle state.  The idle state handling below starts
+        // the next character immediately if there is one, so characters are
+        // sent back to back.
         //
-        case SOFTUART_TXSTATE_DATA_4:
-        case SOFTUART_TXSTATE_DATA_5:
-        case SOFTUART_TXSTATE_DATA_6:
-        case SOFTUART_TXSTATE_DATA_7:
-        {
-            //
-            // See if the bit that was just transferred is the last bit of the
-            // data byte (based on the configuration of the SoftUART).
-            //
-            if(((psUART->ui16Config & SOFTUART_CONFIG_WLEN_MASK) >>
-                SOFTUART_CONFIG_WLEN_S) ==
-               (psUART->ui8TxState - SOFTUART_TXSTATE_DATA_4))
-            {
-                //
-                // See if parity is enabled.
-                //
-                if((psUART->ui16Config & SOFTUART_CONFIG_PAR_MASK) !=
-                   SOFTUART_CONFIG_PAR_NONE)
-                {
-                    //
-                    // See if the parity is set to one.
-                    //
-                    if((psUART->ui16Config & SOFTUART_CONFIG_PAR_MASK) ==
-                       SOFTUART_CONFIG_PAR_ONE)
-                    {
-                        //
-                        // The next value to be written to the data line is
-                        // one.
-                        //
-                        psUART->ui8TxNext = 255;
-                    }
-
-                    //
-                    // Otherwise, see if the parity is set to zero.
-                    //
-                    else if((psUART->ui16Config & SOFTUART_CONFIG_PAR_MASK) ==
-                            SOFTUART_CONFIG_PAR_ZERO)
-                    {
-                        //
-                        // The next value to be written to the data line is
-                        // zero.
-                        //
-                        psUART->ui8TxNext = 0;
-                    }
-
-                    //
-                    // Otherwise, there is either even or odd parity.
-                    //
-                    else
-                    {
-                        //
-                        // Find the odd parity for the data byte.
-                        //
-                        psUART->ui8TxNext =
-                            ((g_pui32ParityOdd[psUART->ui8TxData >> 5] &
-                              (1 << (psUART->ui8TxData & 31))) ? 255 : 0);
-
-                        //
-                        // If the parity is set to even, then invert the
-                        // parity just computed (making it even parity).
-                        //
-                        if((psUART->ui16Config & SOFTUART_CONFIG_PAR_MASK) ==
-                           SOFTUART_CONFIG_PAR_EVEN)
-                        {
-                            psUART->ui8TxNext ^= 255;
-                        }
-                    }
+        psUART->ui8TxState = SOFTUART_TXSTATE_IDLE;
 
-                    //
-                    // Advance to the parity state.
-                    //
-                    psUART->ui8TxState = SOFTUART_TXSTATE_PARITY;
-                }
-
-                //
-                // Parity is not enabled.
-                //
-                else
-                {
-                    //
-                    // The next value to write to the data line is the stop
-                    // bit.
-                    //
-                    psUART->ui8TxNext = 255;
-
-                    //
-                    // See if there are one or two stop bits.
-                    //
-                    if((psUART->ui16Config & SOFTUART_CONFIG_STOP_MASK) ==
-                       SOFTUART_CONFIG_STOP_TWO)
-                    {
-                        //
-                        // Advance to the two stop bits state.
-                        //
-                        psUART->ui8TxState = SOFTUART_TXSTATE_STOP_0;
-                    }
-                    else
-                    {
-                        //
-                        // Advance to the one stop bit state.
-                        //
-                        psUART->ui8TxState = SOFTUART_TXSTATE_STOP_1;
-                    }
-                }
-            }
-
-            //
-            // Otherwise, there are more data bits to transfer.
-            //
-            else
-            {
-                //
-                // The next value to be written to the data line is the next
-                // bit of the data byte.
-                //
-                psUART->ui8TxNext =
-                    (psUART->ui8TxData & (1 << psUART->ui8TxState)) ? 255 : 0;
-
-                //
-                // Advance to the next state.
-                //
-                psUART->ui8TxState++;
-            }
-
-            //
-            // This state has been handled.
-            //
-            break;
+        //
+        // Assert the end of transmission "interrupt" if there is nothing
+        // more to send.
+        //
+        if((psUART->ui8Flags & SOFTUART_FLAG_ENABLE) &&
+           !(psUART->ui8Flags & SOFTUART_FLAG_TXBREAK) &&
+           (psUART->ui16TxBufferRead == psUART->ui16TxBufferWrite))
+        {
+            psUART->ui16IntStatus |= SOFTUART_INT_EOT;
         }
+    }
 
+    //
+    // See if the state machine is in the break state.
+    //
+    if(psUART->ui8TxState == SOFTUART_TXSTATE_BREAK)
+    {
         //
-        // The state machine is in the parity bit state.
+        // See if the break should be deasserted.
         //
-        case SOFTUART_TXSTATE_PARITY:
+        if(!(psUART->ui8Flags & SOFTUART_FLAG_ENABLE) ||
+           !(psUART->ui8Flags & SOFTUART_FLAG_TXBREAK))
         {
             //
-            // The next value to write to the data line is the stop bit.
+            // The data line should be driven high to indicate it is idle.
             //
             psUART->ui8TxNext = 255;
 
             //
-            // See if there are one or two stop bits.
-            //
-            if((psUART->ui16Config & SOFTUART_CONFIG_STOP_MASK) ==
-               SOFTUART_CONFIG_STOP_TWO)
-            {
-                //
-                // Advance to the two stop bits state.
-                //
-                psUART->ui8TxState = SOFTUART_TXSTATE_STOP_0;
-            }
-            else
-            {
-                //
-                // Advance to the one stop bit state.
-                //
-                psUART->ui8TxState = SOFTUART_TXSTATE_STOP_1;
-            }
-
-            //
-            // This state has been handled.
+            // Advance to the idle state.
             //
-            break;
+            psUART->ui8TxState = SOFTUART_TXSTATE_IDLE;
         }
+    }
 
+    //
+    // The state machine is idle.  See if the SoftUART module is enabled.
+    //
+    else if(!(psUART->ui8Flags & SOFTUART_FLAG_ENABLE))
+    {
         //
-        // The state machine is in the two stop bits state.
+        // The SoftUART module is not enabled, so do nothing and stay in the
+        // idle state.
         //
-        case SOFTUART_TXSTATE_STOP_0:
-        {
-            //
-            // Advance to the one stop bit state.
-            //
-            psUART->ui8TxState = SOFTUART_TXSTATE_STOP_1;
-
-            //
-            // This state has been handled.
-            //
-            break;
-        }
+    }
 
+    //
+    // See if the break signal should be asserted.
+    //
+    else if(psUART->ui8Flags & SOFTUART_FLAG_TXBREAK)
+    {
         //
-        // The state machine is in the one stop bit state.
+        // The data line should be driven low while in the break state.
         //
-        case SOFTUART_TXSTATE_STOP_1:
-        {
-            //
-            // The data byte has been completely transferred, so advance the
-            // read pointer.
-            //
-            psUART->ui16TxBufferRead++;
-            if(psUART->ui16TxBufferRead == psUART->ui16TxBufferLen)
-            {
-                psUART->ui16TxBufferRead = 0;
-            }
+        psUART->ui8TxNext = 0;
 
-            //
-            // Determine the number of characters in the transmit buffer.
-            //
-            if(psUART->ui16TxBufferRead > psUART->ui16TxBufferWrite)
-            {
-                ui32Temp = (psUART->ui16TxBufferLen -
-                            (psUART->ui16TxBufferRead -
-                             psUART->ui16TxBufferWrite));
-            }
-            else
-            {
-                ui32Temp = (psUART->ui16TxBufferWrite -
-                            psUART->ui16TxBufferRead);
-            }
+        //
+        // Move to the break state.
+        //
+        psUART->ui8TxState = SOFTUART_TXSTATE_BREAK;
+    }
 
-            //
-            // If the transmit buffer fullness just crossed the programmed
-            // level, generate a transmit "interrupt".
-            //
-            if(ui32Temp == psUART->ui16TxBufferLevel)
-            {
-                psUART->ui16IntStatus |= SOFTUART_INT_TX;
-            }
-
-            //
-            // See if the SoftUART module is enabled.
-            //
-            if(!(psUART->ui8Flags & SOFTUART_FLAG_ENABLE))
-            {
-                //
-                // The SoftUART module is not enabled, so do advance to the
-                // idle state.
-                //
-                psUART->ui8TxState = SOFTUART_TXSTATE_IDLE;
-            }
-
-            //
-            // See if the break signal should be asserted.
-            //
-            else if(psUART->ui8Flags & SOFTUART_FLAG_TXBREAK)
-            {
-                //
-                // The data line should be driven low while in the break state.
-                //
-                psUART->ui8TxNext = 0;
-
-                //
-                // Move to the break state.
-                //
-                psUART->ui8TxState = SOFTUART_TXSTATE_BREAK;
-            }
-
-            //
-            // Otherwise, see if there is data in the transmit buffer.
-            //
-            else if(psUART->ui16TxBufferRead != psUART->ui16TxBufferWrite)
-            {
-                //
-                // The data line should be driven low to indicate a start bit.
-                //
-                psUART->ui8TxNext = 0;
-
-                //
-                // Move to the start bit state.
-                //
-                psUART->ui8TxState = SOFTUART_TXSTATE_START;
-            }
-
-            //
-            // Otherwise, there is nothing to do.
-            //
-            else
-            {
-                //
-                // Assert the end of transmission "interrupt".
-                //
-                psUART->ui16IntStatus |= SOFTUART_INT_EOT;
-
-                //
-                // Advance to the idle state.
-                //
-                psUART->ui8TxState = SOFTUART_TXSTATE_IDLE;
-            }
-
-            //
-            // This state has been handled.
-            //
-            break;
-        }
-
-        //
-        // The state machine is in the break state.
-        //
-        case SOFTUART_TXSTATE_BREAK:
-        {
-            //
-            // See if the break should be deasserted.
-            //
-            if(!(psUART->ui8Flags & SOFTUART_FLAG_ENABLE) ||
-               !(psUART->ui8Flags & SOFTUART_FLAG_TXBREAK))
-            {
-                //
-                // The data line should be driven high to indicate it is idle.
-                //
-                psUART->ui8TxNext = 255;
-
-                //
-                // Advance to the idle state.
-                //
-                psUART->ui8TxState = SOFTUART_TXSTATE_IDLE;
-            }
-
-            //
-            // This state has been handled.
-            //
-            break;
-        }
-    }
+    //
+    // Otherwise, see if there is data in the transmit buffer.
+    //
+    else if(psUART->ui16TxBufferRead != psUART->ui16TxBufferWrite)
+    {
+        //
+        // Serialize the next character and stage its start bit.
+        //
+        SoftUARTTxFrameBuild(psUART);
+    }
 
     //
     // Call the "interrupt" callback while there are enabled "interrupts"
@@ -749,6 +507,52 @@ SoftUARTTxTimerTick(tSoftUART *psUART)
     }
 }
 
+//*****************************************************************************
+//
+//! Performs the periodic update of the SoftUART transmitter.
+//!
+//! \param psUART specifies the SoftUART data structure.
+//!
+//! This function performs the periodic, time-based updates to the SoftUART
+//! transmitter.  The transmission of data from the SoftUART is performed by
+//! the state machine in this function.
+//!
+//! This function must be called at the desired SoftUART baud rate.  For
+//! example, to run the SoftUART at 115,200 baud, this function must be called
+//! at a 115,200 Hz rate.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SoftUARTTxTimerTick(tSoftUART *psUART)
+{
+    //
+    // Write the next value to the Tx data line.  This value was computed on
+    // the previous timer tick, which helps to reduce the jitter on the Tx
+    // edges (which is important since a UART connection does not contain a
+    // clock signal).
+    //
+    HWREG(psUART->ui32TxGPIO) = psUART->ui8TxNext;
+
+    //
+    // In the common case, a character frame is being shifted out so simply
+    // stage the next bit of the frame.
+    //
+    if(psUART->ui8TxBits != 0)
+    {
+        psUART->ui8TxNext = (psUART->ui16TxFrame & 1) ? 255 : 0;
+        psUART->ui16TxFrame >>= 1;
+        psUART->ui8TxBits--;
+        return;
+    }
+
+    //
+    // Otherwise, the frame is complete or the transmitter is idle.
+    //
+    SoftUARTTxFrameNext(psUART);
+}
+
 //*****************************************************************************
 //
 //! Handles the assertion of the receive ``interrupt''.
@@ -790,6 +594,132 @@ SoftUARTRxWriteInt(tSoftUART *psUART)
     }
 }
 
+//*****************************************************************************
+//
+// Writes the character that has just been received, along with its receive
+// flags, into the receive buffer, or flags an overrun if the buffer is full.
+//
+//*****************************************************************************
+static void
+SoftUARTRxCharStore(tSoftUART *psUART)
+{
+    uint32_t ui32Temp;
+
+    //
+    // Compute the value of the write pointer advanced by one.
+    //
+    ui32Temp = psUART->ui16RxBufferWrite + 1;
+    if(ui32Temp == psUART->ui16RxBufferLen)
+    {
+        ui32Temp = 0;
+    }
+
+    //
+    // See if there is space in the receive buffer.
+    //
+    if(ui32Temp == psUART->ui16RxBufferRead)
+    {
+        //
+        // Set the overrun error flag.  This will remain set until a new
+        // character can be placed into the receive buffer, which will then be
+        // given this status.
+        //
+        psUART->ui8RxFlags |= SOFTUART_RXFLAG_OE;
+
+        //
+        // Set the receive overrun "interrupt" and status if it is not already
+        // set.
+        //
+        if(!(psUART->ui8RxStatus & SOFTUART_RXERROR_OVERRUN))
+        {
+            psUART->ui8RxStatus |= SOFTUART_RXERROR_OVERRUN;
+            psUART->ui16IntStatus |= SOFTUART_INT_OE;
+        }
+    }
+
+    //
+    // Otherwise, there is space in the receive buffer.
+    //
+    else
+    {
+        //
+        // Write this data byte, along with the receive flags, into the
+        // receive buffer.
+        //
+        psUART->pui16RxBuffer[psUART->ui16RxBufferWrite] =
+            psUART->ui8RxData | (psUART->ui8RxFlags << 8);
+
+        //
+        // Advance the write pointer.
+        //
+        psUART->ui16RxBufferWrite = ui32Temp;
+
+        //
+        // Clear the overrun flag since it was just written into the receive
+        // buffer.  The remaining flags are left for the caller to turn into
+        // "interrupts".
+        //
+        psUART->ui8RxFlags &= ~(SOFTUART_RXFLAG_OE);
+
+        //
+        // Assert the receive "interrupt" if appropriate.
+        //
+        SoftUARTRxWriteInt(psUART);
+    }
+}
+
+//*****************************************************************************
+//
+// Decodes a complete character frame.  The frame holds the bits that followed
+// the start bit, LSB first.  The data bits are extracted into ui8RxData and
+// the parity, framing and break flags in ui8RxFlags are updated.
+//
+//*****************************************************************************
+static void
+SoftUARTRxFrameDecode(tSoftUART *psUART, uint32_t ui32Frame)
+{
+    uint32_t ui32WordLen, ui32Stop;
+
+    //
+    // Extract the data bits.
+    //
+    ui32WordLen = (((psUART->ui16Config & SOFTUART_CONFIG_WLEN_MASK) >>
+                    SOFTUART_CONFIG_WLEN_S) + 5);
+    psUART->ui8RxData = ui32Frame & ((1 << ui32WordLen) - 1);
+
+    //
+    // Clear the break error if any non-zero bit was received.
+    //
+    if(ui32Frame)
+    {
+        psUART->ui8RxFlags &= ~(SOFTUART_RXFLAG_BE);
+    }
+
+    //
+    // Check the parity bit, if enabled.
+    //
+    ui32Stop = ui32WordLen;
+    if((psUART->ui16Config & SOFTUART_CONFIG_PAR_MASK) !=
+       SOFTUART_CONFIG_PAR_NONE)
+    {
+        if(((ui32Frame >> ui32WordLen) & 1) !=
+           SoftUARTParityGet(psUART, psUART->ui8RxData))
+        {
+            psUART->ui8RxFlags |= SOFTUART_RXFLAG_PE;
+        }
+        ui32Stop++;
+    }
+
+    //
+    // All of the stop bits must be one, otherwise there is a framing error.
+    //
+    if(((ui32Frame >> ui32Stop) | (0xffffffff << (psUART->ui8FrameBits -
+                                                  ui32Stop))) != 0xffffffff)
+    {
+        psUART->ui8RxFlags |= SOFTUART_RXFLAG_FE;
+    }
+}
+
 //*****************************************************************************
 //
 //! Performs the periodic update of the SoftUART receiver.
@@ -815,12 +745,30 @@ SoftUARTRxWriteInt(tSoftUART *psUART)
 uint32_t
 SoftUARTRxTick(tSoftUART *psUART, bool bEdgeInt)
 {
-    uint32_t ui32PinState, ui32Temp, ui32Ret;
+    uint32_t ui32PinState, ui32Ret;
 
     //
     // Read the current state of the Rx data line.
     //
-    ui32PinState = MAP_GPIOPinRead(psUART->ui32RxGPIOPort, psUART->ui8RxPin);
+    ui32PinState = HWREG(psUART->ui32RxGPIOPort + GPIO_O_DATA +
+                         (psUART->ui8RxPin << 2));
+
+    //
+    // In the common case, a character frame is being received so simply
+    // shift in the next bit.  The frame is decoded once all of its bits have
+    // been collected.
+    //
+    if(psUART->ui8RxState == SOFTUART_RXSTATE_SHIFT)
+    {
+        if(ui32PinState)
+        {
+            psUART->ui16RxFrame |= 1 << psUART->ui8RxBits;
+        }
+        if(++psUART->ui8RxBits != psUART->ui8FrameBits)
+        {
+            return(SOFTUART_RXTIMER_NOP);
+        }
+    }
 
     //
     // The default return code inidicates that the receive timer does not need
@@ -860,9 +808,10 @@ SoftUARTRxTick(tSoftUART *psUART, bool bEdgeInt)
             GPIOIntDisable(psUART->ui32RxGPIOPort, psUART->ui8RxPin);
 
             //
-            // Clear the receive data buffer.
+            // Clear the receive frame.
             //
-            psUART->ui8RxData = 0;
+            psUART->ui16RxFrame = 0;
+            psUART->ui8RxBits = 0;
 
             //
             // Clear all reception errors other than overrun (which is cleared
@@ -874,9 +823,9 @@ SoftUARTRxTick(tSoftUART *psUART, bool bEdgeInt)
                                   SOFTUART_RXFLAG_BE);
 
             //
-            // Advance to the first data bit state.
+            // Advance to the shift state.
             //
-            psUART->ui8RxState = SOFTUART_RXSTATE_DATA_0;
+            psUART->ui8RxState = SOFTUART_RXSTATE_SHIFT;
 
             //
             // This state has been handled.
@@ -885,120 +834,77 @@ SoftUARTRxTick(tSoftUART *psUART, bool bEdgeInt)
         }
 
         //
-        // In each of these states, a bit of the data byte is read.  This
-        // depends upon RXSTATE_DATA_n and RXSTATE_DATA_(n+1) being
-        // consecutively numbered.
+        // The last bit of the character frame has just been received.
         //
-        case SOFTUART_RXSTATE_DATA_0:
-        case SOFTUART_RXSTATE_DATA_1:
-        case SOFTUART_RXSTATE_DATA_2:
-        case SOFTUART_RXSTATE_DATA_3:
+        case SOFTUART_RXSTATE_SHIFT:
         {
             //
-            // See if the Rx pin is high.
+            // Decode the whole frame at once.
             //
-            if(ui32PinState != 0)
+            SoftUARTRxFrameDecode(psUART, psUART->ui16RxFrame);
+
+            //
+            // See if the break error is still asserted (meaning that every bit
+            // received was zero).
+            //
+            if(psUART->ui8RxFlags & SOFTUART_RXFLAG_BE)
             {
                 //
-                // Set this bit of the received character.
+                // Since every bit was zero, advance to the break state.
                 //
-                psUART->ui8RxData |= 1 << psUART->ui8RxState;
+                psUART->ui8RxState = SOFTUART_RXSTATE_BREAK;
 
                 //
-                // Clear the break error since a non-zero bit was received.
+                // This state has been handled.
                 //
-                psUART->ui8RxFlags &= ~(SOFTUART_RXFLAG_BE);
+                break;
             }
 
             //
-            // Advance to the next state.
-            //
-            psUART->ui8RxState++;
-
-            //
-            // This state has been handled.
+            // Save the character in the receive buffer.
             //
-            break;
-        }
+            SoftUARTRxCharStore(psUART);
 
-        //
-        // In each of these states, a bit of the data byte is read.
-        // Additionally, based on the configuration of the SoftUART, this bit
-        // might be the last bit of the data byte.  This depends upon
-        // RXSTATE_DATA_n and RXSTATE_DATA_(n+1) being consecutively numbered.
-        //
-        case SOFTUART_RXSTATE_DATA_4:
-        case SOFTUART_RXSTATE_DATA_5:
-        case SOFTUART_RXSTATE_DATA_6:
-        case SOFTUART_RXSTATE_DATA_7:
-        {
             //
-            // See if the Rx pin is high.
+            // See if this character had a parity error.
             //
-            if(ui32PinState != 0)
+            if(psUART->ui8RxFlags & SOFTUART_RXFLAG_PE)
             {
                 //
-                // Set this bit of the received character.
-                //
-                psUART->ui8RxData |= 1 << psUART->ui8RxState;
-
-                //
-                // Clear the break error since a non-zero bit was received.
+                // Assert the parity error "interrupt".
                 //
-                psUART->ui8RxFlags &= ~(SOFTUART_RXFLAG_BE);
+                psUART->ui16IntStatus |= SOFTUART_INT_PE;
             }
 
             //
-            // See if the bit that was just transferred is the last bit of the
-            // data byte (based on the configuration of the SoftUART).
+            // See if this character had a framing error.
             //
-            if(((psUART->ui16Config & SOFTUART_CONFIG_WLEN_MASK) >>
-                SOFTUART_CONFIG_WLEN_S) ==
-               (psUART->ui8RxState - SOFTUART_RXSTATE_DATA_4))
+            if(psUART->ui8RxFlags & SOFTUART_RXFLAG_FE)
             {
                 //
-                // See if parity is enabled.
+                // Assert the framing error "interrupt".
                 //
-                if((psUART->ui16Config & SOFTUART_CONFIG_PAR_MASK) !=
-                   SOFTUART_CONFIG_PAR_NONE)
-                {
-                    //
-                    // Advance to the parity state.
-                    //
-                    psUART->ui8RxState = SOFTUART_RXSTATE_PARITY;
-                }
+                psUART->ui16IntStatus |= SOFTUART_INT_FE;
+            }
 
-                //
-                // Otherwise, see if there are one or two stop bits.
-                //
-                else if((psUART->ui16Config & SOFTUART_CONFIG_STOP_MASK) ==
-                        SOFTUART_CONFIG_STOP_TWO)
-                {
-                    //
-                    // Advance to the two stop bits state.
-                    //
-                    psUART->ui8RxState = SOFTUART_RXSTATE_STOP_0;
-                }
+            //
+            // Clear the receive flags other than overrun, which is kept until
+            // a character can be stored.
+            //
+            psUART->ui8RxFlags &= SOFTUART_RXFLAG_OE;
 
-                //
-                // Otherwise, advance to the one stop bit state.
-                //
-                else
-                {
-                    psUART->ui8RxState = SOFTUART_RXSTATE_STOP_1;
-                }
-            }
+            //
+            // Enable the falling edge interrupt on the Rx pin so that the next
+            // start bit can be detected.
+            //
+            GPIOIntClear(psUART->ui32RxGPIOPort, psUART->ui8RxPin);
+            GPIOIntEnable(psUART->ui32RxGPIOPort, psUART->ui8RxPin);
 
             //
-            // Otherwise, there are more bits to receive.
+            // Advance to the receive timeout delay state.
             //
-            else
-            {
-                //
-                // Advance to the next state.
-                //
-                psUART->ui8RxState++;
-            }
+            psUART->ui8RxData = 0;
+            psUART->ui8RxState = SOFTUART_RXSTATE_DELAY;
 
             //
             // This state has been handled.
@@ -1007,131 +913,71 @@ SoftUARTRxTick(tSoftUART *psUART, bool bEdgeInt)
         }
 
         //
-        // The state machine is in the parity bit state.
+        // The state machine is in the break state.
         //
-        case SOFTUART_RXSTATE_PARITY:
+        case SOFTUART_RXSTATE_BREAK:
         {
             //
-            // See if the parity is set to one.
+            // See if the Rx pin is high.
             //
-            if((psUART->ui16Config & SOFTUART_CONFIG_PAR_MASK) ==
-               SOFTUART_CONFIG_PAR_ONE)
+            if(ui32PinState != 0)
             {
                 //
-                // Set the expected parity to one.
+                // Clear the break error since a non-zero bit was received.
                 //
-                ui32Temp = psUART->ui8RxPin;
+                psUART->ui8RxFlags &= ~(SOFTUART_RXFLAG_BE);
             }
 
             //
-            // Otherwise, see if the parity is set to zero.
+            // Save the character in the receive buffer.
             //
-            else if((psUART->ui16Config & SOFTUART_CONFIG_PAR_MASK) ==
-                    SOFTUART_CONFIG_PAR_ZERO)
-            {
-                //
-                // Set the expected parity to zero.
-                //
-                ui32Temp = 0;
-            }
+            SoftUARTRxCharStore(psUART);
 
             //
-            // Otherwise, there is either even or odd parity.
+            // See if this was a break error.
             //
-            else
-            {
-                //
-                // Find the odd parity for the data byte.
-                //
-                ui32Temp = ((g_pui32ParityOdd[psUART->ui8RxData >> 5] &
-                             (1 << (psUART->ui8RxData & 31))) ?
-                            psUART->ui8RxPin : 0);
-
-                //
-                // If the parity is set to even, then invert the parity just
-                // computed (making it even parity).
-                //
-                if((psUART->ui16Config & SOFTUART_CONFIG_PAR_MASK) ==
-                   SOFTUART_CONFIG_PAR_EVEN)
-                {
-                    ui32Temp ^= psUART->ui8RxPin;
-                }
-            }
-
-            //
-            // See if the pin state matches the expected parity.
-            //
-            if(ui32PinState != ui32Temp)
+            if(psUART->ui8RxFlags & SOFTUART_RXFLAG_BE)
             {
                 //
-                // The parity does not match, so set the parity error flag.
+                // Assert the break error "interrupt".
                 //
-                psUART->ui8RxFlags |= SOFTUART_RXFLAG_PE;
+                psUART->ui16IntStatus |= SOFTUART_INT_BE;
             }
 
             //
-            // See if the Rx pin is high.
+            // See if this character had a parity error.
             //
-            if(ui32PinState != 0)
+            if(psUART->ui8RxFlags & SOFTUART_RXFLAG_PE)
             {
                 //
-                // Clear the break error since a non-zero bit was received.
+                // Assert the parity error "interrupt".
                 //
-                psUART->ui8RxFlags &= ~(SOFTUART_RXFLAG_BE);
+                psUART->ui16IntStatus |= SOFTUART_INT_PE;
             }
 
             //
-            // See if there are one or two stop bits.
+            // Assert the framing error "interrupt".
             //
-            if((psUART->ui16Config & SOFTUART_CONFIG_STOP_MASK) ==
-               SOFTUART_CONFIG_STOP_TWO)
-            {
-                //
-                // Advance to the two stop bits state.
-                //
-                psUART->ui8RxState = SOFTUART_RXSTATE_STOP_0;
-            }
-            else
-            {
-                //
-                // Advance to the one stop bit state.
-                //
-                psUART->ui8RxState = SOFTUART_RXSTATE_STOP_1;
-            }
+            psUART->ui16IntStatus |= SOFTUART_INT_FE;
 
             //
-            // This state has been handled.
+            // Clear the receive flags other than overrun, which is kept until
+            // a character can be stored.
             //
-            break;
-        }
+            psUART->ui8RxFlags &= SOFTUART_RXFLAG_OE;
 
-        //
-        // The state machine is in the two stop bits state.
-        //
-        case SOFTUART_RXSTATE_STOP_0:
-        {
             //
-            // See if the Rx pin is low.
+            // Enable the falling edge interrupt on the Rx pin so that the next
+            // start bit can be detected.
             //
-            if(ui32PinState == 0)
-            {
-                //
-                // Since the Rx pin is low, there is a framing error.
-                //
-                psUART->ui8RxFlags |= SOFTUART_RXFLAG_FE;
-            }
-            else
-            {
-                //
-                // Clear the break error since a non-zero bit was received.
-                //
-                psUART->ui8RxFlags &= ~(SOFTUART_RXFLAG_BE);
-            }
+            GPIOIntClear(psUART->ui32RxGPIOPort, psUART->ui8RxPin);
+            GPIOIntEnable(psUART->ui32RxGPIOPort, psUART->ui8RxPin);
 
             //
-            // Advance to the one stop bit state.
+            // Advance to the receive timeout delay state.
             //
-            psUART->ui8RxState = SOFTUART_RXSTATE_STOP_1;
+            psUART->ui8RxData = 0;
+            psUART->ui8RxState = SOFTUART_RXSTATE_DELAY;
 
             //
             // This state has been handled.
@@ -1140,317 +986,329 @@ SoftUARTRxTick(tSoftUART *psUART, bool bEdgeInt)
         }
 
         //
-        // The state machine is in the one stop bit state.
+        // The state machine is in the receive timeout delay state.
         //
-        case SOFTUART_RXSTATE_STOP_1:
+        case SOFTUART_RXSTATE_DELAY:
         {
             //
-            // See if the Rx pin is low.
-            //
-            if(ui32PinState == 0)
-            {
-                //
-                // Since the Rx pin is low, there is a framing error.
-                //
-                psUART->ui8RxFlags |= SOFTUART_RXFLAG_FE;
-            }
-            else
-            {
-                //
-                // Clear the break error since a non-zero bit was received.
-                //
-                psUART->ui8RxFlags &= ~(SOFTUART_RXFLAG_BE);
-            }
-
-            //
-            // See if the break error is still asserted (meaning that every bit
-            // received was zero).
-            //
-            if(psUART->ui8RxFlags & SOFTUART_RXFLAG_BE)
-            {
-                //
-                // Since every bit was zero, advance to the break state.
-                //
-                psUART->ui8RxState = SOFTUART_RXSTATE_BREAK;
-
-                //
-                // This state has been handled.
-                //
-                break;
-            }
-
-            //
-            // Compute the value of the write pointer advanced by one.
-            //
-            ui32Temp = psUART->ui16RxBufferWrite + 1;
-            if(ui32Temp == psUART->ui16RxBufferLen)
-            {
-                ui32Temp = 0;
-            }
-
-            //
-            // See if there is space in the receive buffer.
-            //
-            if(ui32Temp == psUART->ui16RxBufferRead)
-            {
-                //
-                // Set the overrun error flag.  This will remain set until a
-                // new character can be placed into the receive buffer, which
-                // will then be given this status.
-                //
-                psUART->ui8RxFlags |= SOFTUART_RXFLAG_OE;
-
-                //
-                // Set the receive overrun "interrupt" and status if it is not
-                // already set.
-                //
-                if(!(psUART->ui8RxStatus & SOFTUART_RXERROR_OVERRUN))
-                {
-                    psUART->ui8RxStatus |= SOFTUART_RXERROR_OVERRUN;
-                    psUART->ui16IntStatus |= SOFTUART_INT_OE;
-                }
-            }
-
-            //
-            // Otherwise, there is space in the receive buffer.
-            //
-            else
-            {
-                //
-                // Write this data byte, along with the receive flags, into the
-                // receive buffer.
-                //
-                psUART->pui16RxBuffer[psUART->ui16RxBufferWrite] =
-                    psUART->ui8RxData | (psUART->ui8RxFlags << 8);
-
-                //
-                // Advance the write pointer.
-                //
-                psUART->ui16RxBufferWrite = ui32Temp;
-
-                //
-                // Clear the receive flags, most importantly the overrun flag
-                // since it was just written into the receive buffer.
-                //
-                psUART->ui8RxFlags = 0;
-
-                //
-                // Assert the receive "interrupt" if appropriate.
-                //
-                SoftUARTRxWriteInt(psUART);
-            }
-
-            //
-            // See if this character had a parity error.
+            // See if the receive timeout has expired.
             //
-            if(psUART->ui8RxFlags & SOFTUART_RXFLAG_PE)
+            if(psUART->ui8RxData++ == 32)
             {
                 //
-                // Assert the parity error "interrupt".
+                // Assert the receive timeout "interrupt".
                 //
-                psUART->ui16IntStatus |= SOFTUART_INT_PE;
-            }
+                psUART->ui16IntStatus |= SOFTUART_INT_RT;
 
-            //
-            // See if this character had a framing error.
-            //
-            if(psUART->ui8RxFlags & SOFTUART_RXFLAG_FE)
-            {
                 //
-                // Assert the framing error "interrupt".
+                // Tell the caller that the receive timer can be disabled.
                 //
-                psUART->ui16IntStatus |= SOFTUART_INT_FE;
+                ui32Ret = SOFTUART_RXTIMER_END;
             }
 
-            //
-            // Enable the falling edge interrupt on the Rx pin so that the next
-            // start bit can be detected.
-            //
-            GPIOIntClear(psUART->ui32RxGPIOPort, psUART->ui8RxPin);
-            GPIOIntEnable(psUART->ui32RxGPIOPort, psUART->ui8RxPin);
-
-            //
-            // Advance to the receive timeout delay state.
-            //
-            psUART->ui8RxData = 0;
-            psUART->ui8RxState = SOFTUART_RXSTATE_DELAY;
-
             //
             // This state has been handled.
             //
             break;
         }
+    }
 
+    //
+    // Call the "interrupt" callback while there are enabled "interrupts"
+    // asserted.  By calling in a loop until the "interrupts" are no longer
+    // asserted, this mimics the behavior of a real hardware implementation of
+    // the UART peripheral.
+    //
+    while(((psUART->ui16IntStatus & psUART->ui16IntMask) != 0) &&
+          (psUART->pfnIntCallback != 0))
+    {
         //
-        // The state machine is in the break state.
+        // Call the callback function.
         //
-        case SOFTUART_RXSTATE_BREAK:
-        {
-            //
-            // See if the Rx pin is high.
-            //
-            if(ui32PinState != 0)
-            {
-                //
-                // Clear the break error since a non-zero bit was received.
-                //
-                psUART->ui8RxFlags &= ~(SOFTUART_RXFLAG_BE);
-            }
+        psUART->pfnIntCallback();
+    }
 
-            //
-            // Compute the value of the write pointer advanced by one.
-            //
-            ui32Temp = psUART->ui16RxBufferWrite + 1;
-            if(ui32Temp == psUART->ui16RxBufferLen)
-            {
-                ui32Temp = 0;
-            }
+    //
+    // Return to the caller.
+    //
+    return(ui32Ret);
+}
 
-            //
-            // See if there is space in the receive buffer.
-            //
-            if(ui32Temp == psUART->ui16RxBufferRead)
-            {
-                //
-                // Set the overrun error flag.  This will remain set until a
-                // new character can be placed into the receive buffer, which
-                // will then be given this status.
-                //
-                psUART->ui8RxFlags |= SOFTUART_RXFLAG_OE;
+//*****************************************************************************
+//
+// Decodes the character frame collected by SoftUARTRxEdge() or
+// SoftUARTGroupRxTick() and stores the result in the receive buffer.
+//
+//*****************************************************************************
+static void
+SoftUARTRxFrameComplete(tSoftUART *psUART)
+{
+    //
+    // Decode the whole frame at once.  A character that is all zeros,
+    // including the stop bits, is a break.
+    //
+    SoftUARTRxFrameDecode(psUART, psUART->ui16RxFrame);
 
-                //
-                // Set the receive overrun "interrupt" and status if it is not
-                // already set.
-                //
-                if(!(psUART->ui8RxStatus & SOFTUART_RXERROR_OVERRUN))
-                {
-                    psUART->ui8RxStatus |= SOFTUART_RXERROR_OVERRUN;
-                    psUART->ui16IntStatus |= SOFTUART_INT_OE;
-                }
-            }
+    //
+    // Save the character in the receive buffer.
+    //
+    SoftUARTRxCharStore(psUART);
 
-            //
-            // Otherwise, there is space in the receive buffer.
-            //
-            else
-            {
-                //
-                // Write this data byte, along with the receive flags, into the
-                // receive buffer.
-                //
-                psUART->pui16RxBuffer[psUART->ui16RxBufferWrite] =
-                    psUART->ui8RxData | (psUART->ui8RxFlags << 8);
+    //
+    // Turn the receive flags into "interrupts".
+    //
+    if(psUART->ui8RxFlags & SOFTUART_RXFLAG_BE)
+    {
+        psUART->ui16IntStatus |= SOFTUART_INT_BE;
+    }
+    if(psUART->ui8RxFlags & SOFTUART_RXFLAG_PE)
+    {
+        psUART->ui16IntStatus |= SOFTUART_INT_PE;
+    }
+    if(psUART->ui8RxFlags & SOFTUART_RXFLAG_FE)
+    {
+        psUART->ui16IntStatus |= SOFTUART_INT_FE;
+    }
+    psUART->ui8RxFlags &= SOFTUART_RXFLAG_OE;
 
-                //
-                // Advance the write pointer.
-                //
-                psUART->ui16RxBufferWrite = ui32Temp;
+    //
+    // Wait for the next start bit.
+    //
+    psUART->ui8RxState = SOFTUART_RXSTATE_IDLE;
+}
 
-                //
-                // Clear the receive flags, most importantly the overrun flag
-                // since it was just written into the receive buffer.
-                //
-                psUART->ui8RxFlags = 0;
+//*****************************************************************************
+//
+// Shifts the bits which have elapsed since the last Rx edge into the current
+// character frame.  The line held the level of the last edge for the whole of
+// this time.  Returns true once the frame is complete.
+//
+//*****************************************************************************
+static bool
+SoftUARTRxEdgeBitsAdd(tSoftUART *psUART, uint32_t ui32Time)
+{
+    uint32_t ui32Bits;
 
-                //
-                // Assert the receive "interrupt" if appropriate.
-                //
-                SoftUARTRxWriteInt(psUART);
-            }
+    //
+    // Find the number of whole bit times since the last edge, rounding to the
+    // nearest bit.  The first of these is the start bit, which is not stored.
+    //
+    ui32Bits = (((ui32Time - psUART->ui32RxEdgeTime) +
+                 (psUART->ui32RxBitTime / 2)) / psUART->ui32RxBitTime);
+    if(psUART->ui8RxBits == 0xff)
+    {
+        if(ui32Bits)
+        {
+            ui32Bits--;
+        }
+        psUART->ui8RxBits = 0;
+    }
 
-            //
-            // See if this was a break error.
-            //
-            if(psUART->ui8RxFlags & SOFTUART_RXFLAG_BE)
-            {
-                //
-                // Assert the break error "interrupt".
-                //
-                psUART->ui16IntStatus |= SOFTUART_INT_BE;
-            }
+    //
+    // Limit the bits to the end of the frame.
+    //
+    if(ui32Bits > (uint32_t)(psUART->ui8FrameBits - psUART->ui8RxBits))
+    {
+        ui32Bits = psUART->ui8FrameBits - psUART->ui8RxBits;
+    }
 
-            //
-            // See if this character had a parity error.
-            //
-            if(psUART->ui8RxFlags & SOFTUART_RXFLAG_PE)
-            {
-                //
-                // Assert the parity error "interrupt".
-                //
-                psUART->ui16IntStatus |= SOFTUART_INT_PE;
-            }
+    //
+    // A high line sets all of the elapsed bits at once.
+    //
+    if(psUART->ui8RxLevel && ui32Bits)
+    {
+        psUART->ui16RxFrame |= (((1 << ui32Bits) - 1) << psUART->ui8RxBits);
+    }
+    psUART->ui8RxBits += ui32Bits;
 
-            //
-            // Assert the framing error "interrupt".
-            //
-            psUART->ui16IntStatus |= SOFTUART_INT_FE;
+    return(psUART->ui8RxBits == psUART->ui8FrameBits);
+}
 
-            //
-            // Enable the falling edge interrupt on the Rx pin so that the next
-            // start bit can be detected.
-            //
-            GPIOIntClear(psUART->ui32RxGPIOPort, psUART->ui8RxPin);
-            GPIOIntEnable(psUART->ui32RxGPIOPort, psUART->ui8RxPin);
+//*****************************************************************************
+//
+//! Sets the bit time used to decode received characters from edge timestamps.
+//!
+//! \param psUART specifies the SoftUART data structure.
+//! \param ui32BitTime is the duration of one bit, in the units of the
+//! timestamps that will be passed to SoftUARTRxEdge().
+//!
+//! This function selects edge-timestamp reception as an alternative to
+//! calling SoftUARTRxTick() at the baud rate.  In this mode, the Rx GPIO must
+//! be configured to interrupt on both edges and the interrupt handler must
+//! pass a free-running, up-counting timestamp for each edge to
+//! SoftUARTRxEdge().  Since a timer interrupt is no longer required for every
+//! bit, the processor load of reception depends only on the number of edges
+//! in the data, allowing much higher baud rates.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SoftUARTRxBitTimeSet(tSoftUART *psUART, uint32_t ui32BitTime)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(ui32BitTime != 0);
 
-            //
-            // Advance to the receive timeout delay state.
-            //
-            psUART->ui8RxData = 0;
-            psUART->ui8RxState = SOFTUART_RXSTATE_DELAY;
+    //
+    // Save the bit time and wait for the first start bit.
+    //
+    psUART->ui32RxBitTime = ui32BitTime;
+    psUART->ui8RxState = SOFTUART_RXSTATE_IDLE;
+    psUART->ui8RxLevel = 1;
+}
 
-            //
-            // This state has been handled.
-            //
-            break;
+//*****************************************************************************
+//
+//! Handles an edge on the Rx pin in edge-timestamp reception mode.
+//!
+//! \param psUART specifies the SoftUART data structure.
+//! \param ui32Time is the time at which the edge occurred.
+//!
+//! This function must be called from the GPIO interrupt handler for every
+//! rising and falling edge on the Rx pin when SoftUARTRxBitTimeSet() has been
+//! used to select edge-timestamp reception.  The time between edges is
+//! converted into a run of identical bits, so a whole character is assembled
+//! from a handful of edges and decoded at once.
+//!
+//! Since the final bits of a character (the stop bits and any trailing one
+//! data bits) do not produce an edge, the character is completed either by
+//! the start bit of the next character or by a call to SoftUARTRxFrameEnd().
+//! The return value gives the delay after which SoftUARTRxFrameEnd() should be
+//! called, for example from a one-shot timer, if no further edge arrives.
+//!
+//! The receive timeout ``interrupt'' is not generated in this mode.
+//!
+//! \return Returns the time remaining until the end of the current character,
+//! in the same units as \e ui32Time, or 0 if no character is being received.
+//
+//*****************************************************************************
+uint32_t
+SoftUARTRxEdge(tSoftUART *psUART, uint32_t ui32Time)
+{
+    //
+    // If a character is in progress, account for the bits since the last
+    // edge.  If the frame completes, this edge may be the start bit of the
+    // next character.  The level held since the last edge is kept, so an edge
+    // that ends a break or a low stop bit is seen as rising and does not start
+    // a character.
+    //
+    if(psUART->ui8RxState == SOFTUART_RXSTATE_SHIFT)
+    {
+        if(SoftUARTRxEdgeBitsAdd(psUART, ui32Time))
+        {
+            SoftUARTRxFrameComplete(psUART);
         }
+    }
 
+    //
+    // See if a new character needs to be started.
+    //
+    if(psUART->ui8RxState != SOFTUART_RXSTATE_SHIFT)
+    {
         //
-        // The state machine is in the receive timeout delay state.
+        // A rising edge while idle, for example at the end of a break, does
+        // not start a character.
         //
-        case SOFTUART_RXSTATE_DELAY:
+        if(!psUART->ui8RxLevel)
         {
-            //
-            // See if the receive timeout has expired.
-            //
-            if(psUART->ui8RxData++ == 32)
-            {
-                //
-                // Assert the receive timeout "interrupt".
-                //
-                psUART->ui16IntStatus |= SOFTUART_INT_RT;
-
-                //
-                // Tell the caller that the receive timer can be disabled.
-                //
-                ui32Ret = SOFTUART_RXTIMER_END;
-            }
-
-            //
-            // This state has been handled.
-            //
-            break;
+            psUART->ui8RxLevel = 1;
+            return(0);
         }
+
+        //
+        // This falling edge is a start bit, so start a new frame.  The bit
+        // counter is set to a marker value until the start bit has been
+        // consumed.
+        //
+        psUART->ui16RxFrame = 0;
+        psUART->ui8RxBits = 0xff;
+        psUART->ui8RxFlags = ((psUART->ui8RxFlags & SOFTUART_RXFLAG_OE) |
+                              SOFTUART_RXFLAG_BE);
+        psUART->ui8RxState = SOFTUART_RXSTATE_SHIFT;
+        psUART->ui32RxFrameStart = ui32Time;
     }
 
+    //
+    // Remember the time and new level of the line.
+    //
+    psUART->ui32RxEdgeTime = ui32Time;
+    psUART->ui8RxLevel ^= 1;
+
     //
     // Call the "interrupt" callback while there are enabled "interrupts"
-    // asserted.  By calling in a loop until the "interrupts" are no longer
-    // asserted, this mimics the behavior of a real hardware implementation of
-    // the UART peripheral.
+    // asserted.
     //
     while(((psUART->ui16IntStatus & psUART->ui16IntMask) != 0) &&
           (psUART->pfnIntCallback != 0))
     {
-        //
-        // Call the callback function.
-        //
         psUART->pfnIntCallback();
     }
 
     //
-    // Return to the caller.
+    // Tell the caller how long it is until the character ends, which is
+    // halfway through its last stop bit.
     //
-    return(ui32Ret);
+    return((psUART->ui32RxFrameStart +
+            ((((psUART->ui8FrameBits * 2) + 1) * psUART->ui32RxBitTime) / 2)) -
+           ui32Time);
+}
+
+//*****************************************************************************
+//
+//! Completes a character in edge-timestamp reception mode.
+//!
+//! \param psUART specifies the SoftUART data structure.
+//!
+//! This function must be called once the delay returned by the last call to
+//! SoftUARTRxEdge() has elapsed, unless another edge has occurred in the
+//! meantime.  Any bits of the current character which have not been accounted
+//! for by an edge are taken from the current level of the line and the
+//! character is decoded and placed into the receive buffer.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SoftUARTRxFrameEnd(tSoftUART *psUART)
+{
+    //
+    // Nothing to do if the character was already completed by an edge.
+    //
+    if(psUART->ui8RxState != SOFTUART_RXSTATE_SHIFT)
+    {
+        return;
+    }
+
+    //
+    // The line has held its level since the last edge, so the rest of the
+    // frame is made of that level.
+    //
+    if(psUART->ui8RxBits == 0xff)
+    {
+        psUART->ui8RxBits = 0;
+    }
+    if(psUART->ui8RxLevel)
+    {
+        psUART->ui16RxFrame |= (0xffff << psUART->ui8RxBits);
+    }
+    psUART->ui8RxBits = psUART->ui8FrameBits;
+
+    //
+    // Decode and store the character.
+    //
+    SoftUARTRxFrameComplete(psUART);
+
+    //
+    // Call the "interrupt" callback while there are enabled "interrupts"
+    // asserted.
+    //
+    while(((psUART->ui16IntStatus & psUART->ui16IntMask) != 0) &&
+          (psUART->pfnIntCallback != 0))
+    {
+        psUART->pfnIntCallback();
+    }
 }
 
 //*****************************************************************************
@@ -1486,7 +1344,8 @@ SoftUARTParityModeSet(tSoftUART *psUART, uint32_t ui32Parity)
     // Set the parity mode.
     //
     psUART->ui16Config =
-        (psUART->ui16Config & SOFTUART_CONFIG_PAR_MASK) | ui32Parity;
+        (psUART->ui16Config & ~(SOFTUART_CONFIG_PAR_MASK)) | ui32Parity;
+    SoftUARTFrameBitsSet(psUART);
 }
 
 //*****************************************************************************
@@ -2583,6 +2442,343 @@ SoftUARTRxBufferSet(tSoftUART *psUART, uint16_t *pui16RxBuffer,
     SoftUARTRxLevelSet(psUART);
 }
 
+//*****************************************************************************
+//
+//! Initializes a group of SoftUARTs that are serviced by a single timer.
+//!
+//! \param psGroup specifies the SoftUART group data structure.
+//! \param ppsUARTs is an array of pointers to the SoftUART data structures in
+//! the group.
+//! \param ui32NumUARTs is the number of SoftUARTs in the group.
+//! \param ui32RxOversample is the number of times per bit that
+//! SoftUARTGroupRxTick() is called.
+//!
+//! This function groups together several SoftUARTs which share a baud rate so
+//! that they can all be serviced from one timer interrupt, rather than
+//! requiring a timer per SoftUART.  Each SoftUART must have been fully
+//! configured (including its GPIOs, buffers and SoftUARTConfigSet()) before
+//! this function is called.
+//!
+//! The Tx pins of all SoftUARTs that share a GPIO port are updated with a
+//! single masked write to the port's data register by
+//! SoftUARTGroupTxTimerTick(), so all channels change state at the same
+//! instant.  At most \b SOFTUART_GROUP_MAX_TX_PORTS distinct ports may be used
+//! for Tx pins.
+//!
+//! Since characters arrive on each Rx pin at unrelated times, reception polls
+//! the Rx pins at \e ui32RxOversample times the baud rate and samples each
+//! channel in the middle of its bits.  The GPIO edge interrupts used by
+//! SoftUARTRxTick() are disabled for all SoftUARTs in the group.  A value of
+//! 4 or more for \e ui32RxOversample is recommended.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SoftUARTGroupInit(tSoftUARTGroup *psGroup, tSoftUART **ppsUARTs,
+                  uint32_t ui32NumUARTs, uint32_t ui32RxOversample)
+{
+    uint32_t ui32Idx, ui32Port, ui32Base;
+    tSoftUART *psUART;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psGroup);
+    ASSERT(ppsUARTs);
+    ASSERT(ui32NumUARTs <= SOFTUART_GROUP_MAX_UARTS);
+    ASSERT(ui32RxOversample != 0);
+
+    //
+    // Save the group members.
+    //
+    psGroup->ppsUARTs = ppsUARTs;
+    psGroup->ui32NumUARTs = ui32NumUARTs;
+    psGroup->ui32RxOversample = ui32RxOversample;
+    psGroup->ui32NumTxPorts = 0;
+
+    //
+    // Loop through the SoftUARTs in the group.
+    //
+    for(ui32Idx = 0; ui32Idx < ui32NumUARTs; ui32Idx++)
+    {
+        psUART = ppsUARTs[ui32Idx];
+
+        //
+        // Find the Tx port for this SoftUART in the list of ports, adding it
+        // if this is the first SoftUART to use it.  The port address is kept
+        // with the pin masks of all SoftUARTs on the port merged into it.
+        //
+        if(psUART->ui32TxGPIO != 0)
+        {
+            ui32Base = psUART->ui32TxGPIO & 0xfffff000;
+            for(ui32Port = 0; ui32Port < psGroup->ui32NumTxPorts; ui32Port++)
+            {
+                if((psGroup->pui32TxPortAddr[ui32Port] & 0xfffff000) ==
+                   ui32Base)
+                {
+                    break;
+                }
+            }
+            if(ui32Port == psGroup->ui32NumTxPorts)
+            {
+                ASSERT(ui32Port < SOFTUART_GROUP_MAX_TX_PORTS);
+                psGroup->pui32TxPortAddr[ui32Port] = ui32Base;
+                psGroup->ui32NumTxPorts++;
+            }
+            psGroup->pui32TxPortAddr[ui32Port] |=
+                psUART->ui32TxGPIO & 0x00000fff;
+            psGroup->pui8TxPort[ui32Idx] = ui32Port;
+        }
+
+        //
+        // Reception is polled, so the Rx edge interrupt is not needed.
+        //
+        if(psUART->ui32RxGPIOPort != 0)
+        {
+            GPIOIntDisable(psUART->ui32RxGPIOPort, psUART->ui8RxPin);
+            psUART->ui8RxState = SOFTUART_RXSTATE_IDLE;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! Performs the periodic update of the transmitters in a SoftUART group.
+//!
+//! \param psGroup specifies the SoftUART group data structure.
+//!
+//! This function performs the same processing as SoftUARTTxTimerTick() for
+//! every SoftUART in the group.  The new state of the Tx pins of all
+//! SoftUARTs sharing a GPIO port is written with a single access to the
+//! port.
+//!
+//! This function must be called at the baud rate shared by the group.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SoftUARTGroupTxTimerTick(tSoftUARTGroup *psGroup)
+{
+    uint32_t pui32Value[SOFTUART_GROUP_MAX_TX_PORTS];
+    uint32_t ui32Idx;
+    tSoftUART *psUART;
+
+    //
+    // Gather the values to be written to each port from the values computed
+    // for each SoftUART on the previous tick.  The pin mask of each SoftUART
+    // is held in bits 9:2 of its Tx GPIO address.
+    //
+    for(ui32Idx = 0; ui32Idx < psGroup->ui32NumTxPorts; ui32Idx++)
+    {
+        pui32Value[ui32Idx] = 0;
+    }
+    for(ui32Idx = 0; ui32Idx < psGroup->ui32NumUARTs; ui32Idx++)
+    {
+        psUART = psGroup->ppsUARTs[ui32Idx];
+
+        //
+        // Skip SoftUARTs that do not transmit, since they have no Tx port.
+        //
+        if(psUART->ui32TxGPIO == 0)
+        {
+            continue;
+        }
+        pui32Value[psGroup->pui8TxPort[ui32Idx]] |=
+            psUART->ui8TxNext & ((psUART->ui32TxGPIO & 0x3fc) >> 2);
+    }
+
+    //
+    // Write all of the Tx pins on each port at once.
+    //
+    for(ui32Idx = 0; ui32Idx < psGroup->ui32NumTxPorts; ui32Idx++)
+    {
+        HWREG(psGroup->pui32TxPortAddr[ui32Idx]) = pui32Value[ui32Idx];
+    }
+
+    //
+    // Compute the next value for each SoftUART.
+    //
+    for(ui32Idx = 0; ui32Idx < psGroup->ui32NumUARTs; ui32Idx++)
+    {
+        psUART = psGroup->ppsUARTs[ui32Idx];
+
+        //
+        // In the common case, a character frame is being shifted out so
+        // simply stage the next bit of the frame.
+        //
+        if(psUART->ui8TxBits != 0)
+        {
+            psUART->ui8TxNext = (psUART->ui16TxFrame & 1) ? 255 : 0;
+            psUART->ui16TxFrame >>= 1;
+            psUART->ui8TxBits--;
+        }
+        else if(psUART->ui32TxGPIO != 0)
+        {
+            SoftUARTTxFrameNext(psUART);
+        }
+    }
+}
+
+//*****************************************************************************
+//
+//! Performs the periodic update of the receivers in a SoftUART group.
+//!
+//! \param psGroup specifies the SoftUART group data structure.
+//!
+//! This function polls the Rx pins of all SoftUARTs in the group.  A start bit
+//! is detected as a low level on an idle Rx pin and the rest of the character
+//! is then sampled in the middle of each bit.  Each character is decoded once
+//! all of its bits have been received, as for SoftUARTRxTick().  Rx pins that
+//! share a GPIO port with the preceding SoftUART in the group are read with a
+//! single access.
+//!
+//! This function must be called at the baud rate shared by the group
+//! multiplied by the oversampling factor passed to SoftUARTGroupInit().
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+SoftUARTGroupRxTick(tSoftUARTGroup *psGroup)
+{
+    uint32_t ui32Idx, ui32Port, ui32Data, ui32Oversample;
+    tSoftUART *psUART;
+
+    //
+    // Loop through the SoftUARTs in the group.
+    //
+    ui32Port = 0;
+    ui32Data = 0;
+    ui32Oversample = psGroup->ui32RxOversample;
+    for(ui32Idx = 0; ui32Idx < psGroup->ui32NumUARTs; ui32Idx++)
+    {
+        psUART = psGroup->ppsUARTs[ui32Idx];
+
+        //
+        // Skip SoftUARTs that do not receive.
+        //
+        if(psUART->ui32RxGPIOPort == 0)
+        {
+            continue;
+        }
+
+        //
+        // Read the Rx port, unless it has already been read for the previous
+        // SoftUART.
+        //
+        if(psUART->ui32RxGPIOPort != ui32Port)
+        {
+            ui32Port = psUART->ui32RxGPIOPort;
+            ui32Data = HWREG(ui32Port + GPIO_O_DATA + (0xff << 2));
+        }
+
+        //
+        // See if a character is being received.
+        //
+        if(psUART->ui8RxState == SOFTUART_RXSTATE_SHIFT)
+        {
+            //
+            // Wait for the middle of the next bit.
+            //
+            if(--psUART->ui8RxPhase != 0)
+            {
+                continue;
+            }
+            psUART->ui8RxPhase = ui32Oversample;
+
+            //
+            // Shift in this bit.
+            //
+            if(ui32Data & psUART->ui8RxPin)
+            {
+                psUART->ui16RxFrame |= 1 << psUART->ui8RxBits;
+            }
+
+            //
+            // Decode the character once the whole frame has been received
+            // and start timing the receive timeout.  If the stop bit was low
+            // (a break or a framing error), the line must first return high.
+            //
+            if(++psUART->ui8RxBits == psUART->ui8FrameBits)
+            {
+                SoftUARTRxFrameComplete(psUART);
+                psUART->ui8RxData = 0;
+                psUART->ui8RxState = ((ui32Data & psUART->ui8RxPin) ?
+                                      SOFTUART_RXSTATE_DELAY :
+                                      SOFTUART_RXSTATE_BREAK);
+            }
+        }
+
+        //
+        // Otherwise, after a break or a low stop bit, wait for the line to
+        // go idle before looking for the next start bit.  This matches the
+        // falling edge interrupt used by a single SoftUART, which does not
+        // see a line that is held low as a new start bit.
+        //
+        else if(psUART->ui8RxState == SOFTUART_RXSTATE_BREAK)
+        {
+            if(ui32Data & psUART->ui8RxPin)
+            {
+                psUART->ui8RxPhase = ui32Oversample;
+                psUART->ui8RxState = SOFTUART_RXSTATE_DELAY;
+            }
+        }
+
+        //
+        // Otherwise, see if this is the start bit of a new character.
+        //
+        else if(!(ui32Data & psUART->ui8RxPin))
+        {
+            //
+            // Clear the receive frame and set the break error (which is
+            // cleared if any non-zero bits are read during this character).
+            //
+            psUART->ui16RxFrame = 0;
+            psUART->ui8RxBits = 0;
+            psUART->ui8RxFlags = ((psUART->ui8RxFlags & SOFTUART_RXFLAG_OE) |
+                                  SOFTUART_RXFLAG_BE);
+
+            //
+            // The start bit began at some point since the last poll, so the
+            // middle of the first data bit is one and a half bits from now.
+            //
+            psUART->ui8RxPhase = ui32Oversample + (ui32Oversample / 2);
+            psUART->ui8RxState = SOFTUART_RXSTATE_SHIFT;
+        }
+
+        //
+        // Otherwise, count bit times until the receive timeout.
+        //
+        else if(psUART->ui8RxState == SOFTUART_RXSTATE_DELAY)
+        {
+            if(--psUART->ui8RxPhase == 0)
+            {
+                psUART->ui8RxPhase = ui32Oversample;
+                if(psUART->ui8RxData++ == 32)
+                {
+                    //
+                    // Assert the receive timeout "interrupt".
+                    //
+                    psUART->ui16IntStatus |= SOFTUART_INT_RT;
+                    psUART->ui8RxState = SOFTUART_RXSTATE_IDLE;
+                }
+            }
+        }
+
+        //
+        // Call the "interrupt" callback while there are enabled "interrupts"
+        // asserted.
+        //
+        while(((psUART->ui16IntStatus & psUART->ui16IntMask) != 0) &&
+              (psUART->pfnIntCallback != 0))
+        {
+            psUART->pfnIntCallback();
+        }
+    }
+}
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
@@ -73,6 +73,26 @@ typedef struct
     //
     uint32_t ui32RxGPIOPort;
 
+    //
+    //! The duration of one bit in edge-timestamp reception mode.  This member
+    //! can be set using the SoftUARTRxBitTimeSet function.
+    //
+    uint32_t ui32RxBitTime;
+
+    //
+    //! The time of the last edge on the Rx pin in edge-timestamp reception
+    //! mode.  This member should not be accessed or modified by the
+    //! application.
+    //
+    uint32_t ui32RxEdgeTime;
+
+    //
+    //! The time of the start bit of the character currently being received
+    //! in edge-timestamp reception mode.  This member should not be accessed
+    //! or modified by the application.
+    //
+    uint32_t ui32RxFrameStart;
+
     //
     //! The address of the data buffer used for the transmit buffer.  This
     //! member can be set via a direct structure access or using the
@@ -158,6 +178,20 @@ typedef struct
     //
     uint16_t ui16Config;
 
+    //
+    //! The remaining bits of the character frame that is currently being
+    //! shifted out via the Tx pin, LSB first.  This member should not be
+    //! accessed or modified by the application.
+    //
+    uint16_t ui16TxFrame;
+
+    //
+    //! The bits of the character frame that is currently being received via
+    //! the Rx pin, LSB first and excluding the start bit.  This member should
+    //! not be accessed or modified by the application.
+    //
+    uint16_t ui16RxFrame;
+
     //
     //! The flags that control the operation of the SoftUART module.  This
     //! member should not be be accessed or modified by the application.
@@ -178,10 +212,17 @@ typedef struct
     uint8_t ui8TxNext;
 
     //
-    //! The character that is currently be sent via the Tx pin.  This member
-    //! should not be accessed or modified by the application.
+    //! The number of bits of ui16TxFrame that remain to be shifted out.  This
+    //! member should not be accessed or modified by the application.
     //
-    uint8_t ui8TxData;
+    uint8_t ui8TxBits;
+
+    //
+    //! The number of bits that follow the start bit in each character frame
+    //! for the current configuration.  This member should not be accessed or
+    //! modified by the application.
+    //
+    uint8_t ui8FrameBits;
 
     //
     //! The GPIO pin to be used for the Rx signal.  This member can be set via
@@ -201,6 +242,26 @@ typedef struct
     //
     uint8_t ui8RxData;
 
+    //
+    //! The number of bits of ui16RxFrame that have been received.  This
+    //! member should not be accessed or modified by the application.
+    //
+    uint8_t ui8RxBits;
+
+    //
+    //! The level of the Rx pin following the last edge in edge-timestamp
+    //! reception mode.  This member should not be accessed or modified by the
+    //! application.
+    //
+    uint8_t ui8RxLevel;
+
+    //
+    //! The number of group receive ticks until the next bit is sampled when
+    //! the SoftUART is part of a tSoftUARTGroup.  This member should not be
+    //! accessed or modified by the application.
+    //
+    uint8_t ui8RxPhase;
+
     //
     //! The flags that indicate any errors that have occurred during the
     //! reception of the current character via the Rx pin.  This member should
@@ -216,6 +277,71 @@ typedef struct
 }
 tSoftUART;
 
+//*****************************************************************************
+//
+//! The maximum number of SoftUARTs in a tSoftUARTGroup.
+//
+//*****************************************************************************
+#ifndef SOFTUART_GROUP_MAX_UARTS
+#define SOFTUART_GROUP_MAX_UARTS 8
+#endif
+
+//*****************************************************************************
+//
+//! The maximum number of distinct GPIO ports that may be used for the Tx pins
+//! of the SoftUARTs in a tSoftUARTGroup.
+//
+//*****************************************************************************
+#ifndef SOFTUART_GROUP_MAX_TX_PORTS
+#define SOFTUART_GROUP_MAX_TX_PORTS 4
+#endif
+
+//*****************************************************************************
+//
+//! This structure contains the state of a group of SoftUARTs which share a
+//! baud rate and are serviced by a single timer.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    //! The SoftUARTs in the group.  This member is set by SoftUARTGroupInit.
+    //
+    tSoftUART **ppsUARTs;
+
+    //
+    //! The number of SoftUARTs in the group.  This member is set by
+    //! SoftUARTGroupInit.
+    //
+    uint32_t ui32NumUARTs;
+
+    //
+    //! The number of times per bit that SoftUARTGroupRxTick is called.  This
+    //! member is set by SoftUARTGroupInit.
+    //
+    uint32_t ui32RxOversample;
+
+    //
+    //! The number of distinct GPIO ports used for Tx pins.  This member
+    //! should not be accessed or modified by the application.
+    //
+    uint32_t ui32NumTxPorts;
+
+    //
+    //! The masked data register address of each Tx port, covering the Tx
+    //! pins of all SoftUARTs on that port.  This member should not be
+    //! accessed or modified by the application.
+    //
+    uint32_t pui32TxPortAddr[SOFTUART_GROUP_MAX_TX_PORTS];
+
+    //
+    //! The index into pui32TxPortAddr of the Tx port of each SoftUART.  This
+    //! member should not be accessed or modified by the application.
+    //
+    uint8_t pui8TxPort[SOFTUART_GROUP_MAX_UARTS];
+}
+tSoftUARTGroup;
+
 //*****************************************************************************
 //
 // Close the Doxygen group.
@@ -350,6 +476,9 @@ extern void SoftUARTIntClear(tSoftUART *psUART, uint32_t ui32IntFlags);
 extern uint32_t SoftUARTRxErrorGet(tSoftUART *psUART);
 extern void SoftUARTRxErrorClear(tSoftUART *psUART);
 extern uint32_t SoftUARTRxTick(tSoftUART *psUART, bool bEdgeInt);
+extern void SoftUARTRxBitTimeSet(tSoftUART *psUART, uint32_t ui32BitTime);
+extern uint32_t SoftUARTRxEdge(tSoftUART *psUART, uint32_t ui32Time);
+extern void SoftUARTRxFrameEnd(tSoftUART *psUART);
 extern void SoftUARTTxIntModeSet(tSoftUART *psUART, uint32_t ui32Mode);
 extern uint32_t SoftUARTTxIntModeGet(tSoftUART *psUART);
 extern void SoftUARTTxTimerTick(tSoftUART *psUART);
@@ -362,6 +491,11 @@ extern void SoftUARTTxBufferSet(tSoftUART *psUART, uint8_t *pui8TxBuffer,
                                 uint16_t ui16Len);
 extern void SoftUARTRxBufferSet(tSoftUART *psUART, uint16_t *pui16RxBuffer,
                                 uint16_t ui16Len);
+extern void SoftUARTGroupInit(tSoftUARTGroup *psGroup, tSoftUART **ppsUARTs,
+                              uint32_t ui32NumUARTs,
+                              uint32_t ui32RxOversample);
+extern void SoftUARTGroupTxTimerTick(tSoftUARTGroup *psGroup);
+extern void SoftUARTGroupRxTick(tSoftUARTGroup *psGroup);
 
 //*****************************************************************************
 //
@@ -24,6 +24,8 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #include "inc/hw_types.h"
 #include "driverlib/sysctl.h"
 #include "third_party/speex-1.2rc1/include/speex/speex.h"
@@ -83,6 +85,225 @@ tSpeexInstance;
 //*****************************************************************************
 tSpeexInstance g_sSpeexDecoder, g_sSpeexEncoder;
 
+//*****************************************************************************
+//
+// A slot in a decoder's jitter buffer, holding one received packet.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The packet data, which is allocated from the channel's arena.
+    //
+    uint8_t *pui8Data;
+
+    //
+    // The sequence number of the packet held in this slot.
+    //
+    uint16_t ui16Seq;
+
+    //
+    // The size of the packet in bytes, or zero if the slot is empty.
+    //
+    uint16_t ui16Size;
+}
+tSpeexJitterSlot;
+
+//*****************************************************************************
+//
+// The state of an encoder or decoder channel that is created in a
+// caller-supplied arena.  This structure is placed at the start of the arena
+// and the handle returned to the caller points to it.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // Holds the state of the encoder or decoder.
+    //
+    void *pvState;
+
+    //
+    // Holds bits so they can be read and written to by the Speex routines.
+    // The bit buffer is allocated from the arena and never grows.
+    //
+    SpeexBits sBits;
+
+    //
+    // The number of samples in a frame.
+    //
+    int iFrameSize;
+
+    //
+    // The arena that holds this channel.
+    //
+    uint8_t *pui8Arena;
+    uint32_t ui32ArenaSize;
+    uint32_t ui32ArenaUsed;
+
+    //
+    // The jitter buffer slots, or 0 if there is no jitter buffer.
+    //
+    tSpeexJitterSlot *psSlots;
+
+    //
+    // The number of jitter buffer slots, which is a power of two.
+    //
+    uint16_t ui16NumSlots;
+
+    //
+    // The largest packet that can be held in a jitter buffer slot.
+    //
+    uint16_t ui16MaxPacket;
+
+    //
+    // The sequence number of the next packet to be played.
+    //
+    uint16_t ui16NextSeq;
+
+    //
+    // The number of jitter buffer slots that hold packets.
+    //
+    uint16_t ui16Buffered;
+
+    //
+    // The number of frames in the last packet that was decoded, used to
+    // size the concealment for a lost packet.
+    //
+    uint16_t ui16PacketFrames;
+
+    //
+    // Non-zero once the jitter buffer has filled to its playout depth.
+    //
+    uint8_t ui8Playing;
+}
+tSpeexChannel;
+
+//*****************************************************************************
+//
+// The channel whose arena satisfies Speex allocations.  This is only set
+// while a channel is being created; at all other times allocations come from
+// the C heap, as they do for the single-instance encoder and decoder.
+//
+//*****************************************************************************
+static tSpeexChannel *g_psSpeexArenaChannel;
+
+//*****************************************************************************
+//
+// Allocates zeroed memory from the arena of the channel being created.  This
+// returns 0 if the arena does not have enough space left.
+//
+//*****************************************************************************
+static void *
+SpeexArenaAlloc(tSpeexChannel *psChannel, uint32_t ui32Size)
+{
+    void *pvMem;
+
+    //
+    // Keep all allocations eight byte aligned.
+    //
+    ui32Size = (ui32Size + 7) & ~7;
+
+    //
+    // Fail the allocation if the arena is exhausted.
+    //
+    if(ui32Size > (psChannel->ui32ArenaSize - psChannel->ui32ArenaUsed))
+    {
+        return(0);
+    }
+
+    pvMem = psChannel->pui8Arena + psChannel->ui32ArenaUsed;
+    psChannel->ui32ArenaUsed += ui32Size;
+    memset(pvMem, 0, ui32Size);
+
+    return(pvMem);
+}
+
+//*****************************************************************************
+//
+// The Speex memory allocation hooks.  These are used when the Speex library
+// is built with OVERRIDE_SPEEX_ALLOC, which allows the state of each channel
+// to be placed in its arena rather than on the heap.  Arena memory is never
+// freed individually; the whole arena is discarded with the channel.
+//
+//*****************************************************************************
+void *
+speex_alloc(int iSize)
+{
+    if(g_psSpeexArenaChannel)
+    {
+        return(SpeexArenaAlloc(g_psSpeexArenaChannel, iSize));
+    }
+    return(calloc(iSize, 1));
+}
+
+void *
+speex_alloc_scratch(int iSize)
+{
+    return(speex_alloc(iSize));
+}
+
+void *
+speex_realloc(void *pvPtr, int iSize)
+{
+    //
+    // Arena allocations cannot grow.  Speex only reallocates bit buffers that
+    // it owns, and the channels always supply their own.
+    //
+    if(g_psSpeexArenaChannel)
+    {
+        return(0);
+    }
+    return(realloc(pvPtr, iSize));
+}
+
+void
+speex_free(void *pvPtr)
+{
+    if(!g_psSpeexArenaChannel)
+    {
+        free(pvPtr);
+    }
+}
+
+void
+speex_free_scratch(void *pvPtr)
+{
+    speex_free(pvPtr);
+}
+
+//*****************************************************************************
+//
+// Places a channel structure at the start of an arena.
+//
+//*****************************************************************************
+static tSpeexChannel *
+SpeexChannelAlloc(void *pvArena, uint32_t ui32ArenaSize)
+{
+    tSpeexChannel *psChannel;
+    uint32_t ui32Align;
+
+    //
+    // Align the start of the arena.
+    //
+    ui32Align = (8 - ((uint32_t)pvArena & 7)) & 7;
+    if(ui32ArenaSize < (ui32Align + sizeof(tSpeexChannel)))
+    {
+        return(0);
+    }
+    psChannel = (tSpeexChannel *)((uint8_t *)pvArena + ui32Align);
+    memset(psChannel, 0, sizeof(tSpeexChannel));
+
+    //
+    // The rest of the arena is used for allocations.
+    //
+    psChannel->pui8Arena = (uint8_t *)psChannel;
+    psChannel->ui32ArenaSize = ui32ArenaSize - ui32Align;
+    psChannel->ui32ArenaUsed = (sizeof(tSpeexChannel) + 7) & ~7;
+
+    return(psChannel);
+}
+
 //*****************************************************************************
 //
 //! Initialize the decoder's state to prepare for decoding new frames.
@@ -350,6 +571,521 @@ SpeexEncode(int16_t *pui16InBuffer, uint32_t ui32InSize,
     return(i32Bytes);
 }
 
+//*****************************************************************************
+//
+//! Creates a Speex encoder in a caller-supplied block of memory.
+//!
+//! \param pvArena is the memory that holds all state for the encoder.
+//! \param ui32ArenaSize is the size of \e pvArena in bytes.
+//! \param iSampleRate is the sample rate of the incoming audio.
+//! \param iComplexity is the complexity setting for the encoder.
+//! \param iQuality is the quality setting for the encoder.
+//! \param ui32MaxPacket is the largest packet, in bytes, that
+//! SpeexEncodeFrames() will be asked to produce.
+//!
+//! This function creates a narrow band encoder whose state is held entirely
+//! in \e pvArena, so any number of independent channels can be created with
+//! a fixed memory budget.  SpeexChannelArenaUsedGet() reports how much of the
+//! arena was needed, which can be used to size arenas for a given build.
+//!
+//! \note The encoder state is only placed in the arena if the Speex library
+//! is built with OVERRIDE_SPEEX_ALLOC defined, which the projects in this
+//! tree do not do.  Without it the state comes from the C heap, and only the
+//! channel structure and the bit buffer use the arena.
+//!
+//! \return Returns a handle to the encoder or 0 if \e ui32ArenaSize is too
+//! small or the encoder state could not be allocated.
+//
+//*****************************************************************************
+void *
+SpeexEncoderCreate(void *pvArena, uint32_t ui32ArenaSize, int iSampleRate,
+                   int iComplexity, int iQuality, uint32_t ui32MaxPacket)
+{
+    tSpeexChannel *psChannel;
+    void *pvBuffer;
+
+    psChannel = SpeexChannelAlloc(pvArena, ui32ArenaSize);
+    if(psChannel == 0)
+    {
+        return(0);
+    }
+
+    //
+    // Create a new encoder state in narrow band mode, directing its
+    // allocations to the arena.
+    //
+    g_psSpeexArenaChannel = psChannel;
+    psChannel->pvState = speex_encoder_init(speex_lib_get_mode(
+                                                SPEEX_MODEID_NB));
+    if(psChannel->pvState == 0)
+    {
+        g_psSpeexArenaChannel = 0;
+        return(0);
+    }
+
+    //
+    // Use a fixed bit buffer from the arena.
+    //
+    pvBuffer = SpeexArenaAlloc(psChannel, ui32MaxPacket);
+    if(pvBuffer == 0)
+    {
+        //
+        // Release the encoder state while the arena is still selected so
+        // that only state on the heap is freed.
+        //
+        speex_encoder_destroy(psChannel->pvState);
+        g_psSpeexArenaChannel = 0;
+        return(0);
+    }
+    speex_bits_init_buffer(&psChannel->sBits, pvBuffer, ui32MaxPacket);
+    g_psSpeexArenaChannel = 0;
+
+    //
+    // Set the quality, complexity and sample rate for the encoder.
+    //
+    speex_encoder_ctl(psChannel->pvState, SPEEX_SET_QUALITY, &iQuality);
+    speex_encoder_ctl(psChannel->pvState, SPEEX_SET_COMPLEXITY, &iComplexity);
+    speex_encoder_ctl(psChannel->pvState, SPEEX_SET_SAMPLING_RATE,
+                      &iSampleRate);
+    speex_encoder_ctl(psChannel->pvState, SPEEX_GET_FRAME_SIZE,
+                      &psChannel->iFrameSize);
+
+    return(psChannel);
+}
+
+//*****************************************************************************
+//
+//! Creates a Speex decoder in a caller-supplied block of memory.
+//!
+//! \param pvArena is the memory that holds all state for the decoder.
+//! \param ui32ArenaSize is the size of \e pvArena in bytes.
+//! \param ui32MaxPacket is the largest packet, in bytes, that will be passed
+//! to SpeexDecodeFrames() or SpeexJitterPut().
+//! \param ui32JitterSlots is the number of packets that the jitter buffer
+//! can hold, which must be a power of two, or zero if SpeexJitterPut() and
+//! SpeexJitterGet() are not used.
+//!
+//! This function creates a narrow band decoder whose state is held entirely
+//! in \e pvArena, along with its bit buffer and jitter buffer.
+//!
+//! \note As for SpeexEncoderCreate(), the decoder state is only placed in the
+//! arena if the Speex library is built with OVERRIDE_SPEEX_ALLOC defined,
+//! which the projects in this tree do not do; otherwise it comes from the C
+//! heap.
+//!
+//! \return Returns a handle to the decoder or 0 if \e ui32ArenaSize is too
+//! small or the decoder state could not be allocated.
+//
+//*****************************************************************************
+void *
+SpeexDecoderCreate(void *pvArena, uint32_t ui32ArenaSize,
+                   uint32_t ui32MaxPacket, uint32_t ui32JitterSlots)
+{
+    tSpeexChannel *psChannel;
+    uint32_t ui32Idx;
+    void *pvBuffer;
+    int iTemp;
+
+    ASSERT((ui32JitterSlots & (ui32JitterSlots - 1)) == 0);
+    ASSERT(ui32MaxPacket <= 0xffff);
+
+    psChannel = SpeexChannelAlloc(pvArena, ui32ArenaSize);
+    if(psChannel == 0)
+    {
+        return(0);
+    }
+
+    //
+    // Create a new decoder state in narrow band mode, directing its
+    // allocations to the arena.
+    //
+    g_psSpeexArenaChannel = psChannel;
+    psChannel->pvState = speex_decoder_init(&speex_nb_mode);
+    if(psChannel->pvState == 0)
+    {
+        g_psSpeexArenaChannel = 0;
+        return(0);
+    }
+
+    //
+    // Use a fixed bit buffer from the arena.
+    //
+    pvBuffer = SpeexArenaAlloc(psChannel, ui32MaxPacket);
+    if(pvBuffer == 0)
+    {
+        goto fail;
+    }
+    speex_bits_init_buffer(&psChannel->sBits, pvBuffer, ui32MaxPacket);
+
+    //
+    // Allocate the jitter buffer slots.
+    //
+    if(ui32JitterSlots)
+    {
+        psChannel->psSlots = SpeexArenaAlloc(psChannel,
+                                             (sizeof(tSpeexJitterSlot) *
+                                              ui32JitterSlots));
+        if(psChannel->psSlots == 0)
+        {
+            goto fail;
+        }
+        for(ui32Idx = 0; ui32Idx < ui32JitterSlots; ui32Idx++)
+        {
+            psChannel->psSlots[ui32Idx].pui8Data =
+                SpeexArenaAlloc(psChannel, ui32MaxPacket);
+            if(psChannel->psSlots[ui32Idx].pui8Data == 0)
+            {
+                goto fail;
+            }
+        }
+    }
+    g_psSpeexArenaChannel = 0;
+
+    psChannel->ui16NumSlots = ui32JitterSlots;
+    psChannel->ui16MaxPacket = ui32MaxPacket;
+    psChannel->ui16PacketFrames = 1;
+
+    //
+    // Disable enhanced decoding to reduce processing requirements.
+    //
+    iTemp = 0;
+    speex_decoder_ctl(psChannel->pvState, SPEEX_SET_ENH, &iTemp);
+    speex_decoder_ctl(psChannel->pvState, SPEEX_GET_FRAME_SIZE,
+                      &psChannel->iFrameSize);
+
+    return(psChannel);
+
+fail:
+    //
+    // The arena is too small.  Release the decoder state while the arena is
+    // still selected so that only state on the heap is freed.
+    //
+    speex_decoder_destroy(psChannel->pvState);
+    g_psSpeexArenaChannel = 0;
+
+    return(0);
+}
+
+//*****************************************************************************
+//
+//! Sets the quality setting of an encoder channel.
+//!
+//! \param pvEncoder is the handle returned by SpeexEncoderCreate().
+//! \param iQuality is the new quality setting.
+//!
+//! \return This function returns 0.
+//
+//*****************************************************************************
+int32_t
+SpeexEncoderQualitySet(void *pvEncoder, int iQuality)
+{
+    tSpeexChannel *psChannel;
+
+    psChannel = (tSpeexChannel *)pvEncoder;
+
+    speex_encoder_ctl(psChannel->pvState, SPEEX_SET_QUALITY, &iQuality);
+
+    return(0);
+}
+
+//*****************************************************************************
+//
+//! Returns the frame size of an encoder or decoder channel.
+//!
+//! \param pvChannel is the handle of the encoder or decoder.
+//!
+//! \return The number of samples in each frame.
+//
+//*****************************************************************************
+int32_t
+SpeexChannelFrameSizeGet(void *pvChannel)
+{
+    return(((tSpeexChannel *)pvChannel)->iFrameSize);
+}
+
+//*****************************************************************************
+//
+//! Returns the amount of a channel's arena that is in use.
+//!
+//! \param pvChannel is the handle of the encoder or decoder.
+//!
+//! Since all allocations for a channel are made when it is created, this is
+//! the peak memory used by the channel.
+//!
+//! \return The number of bytes of the arena that are used.
+//
+//*****************************************************************************
+uint32_t
+SpeexChannelArenaUsedGet(void *pvChannel)
+{
+    return(((tSpeexChannel *)pvChannel)->ui32ArenaUsed);
+}
+
+//*****************************************************************************
+//
+//! Encodes several frames of audio into a single packet.
+//!
+//! \param pvEncoder is the handle returned by SpeexEncoderCreate().
+//! \param pi16In is the PCM audio, holding \e ui32NumFrames whole frames.
+//! \param ui32NumFrames is the number of frames to encode.
+//! \param pui8Out is the buffer to store the packet.
+//! \param ui32OutSize is the size of the \e pui8Out buffer.
+//!
+//! This function encodes the frames into one Speex bit stream, which is
+//! terminated and written out once, rather than paying the per-packet
+//! overhead for every frame.  The packet can be decoded with a single call to
+//! SpeexDecodeFrames().
+//!
+//! \return This function returns the number of bytes in the packet, or -1 if
+//! the packet does not fit in \e pui8Out.
+//
+//*****************************************************************************
+int32_t
+SpeexEncodeFrames(void *pvEncoder, const int16_t *pi16In,
+                  uint32_t ui32NumFrames, uint8_t *pui8Out,
+                  uint32_t ui32OutSize)
+{
+    tSpeexChannel *psChannel;
+
+    psChannel = (tSpeexChannel *)pvEncoder;
+
+    //
+    // Encode all of the frames into the bit stream.
+    //
+    speex_bits_reset(&psChannel->sBits);
+    for(; ui32NumFrames; ui32NumFrames--)
+    {
+        speex_encode_int(psChannel->pvState, (spx_int16_t *)pi16In,
+                         &psChannel->sBits);
+        pi16In += psChannel->iFrameSize;
+    }
+
+    //
+    // Mark the end of the packet so the decoder knows when to stop.
+    //
+    speex_bits_insert_terminator(&psChannel->sBits);
+
+    if(speex_bits_nbytes(&psChannel->sBits) > (int)ui32OutSize)
+    {
+        return(-1);
+    }
+
+    return(speex_bits_write(&psChannel->sBits, (char *)pui8Out,
+                            ui32OutSize));
+}
+
+//*****************************************************************************
+//
+//! Decodes all of the frames in a packet.
+//!
+//! \param pvDecoder is the handle returned by SpeexDecoderCreate().
+//! \param pui8In is the packet, or 0 if the packet was lost.
+//! \param ui32InSize is the number of bytes in the packet.
+//! \param pi16Out is the buffer to store the decoded audio.
+//! \param ui32MaxFrames is the number of frames that fit in \e pi16Out.
+//!
+//! This function decodes frames from a packet produced by
+//! SpeexEncodeFrames() until the end of the packet is reached or
+//! \e ui32MaxFrames frames have been decoded.  If \e pui8In is 0,
+//! \e ui32MaxFrames frames of packet loss concealment are produced instead.
+//!
+//! \return This function returns the number of frames decoded.
+//
+//*****************************************************************************
+int32_t
+SpeexDecodeFrames(void *pvDecoder, const uint8_t *pui8In, uint32_t ui32InSize,
+                  int16_t *pi16Out, uint32_t ui32MaxFrames)
+{
+    tSpeexChannel *psChannel;
+    uint32_t ui32Count;
+
+    psChannel = (tSpeexChannel *)pvDecoder;
+
+    //
+    // Let the decoder extrapolate from its state for a lost packet.
+    //
+    if(pui8In == 0)
+    {
+        for(ui32Count = 0; ui32Count < ui32MaxFrames; ui32Count++)
+        {
+            speex_decode_int(psChannel->pvState, 0, pi16Out);
+            pi16Out += psChannel->iFrameSize;
+        }
+        return(ui32Count);
+    }
+
+    //
+    // Read in the whole packet once.
+    //
+    speex_bits_read_from(&psChannel->sBits, (char *)pui8In, ui32InSize);
+
+    //
+    // Decode frames until the terminator or the end of the packet.
+    //
+    for(ui32Count = 0; ui32Count < ui32MaxFrames; ui32Count++)
+    {
+        if((speex_bits_remaining(&psChannel->sBits) <= 0) ||
+           (speex_decode_int(psChannel->pvState, &psChannel->sBits,
+                             pi16Out) != 0))
+        {
+            break;
+        }
+        pi16Out += psChannel->iFrameSize;
+    }
+
+    return(ui32Count);
+}
+
+//*****************************************************************************
+//
+//! Adds a received packet to a decoder's jitter buffer.
+//!
+//! \param pvDecoder is the handle returned by SpeexDecoderCreate().
+//! \param ui16Seq is the sequence number of the packet.
+//! \param pui8Packet is the packet.
+//! \param ui32Size is the number of bytes in the packet.
+//!
+//! This function stores a packet, which may arrive out of order, until it is
+//! due to be played by SpeexJitterGet().  Packets that arrive after their
+//! turn to be played, or too far ahead of it to fit in the buffer, are
+//! dropped.
+//!
+//! \return This function returns 0 if the packet was stored or -1 if it was
+//! dropped.
+//
+//*****************************************************************************
+int32_t
+SpeexJitterPut(void *pvDecoder, uint16_t ui16Seq, const uint8_t *pui8Packet,
+               uint32_t ui32Size)
+{
+    tSpeexChannel *psChannel;
+    tSpeexJitterSlot *psSlot;
+    int16_t i16Ahead;
+
+    psChannel = (tSpeexChannel *)pvDecoder;
+
+    if((ui32Size == 0) || (ui32Size > psChannel->ui16MaxPacket) ||
+       (psChannel->ui16NumSlots == 0))
+    {
+        return(-1);
+    }
+
+    //
+    // The first packet into an empty buffer sets the playout position.
+    //
+    if(!psChannel->ui8Playing && (psChannel->ui16Buffered == 0))
+    {
+        psChannel->ui16NextSeq = ui16Seq;
+    }
+
+    //
+    // Drop the packet if it is late or would overwrite an earlier one.
+    //
+    i16Ahead = (int16_t)(ui16Seq - psChannel->ui16NextSeq);
+    if((i16Ahead < 0) || (i16Ahead >= psChannel->ui16NumSlots))
+    {
+        return(-1);
+    }
+
+    //
+    // Store the packet, ignoring a duplicate.
+    //
+    psSlot = &psChannel->psSlots[ui16Seq & (psChannel->ui16NumSlots - 1)];
+    if(psSlot->ui16Size)
+    {
+        return(-1);
+    }
+    memcpy(psSlot->pui8Data, pui8Packet, ui32Size);
+    psSlot->ui16Seq = ui16Seq;
+    psSlot->ui16Size = ui32Size;
+    psChannel->ui16Buffered++;
+
+    //
+    // Start playing once the buffer is half full.
+    //
+    if(psChannel->ui16Buffered >= ((psChannel->ui16NumSlots + 1) / 2))
+    {
+        psChannel->ui8Playing = 1;
+    }
+
+    return(0);
+}
+
+//*****************************************************************************
+//
+//! Decodes the next packet from a decoder's jitter buffer.
+//!
+//! \param pvDecoder is the handle returned by SpeexDecoderCreate().
+//! \param pi16Out is the buffer to store the decoded audio.
+//! \param ui32MaxFrames is the number of frames that fit in \e pi16Out.
+//!
+//! This function should be called once per packet interval.  It decodes the
+//! packet that is due to be played, or conceals it if it has not arrived.  If
+//! the buffer runs dry, playback stops until it has refilled to half of its
+//! depth, during which time no frames are returned.
+//!
+//! \return This function returns the number of frames stored in
+//! \e pi16Out.
+//
+//*****************************************************************************
+int32_t
+SpeexJitterGet(void *pvDecoder, int16_t *pi16Out, uint32_t ui32MaxFrames)
+{
+    tSpeexChannel *psChannel;
+    tSpeexJitterSlot *psSlot;
+    int32_t i32Frames;
+
+    psChannel = (tSpeexChannel *)pvDecoder;
+
+    if(!psChannel->ui8Playing)
+    {
+        return(0);
+    }
+
+    psSlot = &psChannel->psSlots[psChannel->ui16NextSeq &
+                                 (psChannel->ui16NumSlots - 1)];
+    if(psSlot->ui16Size)
+    {
+        //
+        // Decode the packet and release its slot.
+        //
+        i32Frames = SpeexDecodeFrames(pvDecoder, psSlot->pui8Data,
+                                      psSlot->ui16Size, pi16Out,
+                                      ui32MaxFrames);
+        psSlot->ui16Size = 0;
+        psChannel->ui16Buffered--;
+        if(i32Frames)
+        {
+            psChannel->ui16PacketFrames = i32Frames;
+        }
+    }
+    else if(psChannel->ui16Buffered == 0)
+    {
+        //
+        // The buffer has run dry, so wait for it to refill.
+        //
+        psChannel->ui8Playing = 0;
+        return(0);
+    }
+    else
+    {
+        //
+        // The packet was lost, so conceal it with as many frames as the last
+        // packet held.
+        //
+        i32Frames = psChannel->ui16PacketFrames;
+        if(i32Frames > (int32_t)ui32MaxFrames)
+        {
+            i32Frames = ui32MaxFrames;
+        }
+        i32Frames = SpeexDecodeFrames(pvDecoder, 0, 0, pi16Out, i32Frames);
+    }
+
+    psChannel->ui16NextSeq++;
+
+    return(i32Frames);
+}
+
 //*****************************************************************************
 //
 // This is called by speex in the event of a fatal error.
@@ -50,6 +50,25 @@ extern int32_t SpeexDecodeFrameSizeGet(void);
 extern int32_t SpeexDecodeInit(void);
 extern int32_t SpeexDecode(uint8_t *pui8InBuffer, uint32_t ui32InSize,
                            uint8_t *pui8OutBuffer, uint32_t ui32OutSize);
+extern void *SpeexEncoderCreate(void *pvArena, uint32_t ui32ArenaSize,
+                                int iSampleRate, int iComplexity,
+                                int iQuality, uint32_t ui32MaxPacket);
+extern void *SpeexDecoderCreate(void *pvArena, uint32_t ui32ArenaSize,
+                                uint32_t ui32MaxPacket,
+                                uint32_t ui32JitterSlots);
+extern int32_t SpeexEncoderQualitySet(void *pvEncoder, int iQuality);
+extern int32_t SpeexChannelFrameSizeGet(void *pvChannel);
+extern uint32_t SpeexChannelArenaUsedGet(void *pvChannel);
+extern int32_t SpeexEncodeFrames(void *pvEncoder, const int16_t *pi16In,
+                                 uint32_t ui32NumFrames, uint8_t *pui8Out,
+                                 uint32_t ui32OutSize);
+extern int32_t SpeexDecodeFrames(void *pvDecoder, const uint8_t *pui8In,
+                                 uint32_t ui32InSize, int16_t *pi16Out,
+                                 uint32_t ui32MaxFrames);
+extern int32_t SpeexJitterPut(void *pvDecoder, uint16_t ui16Seq,
+                              const uint8_t *pui8Packet, uint32_t ui32Size);
+extern int32_t SpeexJitterGet(void *pvDecoder, int16_t *pi16Out,
+                              uint32_t ui32MaxFrames);
 
 //*****************************************************************************
 //
@@ -49,6 +49,7 @@
 #define TFTP_DATA               3
 #define TFTP_ACK                4
 #define TFTP_ERROR              5
+#define TFTP_OACK               6
 
 //*****************************************************************************
 //
@@ -57,6 +58,26 @@
 //*****************************************************************************
 #define TFTP_PORT               69
 
+//*****************************************************************************
+//
+// Flags used in the ui32Flags field of the connection structure.
+//
+//*****************************************************************************
+#define TFTP_FLAG_GET           0x00000001
+#define TFTP_FLAG_OPT_BLKSIZE   0x00000002
+#define TFTP_FLAG_OPT_WINDOW    0x00000004
+#define TFTP_FLAG_OACK_PENDING  0x00000008
+#define TFTP_FLAG_GAP_ACKED     0x00000010
+
+//*****************************************************************************
+//
+// The largest OACK packet we ever send.  This is the opcode followed by the
+// "blksize" and "windowsize" option names and their values, each terminated
+// by a zero byte.
+//
+//*****************************************************************************
+#define TFTP_OACK_MAX_LEN       (2 + 8 + 6 + 11 + 6)
+
 //*****************************************************************************
 //
 // Application connection notification callback.
@@ -64,6 +85,14 @@
 //*****************************************************************************
 static tTFTPRequest g_pfnRequest;
 
+//*****************************************************************************
+//
+// The list of currently active connections.  This is walked by TFTPTimer() to
+// handle retransmission timeouts.
+//
+//*****************************************************************************
+static tTFTPConnection *g_psConnections;
+
 //*****************************************************************************
 //
 // Close the TFTP connection and free associated resources.
@@ -72,6 +101,8 @@ static tTFTPRequest g_pfnRequest;
 static void
 TFTPClose(tTFTPConnection *psTFTP)
 {
+    tTFTPConnection **ppsLink;
+
     //
     // Tell the application we are closing the connection.
     //
@@ -80,6 +111,18 @@ TFTPClose(tTFTPConnection *psTFTP)
         psTFTP->pfnClose(psTFTP);
     }
 
+    //
+    // Remove this connection from the active list.
+    //
+    for(ppsLink = &g_psConnections; *ppsLink; ppsLink = &(*ppsLink)->psNext)
+    {
+        if(*ppsLink == psTFTP)
+        {
+            *ppsLink = psTFTP->psNext;
+            break;
+        }
+    }
+
     //
     // Close the underlying UDP connection.
     //
@@ -144,36 +187,110 @@ TFTPErrorSend(tTFTPConnection *psTFTP, tTFTPError eError)
 
 //*****************************************************************************
 //
-// Sends a TFTP data packet.
+// Sends a TFTP option acknowledgment (OACK) packet containing the values of
+// the options requested by the client that the server has accepted.
 //
 //*****************************************************************************
 static void
-TFTPDataSend(tTFTPConnection *psTFTP)
+TFTPOptionAckSend(tTFTPConnection *psTFTP)
 {
+    char pcPacket[TFTP_OACK_MAX_LEN];
     uint32_t ui32Length;
+    struct pbuf *p;
+
+    //
+    // Build the packet, starting with the opcode.
+    //
+    pcPacket[0] = (TFTP_OACK >> 8) & 0xff;
+    pcPacket[1] = TFTP_OACK & 0xff;
+    ui32Length = 2;
+
+    //
+    // Append the accepted block size if the client asked for one.  Note that
+    // usnprintf() writes the terminating zero which TFTP requires after each
+    // option string.
+    //
+    if(psTFTP->ui32Flags & TFTP_FLAG_OPT_BLKSIZE)
+    {
+        ui32Length += usnprintf(&pcPacket[ui32Length],
+                                sizeof(pcPacket) - ui32Length, "blksize") + 1;
+        ui32Length += usnprintf(&pcPacket[ui32Length],
+                                sizeof(pcPacket) - ui32Length, "%d",
+                                psTFTP->ui32BlockSize) + 1;
+    }
+
+    //
+    // Append the accepted window size if the client asked for one.
+    //
+    if(psTFTP->ui32Flags & TFTP_FLAG_OPT_WINDOW)
+    {
+        ui32Length += usnprintf(&pcPacket[ui32Length],
+                                sizeof(pcPacket) - ui32Length,
+                                "windowsize") + 1;
+        ui32Length += usnprintf(&pcPacket[ui32Length],
+                                sizeof(pcPacket) - ui32Length, "%d",
+                                psTFTP->ui32WindowSize) + 1;
+    }
+
+    //
+    // Allocate a pbuf for this packet.
+    //
+    p = pbuf_alloc(PBUF_TRANSPORT, ui32Length, PBUF_RAM);
+    if(!p)
+    {
+        return;
+    }
+
+    //
+    // Copy the packet into the pbuf and send it.
+    //
+    memcpy(p->payload, pcPacket, ui32Length);
+    udp_send(psTFTP->psPCB, p);
+
+    //
+    // Free the pbuf.
+    //
+    pbuf_free(p);
+}
+
+//*****************************************************************************
+//
+// Sends a TFTP data packet.  Returns false if the application reported an
+// error, in which case the connection has been closed and psTFTP must no
+// longer be used.
+//
+//*****************************************************************************
+static bool
+TFTPDataSend(tTFTPConnection *psTFTP)
+{
+    uint32_t ui32Length, ui32Offset;
     uint8_t *pui8Data;
     tTFTPError eError;
     struct pbuf *p;
 
     //
-    // Determine the number of bytes to place into this packet.
+    // Determine the number of bytes to place into this packet.  The last
+    // block of the file is short, possibly zero length if the file size is a
+    // multiple of the block size.
     //
-    if(psTFTP->ui32DataRemaining < (psTFTP->ui32BlockNum * TFTP_BLOCK_SIZE))
+    ui32Offset = (psTFTP->ui32BlockNum - 1) * psTFTP->ui32BlockSize;
+    if((psTFTP->ui32DataRemaining - ui32Offset) < psTFTP->ui32BlockSize)
     {
-        ui32Length = psTFTP->ui32DataRemaining & (TFTP_BLOCK_SIZE - 1);
+        ui32Length = psTFTP->ui32DataRemaining - ui32Offset;
     }
     else
     {
-        ui32Length = TFTP_BLOCK_SIZE;
+        ui32Length = psTFTP->ui32BlockSize;
     }
 
     //
-    // Allocate a pbuf for this data packet.
+    // Allocate a pbuf for this data packet.  If none is available, leave it
+    // to the retransmission timer to try again later.
     //
     p = pbuf_alloc(PBUF_TRANSPORT, ui32Length + 4, PBUF_RAM);
     if(!p)
     {
-        return;
+        return(true);
     }
 
     //
@@ -213,11 +330,49 @@ TFTPDataSend(tTFTPConnection *psTFTP)
     // Free the pbuf.
     //
     pbuf_free(p);
+
+    return(eError == TFTP_OK);
+}
+
+//*****************************************************************************
+//
+// Sends a full window of data packets during a GET request, starting with the
+// block after the last one acknowledged by the client.  Returns false if the
+// connection was closed due to an application error.
+//
+//*****************************************************************************
+static bool
+TFTPWindowSend(tTFTPConnection *psTFTP)
+{
+    uint32_t ui32Block;
+
+    //
+    // Send up to ui32WindowSize blocks, stopping early after the final (short
+    // or zero length) block of the file.
+    //
+    for(ui32Block = psTFTP->ui32BlockAcked + 1;
+        ui32Block <= (psTFTP->ui32BlockAcked + psTFTP->ui32WindowSize);
+        ui32Block++)
+    {
+        psTFTP->ui32BlockNum = ui32Block;
+        if(!TFTPDataSend(psTFTP))
+        {
+            return(false);
+        }
+
+        if((ui32Block * psTFTP->ui32BlockSize) > psTFTP->ui32DataRemaining)
+        {
+            break;
+        }
+    }
+
+    return(true);
 }
 
 //*****************************************************************************
 //
-// Send an ACK packet back to the TFTP client.
+// Send an ACK packet for the last block received in sequence back to the TFTP
+// client.
 //
 //*****************************************************************************
 static void
@@ -245,8 +400,8 @@ TFTPDataAck(tTFTPConnection *psTFTP)
     //
     pui8Data[0] = (TFTP_ACK >> 8) & 0xff;
     pui8Data[1] = TFTP_ACK & 0xff;
-    pui8Data[2] = (psTFTP->ui32BlockNum >> 8) & 0xff;
-    pui8Data[3] = psTFTP->ui32BlockNum & 0xff;
+    pui8Data[2] = (psTFTP->ui32BlockAcked >> 8) & 0xff;
+    pui8Data[3] = psTFTP->ui32BlockAcked & 0xff;
 
     //
     // Send the data packet.
@@ -257,32 +412,93 @@ TFTPDataAck(tTFTPConnection *psTFTP)
     // Free the pbuf.
     //
     pbuf_free(p);
+
+    //
+    // A new window starts after every acknowledgment.
+    //
+    psTFTP->ui32WindowCount = 0;
 }
 
 //*****************************************************************************
 //
-// Handles datagrams received from the TFTP data connection.
+// Handles an ACK packet received during a GET request.  Returns false if the
+// connection was closed.
 //
 //*****************************************************************************
-static void
-TFTPDataRecv(void *arg, struct udp_pcb *upcb, struct pbuf *p,
-             struct ip_addr *addr, u16_t port)
+static bool
+TFTPAckProcess(tTFTPConnection *psTFTP, uint32_t ui32Ack)
 {
-    uint8_t *pui8Data;
-    uint32_t ui32Block;
-    struct pbuf *pBuf;
-    tTFTPConnection *psTFTP;
-    tTFTPError eRetcode;
+    uint32_t ui32Delta;
 
     //
-    // Initialize our return code.
+    // The ACK carries only the low 16 bits of the block number so work out
+    // how far it moves us forward from the last acknowledged block.  This
+    // allows transfers of more than 65535 blocks to wrap the block counter.
     //
-    eRetcode = TFTP_ERR_NOT_DEFINED;
+    ui32Delta = (ui32Ack - psTFTP->ui32BlockAcked) & 0xffff;
 
     //
-    // Get a pointer to the connection instance data.
+    // Ignore duplicate or stale ACKs and anything acknowledging a block we
+    // have not sent yet.  Retransmission is left to the timer so that a
+    // duplicated ACK cannot double the traffic (the "Sorcerer's Apprentice"
+    // problem).  The only zero-delta ACK we accept is the ACK of block 0
+    // which confirms an OACK.
     //
-    psTFTP = (tTFTPConnection *)arg;
+    if(psTFTP->ui32Flags & TFTP_FLAG_OACK_PENDING)
+    {
+        if(ui32Delta != 0)
+        {
+            return(true);
+        }
+        psTFTP->ui32Flags &= ~TFTP_FLAG_OACK_PENDING;
+    }
+    else if((ui32Delta == 0) ||
+            (ui32Delta > (psTFTP->ui32BlockNum - psTFTP->ui32BlockAcked)))
+    {
+        return(true);
+    }
+
+    //
+    // The client is alive and has acknowledged new data.
+    //
+    psTFTP->ui32BlockAcked += ui32Delta;
+    psTFTP->ui32TimerMS = 0;
+    psTFTP->ui32Retries = 0;
+
+    //
+    // See if there is more data to be sent.  Note that we need the "<="
+    // here to ensure that we send back a zero length packet in the case that
+    // the file is a multiple of the block size (in other words, the last
+    // packet of valid data was a full packet).
+    //
+    if((psTFTP->ui32BlockAcked * psTFTP->ui32BlockSize) <=
+       psTFTP->ui32DataRemaining)
+    {
+        //
+        // Send the next window of the file.
+        //
+        return(TFTPWindowSend(psTFTP));
+    }
+
+    //
+    // The transfer is complete, so close the data connection.
+    //
+    TFTPClose(psTFTP);
+    return(false);
+}
+
+//*****************************************************************************
+//
+// Handles a DATA packet received during a PUT request.  Returns false if the
+// connection was closed.
+//
+//*****************************************************************************
+static bool
+TFTPDataProcess(tTFTPConnection *psTFTP, struct pbuf *p)
+{
+    uint8_t *pui8Data;
+    struct pbuf *pBuf;
+    tTFTPError eRetcode;
 
     //
     // Get a pointer to the TFTP packet.
@@ -290,164 +506,195 @@ TFTPDataRecv(void *arg, struct udp_pcb *upcb, struct pbuf *p,
     pui8Data = (uint8_t *)(p->payload);
 
     //
-    // If this is an ACK packet, send back the next block to satisfy an
-    // ongoing GET (read) request.
+    // Is this the next block in sequence?
     //
-    if((pui8Data[0] == ((TFTP_ACK >> 8) & 0xff)) &&
-       (pui8Data[1] == (TFTP_ACK & 0xff)))
+    if((((pui8Data[2] << 8) + pui8Data[3]) & 0xffff) !=
+       ((psTFTP->ui32BlockAcked + 1) & 0xffff))
     {
         //
-        // Extract the block number from the acknowledge.
+        // No - a block was lost or this is a retransmission of data we
+        // already have.  Acknowledge the last block received in sequence so
+        // that the client restarts its window from there, but only once per
+        // gap to avoid flooding the client with duplicate ACKs.
         //
-        ui32Block = (pui8Data[2] << 8) + pui8Data[3];
+        if(!(psTFTP->ui32Flags & TFTP_FLAG_GAP_ACKED))
+        {
+            psTFTP->ui32Flags |= TFTP_FLAG_GAP_ACKED;
+            TFTPDataAck(psTFTP);
+        }
+        return(true);
+    }
 
+    //
+    // This is the expected data packet.  Set the block number and the offset
+    // within the block (stored in ui32DataRemaining) to zero.
+    //
+    psTFTP->ui32Flags &= ~(TFTP_FLAG_GAP_ACKED | TFTP_FLAG_OACK_PENDING);
+    psTFTP->ui32BlockNum = psTFTP->ui32BlockAcked + 1;
+    psTFTP->ui32DataRemaining = 0;
+    psTFTP->ui32DataLength = p->len - 4;
+    psTFTP->ui32TimerMS = 0;
+    psTFTP->ui32Retries = 0;
+
+    //
+    // Pass the data back to the application for handling.  Remember that the
+    // data may be stored across several pbufs in the chain.  We can't assume
+    // it is in a contiguous block.
+    //
+    psTFTP->pui8Data = pui8Data + 4;
+    pBuf = p;
+    eRetcode = TFTP_OK;
+
+    //
+    // Keep writing until we run out of data.
+    //
+    while(pBuf)
+    {
         //
-        // DEBUG ONLY!
+        // Pass this block to the application.
         //
-        UARTprintf("ACK %d\n", ui32Block);
+        eRetcode = psTFTP->pfnPutData(psTFTP);
 
         //
-        // See if there is more data to be sent.  Note that we need the "<="
-        // here to ensure that we send back a zero length packet in the case
-        // that the file is a multiple of 512 bytes (in other words, the last
-        // packet of valid data was a full packet).
+        // Was the data written successfully?
         //
-        if((ui32Block * TFTP_BLOCK_SIZE) <= psTFTP->ui32DataRemaining)
+        if(eRetcode != TFTP_OK)
         {
             //
-            // Send the next block of the file.
+            // No - drop out.
             //
-            psTFTP->ui32BlockNum = ui32Block + 1;
-            TFTPDataSend(psTFTP);
+            break;
         }
-        else
+
+        //
+        // Update the offset so that it is correct for the next pbuf in the
+        // chain.
+        //
+        psTFTP->ui32DataRemaining += psTFTP->ui32DataLength;
+
+        //
+        // Move to the next pbuf in the chain
+        //
+        pBuf = pBuf->next;
+        if(pBuf)
         {
-            //
-            // The transfer is complete, so close the data connection.
-            //
-            TFTPClose(psTFTP);
-            psTFTP = NULL;
+            psTFTP->pui8Data = pBuf->payload;
+            psTFTP->ui32DataLength = pBuf->len;
         }
     }
-    else
+
+    //
+    // If there was an error reported, pass the error back to the TFTP client
+    // and close the connection.
+    //
+    if(eRetcode != TFTP_OK)
+    {
+        TFTPErrorSend(psTFTP, eRetcode);
+        TFTPClose(psTFTP);
+        return(false);
+    }
+
+    //
+    // The block was stored successfully.
+    //
+    psTFTP->ui32BlockAcked = psTFTP->ui32BlockNum;
+    psTFTP->ui32WindowCount++;
+
+    //
+    // Is the transfer finished?
+    //
+    if(p->tot_len < (psTFTP->ui32BlockSize + 4))
     {
         //
-        // If this is a DATA packet, get the payload and write it to the
-        // appropriate location in the serial flash.
+        // We got a short packet so the transfer is complete.  Acknowledge it
+        // and close the connection.
         //
-        if((pui8Data[0] == ((TFTP_DATA >> 8) & 0xff)) &&
-           (pui8Data[1] == (TFTP_DATA & 0xff)))
-        {
-            //
-            // This is a data packet.  Extract the block number from the packet
-            // and set the offset within the block (stored in
-            // ui32DataRemaining) to zero.
-            //
-            psTFTP->ui32BlockNum = (pui8Data[2] << 8) + pui8Data[3];
-            psTFTP->ui32DataRemaining = 0;
-            psTFTP->ui32DataLength = p->len - 4;
-
-            //
-            // Pass the data back to the application for handling.  Remember
-            // that the data may be stored across several pbufs in the chain.
-            // We can't assume it is in a contiguous block.
-            //
-            psTFTP->pui8Data = pui8Data + 4;
-            pBuf = p;
+        TFTPDataAck(psTFTP);
+        TFTPClose(psTFTP);
+        return(false);
+    }
 
-            //
-            // Keep writing until we run out of data.
-            //
-            while(pBuf)
-            {
-                //
-                // Pass this block to the application.
-                //
-                eRetcode = psTFTP->pfnPutData(psTFTP);
+    //
+    // Acknowledge the window once it has been completely received.
+    //
+    if(psTFTP->ui32WindowCount >= psTFTP->ui32WindowSize)
+    {
+        TFTPDataAck(psTFTP);
+    }
 
-                //
-                // Was the data written successfully?
-                //
-                if(eRetcode != TFTP_OK)
-                {
-                    //
-                    // No - drop out.
-                    //
-                    break;
-                }
+    return(true);
+}
 
-                //
-                // Update the offset so that it is correct for the next pbuf
-                // in the chain.
-                //
-                psTFTP->ui32DataRemaining += psTFTP->ui32DataLength;
+//*****************************************************************************
+//
+// Handles datagrams received from the TFTP data connection.
+//
+//*****************************************************************************
+static void
+TFTPDataRecv(void *arg, struct udp_pcb *upcb, struct pbuf *p,
+             struct ip_addr *addr, u16_t port)
+{
+    uint8_t *pui8Data;
+    tTFTPConnection *psTFTP;
 
-                //
-                // Move to the next pbuf in the chain
-                //
-                pBuf = pBuf->next;
-                if(pBuf)
-                {
-                    psTFTP->pui8Data = pBuf->payload;
-                    psTFTP->ui32DataLength = pBuf->len;
-                }
-            }
+    //
+    // Get a pointer to the connection instance data.
+    //
+    psTFTP = (tTFTPConnection *)arg;
 
-            //
-            // If we get here and there was an error reported, pass the error
-            // back to the TFTP client.
-            //
-            if(psTFTP && (eRetcode != TFTP_OK))
-            {
-                //
-                // Send the error code to the client.
-                //
-                TFTPErrorSend(psTFTP, eRetcode);
+    //
+    // Get a pointer to the TFTP packet.
+    //
+    pui8Data = (uint8_t *)(p->payload);
 
-                //
-                // Close the connection.
-                //
-                TFTPClose(psTFTP);
-                psTFTP = NULL;
-            }
-            else
-            {
-                //
-                // Acknowledge this block.
-                //
-                TFTPDataAck(psTFTP);
+    //
+    // Ignore runt packets which are too short to hold an opcode and block
+    // number.
+    //
+    if(p->len < 4)
+    {
+        pbuf_free(p);
+        return;
+    }
 
-                //
-                // Is the transfer finished?
-                //
-                if(p->tot_len < (TFTP_BLOCK_SIZE + 4))
-                {
-                    //
-                    // We got a short packet so the transfer is complete.
-                    // Close the connection.
-                    //
-                    TFTPClose(psTFTP);
-                    psTFTP = NULL;
-                }
-            }
+    //
+    // If this is an ACK packet, send back the next window to satisfy an
+    // ongoing GET (read) request.
+    //
+    if((pui8Data[0] == ((TFTP_ACK >> 8) & 0xff)) &&
+       (pui8Data[1] == (TFTP_ACK & 0xff)))
+    {
+        if(psTFTP->ui32Flags & TFTP_FLAG_GET)
+        {
+            TFTPAckProcess(psTFTP, (pui8Data[2] << 8) + pui8Data[3]);
         }
-        else
+    }
+
+    //
+    // If this is a DATA packet, pass the payload to the application as part
+    // of an ongoing PUT (write) request.
+    //
+    else if((pui8Data[0] == ((TFTP_DATA >> 8) & 0xff)) &&
+            (pui8Data[1] == (TFTP_DATA & 0xff)))
+    {
+        if(!(psTFTP->ui32Flags & TFTP_FLAG_GET))
         {
-            //
-            // Is the client reporting an error?
-            //
-            if((pui8Data[0] == ((TFTP_ERROR >> 8) & 0xff)) &&
-               (pui8Data[1] == (TFTP_ERROR & 0xff)))
-            {
-                //
-                // Yes - we got an error so close the connection.
-                //
-                TFTPClose(psTFTP);
-                psTFTP = NULL;
-            }
+            TFTPDataProcess(psTFTP, p);
         }
     }
 
+    //
+    // Is the client reporting an error?
+    //
+    else if((pui8Data[0] == ((TFTP_ERROR >> 8) & 0xff)) &&
+            (pui8Data[1] == (TFTP_ERROR & 0xff)))
+    {
+        //
+        // Yes - we got an error so close the connection.
+        //
+        TFTPClose(psTFTP);
+    }
+
     //
     // Free the pbuf.
     //
@@ -526,6 +773,97 @@ TFTPModeGet(uint8_t *pui8Request, uint32_t ui32Len)
     return(TFTP_MODE_INVALID);
 }
 
+//*****************************************************************************
+//
+// Parses any RFC 2347 options following the mode string in a request and
+// fills in the requested block and window sizes in the connection structure,
+// limited to the values this server supports.  Unknown options and options
+// with invalid values are ignored as permitted by the RFC.
+//
+//*****************************************************************************
+static void
+TFTPOptionsGet(tTFTPConnection *psTFTP, uint8_t *pui8Request, uint32_t ui32Len)
+{
+    uint32_t ui32Loop, ui32Field, ui32Name, ui32Value;
+    unsigned long ulValue;
+
+    //
+    // Skip the opcode, filename and mode strings.  The request has already
+    // been checked to contain valid filename and mode strings.
+    //
+    ui32Loop = 2;
+    for(ui32Field = 0; ui32Field < 2; ui32Field++)
+    {
+        while((ui32Loop < ui32Len) && pui8Request[ui32Loop])
+        {
+            ui32Loop++;
+        }
+        ui32Loop++;
+    }
+
+    //
+    // Walk through each option name and value pair.
+    //
+    while(ui32Loop < ui32Len)
+    {
+        //
+        // Find the end of the option name.
+        //
+        ui32Name = ui32Loop;
+        while((ui32Loop < ui32Len) && pui8Request[ui32Loop])
+        {
+            ui32Loop++;
+        }
+        ui32Loop++;
+
+        //
+        // Find the end of the option value.  If it is not terminated within
+        // the packet, the option is malformed so stop parsing.
+        //
+        ui32Value = ui32Loop;
+        while((ui32Loop < ui32Len) && pui8Request[ui32Loop])
+        {
+            ui32Loop++;
+        }
+        if(ui32Loop >= ui32Len)
+        {
+            break;
+        }
+        ui32Loop++;
+
+        //
+        // Convert the value.  All the options we support are numeric.
+        //
+        ulValue = ustrtoul((char *)&pui8Request[ui32Value], 0, 10);
+
+        //
+        // Is this the block size option (RFC 2348)?
+        //
+        if(!ustrcasecmp("blksize", (char *)&pui8Request[ui32Name]))
+        {
+            if(ulValue >= TFTP_MIN_BLOCK_SIZE)
+            {
+                psTFTP->ui32BlockSize = (ulValue > TFTP_MAX_BLOCK_SIZE) ?
+                                        TFTP_MAX_BLOCK_SIZE : ulValue;
+                psTFTP->ui32Flags |= TFTP_FLAG_OPT_BLKSIZE;
+            }
+        }
+
+        //
+        // Is this the window size option (RFC 7440)?
+        //
+        else if(!ustrcasecmp("windowsize", (char *)&pui8Request[ui32Name]))
+        {
+            if(ulValue >= 1)
+            {
+                psTFTP->ui32WindowSize = (ulValue > TFTP_MAX_WINDOW_SIZE) ?
+                                         TFTP_MAX_WINDOW_SIZE : ulValue;
+                psTFTP->ui32Flags |= TFTP_FLAG_OPT_WINDOW;
+            }
+        }
+    }
+}
+
 //*****************************************************************************
 //
 // Handles datagrams received on the TFTP server port.
@@ -609,6 +947,15 @@ TFTPRecv(void *arg, struct udp_pcb *upcb, struct pbuf *p, struct ip_addr *addr,
         //
         memset(psTFTP, 0, sizeof(tTFTPConnection));
         psTFTP->pcErrorString = "Unknown error";
+        psTFTP->ui32BlockSize = TFTP_BLOCK_SIZE;
+        psTFTP->ui32WindowSize = 1;
+        psTFTP->ui32Flags = bGetRequest ? TFTP_FLAG_GET : 0;
+
+        //
+        // Pick up any block size and window size options the client asked
+        // for.
+        //
+        TFTPOptionsGet(psTFTP, pui8Data, p->len);
 
         //
         // Yes - create the new UDP connection and set things up to
@@ -618,6 +965,13 @@ TFTPRecv(void *arg, struct udp_pcb *upcb, struct pbuf *p, struct ip_addr *addr,
         udp_recv(psTFTP->psPCB, TFTPDataRecv, psTFTP);
         udp_connect(psTFTP->psPCB, addr, port);
 
+        //
+        // Add the connection to the active list so that TFTPClose() can
+        // always find it.
+        //
+        psTFTP->psNext = g_psConnections;
+        g_psConnections = psTFTP;
+
         //
         // Ask the application if it wants to proceed with this request.
         //
@@ -630,15 +984,39 @@ TFTPRecv(void *arg, struct udp_pcb *upcb, struct pbuf *p, struct ip_addr *addr,
         if(eRetcode == TFTP_OK)
         {
             //
-            // Yes - what kind of request is this?
+            // Guard against the application having set out-of-range
+            // values for the negotiated options.
             //
-            if(bGetRequest)
+            if(psTFTP->ui32BlockSize < TFTP_MIN_BLOCK_SIZE)
+            {
+                psTFTP->ui32BlockSize = TFTP_MIN_BLOCK_SIZE;
+            }
+            if(psTFTP->ui32WindowSize == 0)
+            {
+                psTFTP->ui32WindowSize = 1;
+            }
+
+            //
+            // If the client asked for any options we support, confirm the
+            // accepted values with an OACK.  The client responds with an ACK
+            // of block 0 for a GET or with the first DATA block for a PUT.
+            //
+            if(psTFTP->ui32Flags &
+               (TFTP_FLAG_OPT_BLKSIZE | TFTP_FLAG_OPT_WINDOW))
+            {
+                psTFTP->ui32Flags |= TFTP_FLAG_OACK_PENDING;
+                TFTPOptionAckSend(psTFTP);
+            }
+
+            //
+            // Otherwise, what kind of request is this?
+            //
+            else if(bGetRequest)
             {
                 //
-                // For a GET request, we send back the first block of data.
+                // For a GET request, we send back the first window of data.
                 //
-                psTFTP->ui32BlockNum = 1;
-                TFTPDataSend(psTFTP);
+                TFTPWindowSend(psTFTP);
             }
             else
             {
@@ -646,7 +1024,6 @@ TFTPRecv(void *arg, struct udp_pcb *upcb, struct pbuf *p, struct ip_addr *addr,
                 // For a PUT request, we acknowledge the transfer which tells
                 // the TFTP client that it can start sending us data.
                 //
-                psTFTP->ui32BlockNum = 0;
                 TFTPDataAck(psTFTP);
             }
         }
@@ -668,6 +1045,73 @@ TFTPRecv(void *arg, struct udp_pcb *upcb, struct pbuf *p, struct ip_addr *addr,
     pbuf_free(p);
 }
 
+//*****************************************************************************
+//
+//! Handles retransmission timeouts for all active TFTP connections.
+//!
+//! \param ui32TimeMS is the time, in milliseconds, since the last call to this
+//! function.
+//!
+//! This function must be called periodically, typically from the application's
+//! lwIPHostTimerHandler(), to allow the TFTP server to recover from lost
+//! packets.  If no ACK (for a GET request) or DATA packet (for a PUT request)
+//! has been received from the client within TFTP_TIMEOUT_MS, the current
+//! window of data, the last ACK or the OACK is sent again.  After
+//! TFTP_MAX_RETRIES consecutive timeouts, the connection is closed.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+TFTPTimer(uint32_t ui32TimeMS)
+{
+    tTFTPConnection *psTFTP, *psNext;
+
+    //
+    // Loop through each active connection.  Note that the connection may be
+    // closed while we process it so grab the next pointer first.
+    //
+    for(psTFTP = g_psConnections; psTFTP; psTFTP = psNext)
+    {
+        psNext = psTFTP->psNext;
+
+        //
+        // Has this connection timed out?
+        //
+        psTFTP->ui32TimerMS += ui32TimeMS;
+        if(psTFTP->ui32TimerMS < TFTP_TIMEOUT_MS)
+        {
+            continue;
+        }
+
+        //
+        // Give up if the client has stopped responding altogether.
+        //
+        psTFTP->ui32TimerMS = 0;
+        if(++psTFTP->ui32Retries > TFTP_MAX_RETRIES)
+        {
+            TFTPClose(psTFTP);
+            continue;
+        }
+
+        //
+        // Resend whatever the client appears not to have seen.
+        //
+        if(psTFTP->ui32Flags & TFTP_FLAG_OACK_PENDING)
+        {
+            TFTPOptionAckSend(psTFTP);
+        }
+        else if(psTFTP->ui32Flags & TFTP_FLAG_GET)
+        {
+            TFTPWindowSend(psTFTP);
+        }
+        else
+        {
+            TFTPDataAck(psTFTP);
+        }
+    }
+}
+
 //*****************************************************************************
 //
 //! Initializes the TFTP server module.
@@ -681,6 +1125,11 @@ TFTPRecv(void *arg, struct udp_pcb *upcb, struct pbuf *p, struct ip_addr *addr,
 //! incoming requests from clients.  It must be called after the network stack
 //! is initialized using a call to lwIPInit().
 //!
+//! The server supports the RFC 2348 ``blksize'' and RFC 7440 ``windowsize''
+//! options, allowing clients to transfer blocks of up to TFTP_MAX_BLOCK_SIZE
+//! bytes with up to TFTP_MAX_WINDOW_SIZE blocks in flight.  Applications must
+//! call TFTPTimer() periodically to handle retransmission of lost packets.
+//!
 //! \return None.
 //
 //*****************************************************************************
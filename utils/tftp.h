@@ -82,11 +82,64 @@ tTFTPMode;
 //*****************************************************************************
 //
 //! Data transfer under TFTP is performed using fixed-size blocks.  This label
-//! defines the size of a block of TFTP data.
+//! defines the default size of a block of TFTP data, used whenever the client
+//! does not negotiate a different size via the RFC 2348 ``blksize'' option.
 //
 //*****************************************************************************
 #define TFTP_BLOCK_SIZE         512
 
+//*****************************************************************************
+//
+//! The largest block size that the server accepts during ``blksize'' option
+//! negotiation.  The default allows a single TFTP DATA packet to fill a
+//! standard 1500 byte Ethernet MTU (1500 minus 20 bytes of IP header, 8 bytes
+//! of UDP header and 4 bytes of TFTP header).  Applications may override this
+//! by defining the label before including this header.
+//
+//*****************************************************************************
+#ifndef TFTP_MAX_BLOCK_SIZE
+#define TFTP_MAX_BLOCK_SIZE     1468
+#endif
+
+//*****************************************************************************
+//
+//! The smallest block size permitted by RFC 2348.
+//
+//*****************************************************************************
+#define TFTP_MIN_BLOCK_SIZE     8
+
+//*****************************************************************************
+//
+//! The largest number of blocks that the server accepts during RFC 7440
+//! ``windowsize'' option negotiation.  Each block in a window may be in flight
+//! at the same time so this also bounds the number of pbufs a single
+//! connection may have queued for transmission.
+//
+//*****************************************************************************
+#ifndef TFTP_MAX_WINDOW_SIZE
+#define TFTP_MAX_WINDOW_SIZE    16
+#endif
+
+//*****************************************************************************
+//
+//! The time, in milliseconds, that the server waits for the next ACK (GET) or
+//! DATA (PUT) packet before retransmitting the current window.
+//
+//*****************************************************************************
+#ifndef TFTP_TIMEOUT_MS
+#define TFTP_TIMEOUT_MS         1000
+#endif
+
+//*****************************************************************************
+//
+//! The number of consecutive retransmissions after which the server gives up
+//! on a connection and closes it.
+//
+//*****************************************************************************
+#ifndef TFTP_MAX_RETRIES
+#define TFTP_MAX_RETRIES        5
+#endif
+
 //*****************************************************************************
 //
 // Callback function prototypes passed to TFTPInit.  These functions receive
@@ -148,7 +201,10 @@ typedef struct _tTFTPConnection
     //! split the TFTP packet between several packets and a callback is made
     //! for each of these.  This avoids the need for a 512 byte buffer.  The
     //! ui32DataRemaining is used in these cases to indicate the offset of the
-    //! data within the current block.
+    //! data within the current block.  Since the block is acknowledged only
+    //! after this function returns, applications writing an image to flash
+    //! should stage the data with FlashStreamWrite() rather than erasing and
+    //! programming the flash directly.
     //
     tTFTPTransfer pfnPutData;
 
@@ -183,9 +239,69 @@ typedef struct _tTFTPConnection
     //! The current block number for an ongoing TFTP transfer.  Applications
     //! may read this value to determine which data to return on a pfnGetData
     //! callback or where to write incoming data on a pfnPutData callback but
-    //! must not modify it.
+    //! must not modify it.  The byte offset of the block within the file is
+    //! (ui32BlockNum - 1) * ui32BlockSize.
     //
     uint32_t ui32BlockNum;
+
+    //
+    //! The size of each block of data transferred on this connection.  This
+    //! is set to the client's requested ``blksize'' (limited to
+    //! TFTP_MAX_BLOCK_SIZE) or to TFTP_BLOCK_SIZE if the client did not ask
+    //! for a different size.  The tTFTPRequest callback may reduce this value
+    //! to limit the block size but must not set it below TFTP_MIN_BLOCK_SIZE.
+    //! It must not be modified after the tTFTPRequest callback returns.
+    //
+    uint32_t ui32BlockSize;
+
+    //
+    //! The number of blocks which may be sent before an acknowledgment is
+    //! required.  This is set to the client's requested ``windowsize''
+    //! (limited to TFTP_MAX_WINDOW_SIZE) or to 1 for classic lock-step
+    //! transfers.  The tTFTPRequest callback may reduce this value but must
+    //! not set it to 0.  It must not be modified after the tTFTPRequest
+    //! callback returns.
+    //
+    uint32_t ui32WindowSize;
+
+    //
+    //! The highest block number which the client has acknowledged during a
+    //! GET request or which has been received in sequence during a PUT
+    //! request.  Applications must not modify this field.
+    //
+    uint32_t ui32BlockAcked;
+
+    //
+    //! The number of in-sequence blocks received during a PUT request since
+    //! the last ACK was sent.  Applications must not modify this field.
+    //
+    uint32_t ui32WindowCount;
+
+    //
+    //! The number of milliseconds since the last valid packet was received
+    //! from the client.  Applications must not modify this field.
+    //
+    uint32_t ui32TimerMS;
+
+    //
+    //! The number of retransmissions performed since the last valid packet
+    //! was received from the client.  Applications must not modify this
+    //! field.
+    //
+    uint32_t ui32Retries;
+
+    //
+    //! Flags indicating which options were requested by the client and the
+    //! internal state of the connection.  Applications must not modify this
+    //! field.
+    //
+    uint32_t ui32Flags;
+
+    //
+    //! A pointer to the next active connection.  Applications must not modify
+    //! this field.
+    //
+    struct _tTFTPConnection *psNext;
 }
 tTFTPConnection;
 
@@ -202,6 +318,7 @@ tTFTPConnection;
 //
 //*****************************************************************************
 extern void TFTPInit(tTFTPRequest pfnRequest);
+extern void TFTPTimer(uint32_t ui32TimeMS);
 
 //*****************************************************************************
 //
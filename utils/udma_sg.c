@@ -0,0 +1,347 @@
+//*****************************************************************************
+//
+// udma_sg.c - Builder for uDMA scatter-gather task lists.
+//
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Utility Library.
+//
+//*****************************************************************************
+//*****************************************************************************
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_types.h"
+#include "inc/hw_udma.h"
+#include "driverlib/debug.h"
+#include "driverlib/rom.h"
+#include "driverlib/rom_map.h"
+#include "driverlib/udma.h"
+#include "utils/udma_sg.h"
+
+//*****************************************************************************
+//
+//! \addtogroup udma_sg_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// The largest number of items that a single uDMA task can transfer.
+//
+//*****************************************************************************
+#define UDMA_SG_MAX_ITEMS       1024
+
+//*****************************************************************************
+//
+//! Prepares to build a scatter-gather job.
+//!
+//! \param psJob is a pointer to the job state structure.
+//! \param psTasks is the task list to fill.  It must be word aligned and
+//! remain valid until the transfer completes.
+//! \param ui32MaxTasks is the number of entries in \e psTasks.
+//! \param bPeripheral is \b true if the job is started by peripheral requests
+//! or \b false if it runs as a memory transfer from a software request.
+//!
+//! This function begins a new job, replacing any tasks previously held in
+//! \e psTasks.  Segments are added with uDMASGJobAdd() or its wrappers, in the
+//! order in which they are to be transferred, and the job is handed to the
+//! uDMA controller with uDMASGJobStart().  This allows a transfer made up of
+//! several separate buffers, for example a header, payload and CRC being
+//! sent to a serial peripheral, to run without processor intervention
+//! between the segments.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+uDMASGJobInit(tuDMASGJob *psJob, tDMAControlTable *psTasks,
+              uint32_t ui32MaxTasks, bool bPeripheral)
+{
+    //
+    // Check the arguments.
+    //
+    ASSERT(psJob);
+    ASSERT(psTasks);
+    ASSERT(((uint32_t)psTasks & 3) == 0);
+
+    psJob->psTasks = psTasks;
+    psJob->ui32MaxTasks = ui32MaxTasks;
+    psJob->ui32NumTasks = 0;
+    psJob->bPeripheral = bPeripheral;
+    psJob->bError = false;
+}
+
+//*****************************************************************************
+//
+//! Adds a segment to a scatter-gather job.
+//!
+//! \param psJob is a pointer to the job state structure.
+//! \param ui32ItemSize is the size of each item, which must be one of
+//! \b UDMA_SIZE_8, \b UDMA_SIZE_16, or \b UDMA_SIZE_32.
+//! \param pvSrcAddr is the address of the first item to read.
+//! \param ui32SrcIncrement is the source address increment, which must be
+//! one of \b UDMA_SRC_INC_8, \b UDMA_SRC_INC_16, \b UDMA_SRC_INC_32, or
+//! \b UDMA_SRC_INC_NONE.
+//! \param pvDstAddr is the address to which the first item is written.
+//! \param ui32DstIncrement is the destination address increment, which must
+//! be one of \b UDMA_DST_INC_8, \b UDMA_DST_INC_16, \b UDMA_DST_INC_32, or
+//! \b UDMA_DST_INC_NONE.
+//! \param ui32Count is the number of items to transfer.
+//! \param ui32ArbSize is the arbitration size, which must be one of
+//! \b UDMA_ARB_1 through \b UDMA_ARB_1024.
+//!
+//! This function appends the tasks needed to transfer a segment to the job.
+//! Segments of more than 1024 items are split across several tasks.  The
+//! segment is checked against the requirements of the uDMA controller: both
+//! addresses must be aligned to the item size, the increments must not be
+//! smaller than the item size, and the task list must have room for the
+//! segment.  If any check fails, no tasks are added and the job can no longer
+//! be started.
+//!
+//! \return Returns \b true if the segment was added or \b false if it was
+//! invalid or did not fit in the task list.
+//
+//*****************************************************************************
+bool
+uDMASGJobAdd(tuDMASGJob *psJob, uint32_t ui32ItemSize, const void *pvSrcAddr,
+             uint32_t ui32SrcIncrement, void *pvDstAddr,
+             uint32_t ui32DstIncrement, uint32_t ui32Count,
+             uint32_t ui32ArbSize)
+{
+    tDMAControlTable *psTask;
+    uint32_t ui32Size, ui32SrcShift, ui32DstShift, ui32Items, ui32Tasks;
+    uint32_t ui32Src, ui32Dst;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(psJob);
+    ASSERT((ui32ItemSize == UDMA_SIZE_8) || (ui32ItemSize == UDMA_SIZE_16) ||
+           (ui32ItemSize == UDMA_SIZE_32));
+
+    //
+    // Get the item size and the increments as powers of two.  An increment of
+    // 3 means that the address does not change.
+    //
+    ui32Size = (ui32ItemSize & UDMA_CHCTL_SRCSIZE_M) >> 24;
+    ui32SrcShift = (ui32SrcIncrement & UDMA_CHCTL_SRCINC_M) >> 26;
+    ui32DstShift = (ui32DstIncrement & UDMA_CHCTL_DSTINC_M) >> 30;
+    ui32Src = (uint32_t)pvSrcAddr;
+    ui32Dst = (uint32_t)pvDstAddr;
+    ui32Tasks = (ui32Count + UDMA_SG_MAX_ITEMS - 1) / UDMA_SG_MAX_ITEMS;
+
+    //
+    // Reject the segment if it breaks any of the controller's rules or does
+    // not fit in the task list.
+    //
+    if(psJob->bError || (ui32Count == 0) ||
+       (ui32Src & ((1 << ui32Size) - 1)) ||
+       (ui32Dst & ((1 << ui32Size) - 1)) ||
+       (ui32SrcShift < ui32Size) || (ui32DstShift < ui32Size) ||
+       (ui32Tasks > (psJob->ui32MaxTasks - psJob->ui32NumTasks)))
+    {
+        psJob->bError = true;
+        return(false);
+    }
+
+    //
+    // Add a task for each block of up to 1024 items.
+    //
+    while(ui32Count)
+    {
+        ui32Items = ((ui32Count > UDMA_SG_MAX_ITEMS) ? UDMA_SG_MAX_ITEMS :
+                     ui32Count);
+        psTask = &psJob->psTasks[psJob->ui32NumTasks++];
+
+        //
+        // The controller is given the address of the last item of each
+        // incrementing buffer.
+        //
+        psTask->pvSrcEndAddr = (void *)((ui32SrcShift == 3) ? ui32Src :
+                                        (ui32Src +
+                                         ((ui32Items - 1) << ui32SrcShift)));
+        psTask->pvDstEndAddr = (void *)((ui32DstShift == 3) ? ui32Dst :
+                                        (ui32Dst +
+                                         ((ui32Items - 1) << ui32DstShift)));
+        psTask->ui32Control = (ui32SrcIncrement | ui32DstIncrement |
+                               ui32ItemSize | ui32ArbSize |
+                               ((ui32Items - 1) << UDMA_CHCTL_XFERSIZE_S) |
+                               (psJob->bPeripheral ?
+                                UDMA_CHCTL_XFERMODE_PER_SGA :
+                                UDMA_CHCTL_XFERMODE_MEM_SGA));
+        psTask->ui32Spare = 0;
+
+        //
+        // Move on to the next block.
+        //
+        if(ui32SrcShift != 3)
+        {
+            ui32Src += ui32Items << ui32SrcShift;
+        }
+        if(ui32DstShift != 3)
+        {
+            ui32Dst += ui32Items << ui32DstShift;
+        }
+        ui32Count -= ui32Items;
+    }
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Adds a segment that writes a buffer to a peripheral register.
+//!
+//! \param psJob is a pointer to the job state structure.
+//! \param ui32ItemSize is the size of each item, which must be one of
+//! \b UDMA_SIZE_8, \b UDMA_SIZE_16, or \b UDMA_SIZE_32.
+//! \param pvSrcAddr is the buffer to write.
+//! \param pvReg is the address of the peripheral's data register.
+//! \param ui32Count is the number of items to transfer.
+//! \param ui32ArbSize is the arbitration size, which should normally match
+//! the peripheral's FIFO trigger level.
+//!
+//! This function is a wrapper around uDMASGJobAdd() for the common case of
+//! feeding a peripheral FIFO from memory.
+//!
+//! \return Returns \b true if the segment was added or \b false if it was
+//! invalid or did not fit in the task list.
+//
+//*****************************************************************************
+bool
+uDMASGJobAddToPeripheral(tuDMASGJob *psJob, uint32_t ui32ItemSize,
+                         const void *pvSrcAddr, void *pvReg,
+                         uint32_t ui32Count, uint32_t ui32ArbSize)
+{
+    //
+    // The source increments by one item and the destination is fixed.
+    //
+    return(uDMASGJobAdd(psJob, ui32ItemSize, pvSrcAddr,
+                        (ui32ItemSize & UDMA_CHCTL_SRCSIZE_M) << 2, pvReg,
+                        UDMA_DST_INC_NONE, ui32Count, ui32ArbSize));
+}
+
+//*****************************************************************************
+//
+//! Adds a segment that reads a peripheral register into a buffer.
+//!
+//! \param psJob is a pointer to the job state structure.
+//! \param ui32ItemSize is the size of each item, which must be one of
+//! \b UDMA_SIZE_8, \b UDMA_SIZE_16, or \b UDMA_SIZE_32.
+//! \param pvReg is the address of the peripheral's data register.
+//! \param pvDstAddr is the buffer to fill.
+//! \param ui32Count is the number of items to transfer.
+//! \param ui32ArbSize is the arbitration size, which should normally match
+//! the peripheral's FIFO trigger level.
+//!
+//! This function is a wrapper around uDMASGJobAdd() for the common case of
+//! draining a peripheral FIFO into memory.
+//!
+//! \return Returns \b true if the segment was added or \b false if it was
+//! invalid or did not fit in the task list.
+//
+//*****************************************************************************
+bool
+uDMASGJobAddFromPeripheral(tuDMASGJob *psJob, uint32_t ui32ItemSize,
+                           const void *pvReg, void *pvDstAddr,
+                           uint32_t ui32Count, uint32_t ui32ArbSize)
+{
+    //
+    // The source is fixed and the destination increments by one item.
+    //
+    return(uDMASGJobAdd(psJob, ui32ItemSize, pvReg, UDMA_SRC_INC_NONE,
+                        pvDstAddr, (ui32ItemSize & UDMA_CHCTL_DSTSIZE_M) << 2,
+                        ui32Count, ui32ArbSize));
+}
+
+//*****************************************************************************
+//
+//! Returns the number of tasks in a scatter-gather job.
+//!
+//! \param psJob is a pointer to the job state structure.
+//!
+//! \return Returns the number of task list entries used by the job.
+//
+//*****************************************************************************
+uint32_t
+uDMASGJobTaskCountGet(tuDMASGJob *psJob)
+{
+    return(psJob->ui32NumTasks);
+}
+
+//*****************************************************************************
+//
+//! Starts a scatter-gather job.
+//!
+//! \param psJob is a pointer to the job state structure.
+//! \param ui32ChannelNum is the uDMA channel to use, which may include a
+//! channel assignment such as \b UDMA_CH11_SSI0TX.
+//!
+//! This function finishes the task list by making the final task a basic
+//! transfer for a peripheral job or an auto transfer for a memory job, so
+//! that the channel stops and raises its completion interrupt after the last
+//! segment.  The channel is then configured with
+//! uDMAChannelScatterGatherSet() and enabled.  A memory job is started
+//! immediately with a software request, while a peripheral job proceeds as
+//! the peripheral makes requests.  The caller must have assigned and
+//! configured the channel and enabled the uDMA controller.
+//!
+//! \return Returns \b true if the job was started or \b false if it is empty
+//! or a segment could not be added.
+//
+//*****************************************************************************
+bool
+uDMASGJobStart(tuDMASGJob *psJob, uint32_t ui32ChannelNum)
+{
+    tDMAControlTable *psLast;
+
+    if(psJob->bError || (psJob->ui32NumTasks == 0))
+    {
+        return(false);
+    }
+
+    //
+    // Make the last task end the transfer.
+    //
+    psLast = &psJob->psTasks[psJob->ui32NumTasks - 1];
+    psLast->ui32Control = ((psLast->ui32Control & ~UDMA_CHCTL_XFERMODE_M) |
+                           (psJob->bPeripheral ? UDMA_CHCTL_XFERMODE_BASIC :
+                            UDMA_CHCTL_XFERMODE_AUTO));
+
+    //
+    // Point the channel at the task list and start it.
+    //
+    MAP_uDMAChannelScatterGatherSet(ui32ChannelNum, psJob->ui32NumTasks,
+                                    psJob->psTasks, psJob->bPeripheral);
+    MAP_uDMAChannelEnable(ui32ChannelNum);
+    if(!psJob->bPeripheral)
+    {
+        MAP_uDMAChannelRequest(ui32ChannelNum);
+    }
+
+    return(true);
+}
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
@@ -0,0 +1,125 @@
+//*****************************************************************************
+//
+// udma_sg.h - Prototypes for the uDMA scatter-gather task list builder.
+//
+//
+// Copyright (c) 2014 Texas Instruments Incorporated.  All rights reserved.
+// Software License Agreement
+// 
+// Texas Instruments (TI) is supplying this software for use solely and
+// exclusively on TI's microcontroller products. The software is owned by
+// TI and/or its suppliers, and is protected under applicable copyright
+// laws. You may not combine this software with "viral" open-source
+// software in order to form a larger program.
+// 
+// THIS SOFTWARE IS PROVIDED "AS IS" AND WITH ALL FAULTS.
+// NO WARRANTIES, WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT
+// NOT LIMITED TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. TI SHALL NOT, UNDER ANY
+// CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL, OR CONSEQUENTIAL
+// DAMAGES, FOR ANY REASON WHATSOEVER.
+// 
+// This is part of revision 2.1.0.12573 of the Tiva Utility Library.
+//
+//*****************************************************************************
+//*****************************************************************************
+
+#ifndef __UDMA_SG_H__
+#define __UDMA_SG_H__
+
+//*****************************************************************************
+//
+// If building with a C++ compiler, make all of the definitions in this header
+// have a C binding.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//*****************************************************************************
+//
+//! \addtogroup udma_sg_api
+//! @{
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+//! The state of a scatter-gather job being built.  The members of this
+//! structure are private to the scatter-gather module and must not be
+//! accessed by the application.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The task list, supplied by the application.
+    //
+    tDMAControlTable *psTasks;
+
+    //
+    // The number of entries available in the task list.
+    //
+    uint32_t ui32MaxTasks;
+
+    //
+    // The number of tasks added to the task list.
+    //
+    uint32_t ui32NumTasks;
+
+    //
+    // Indicates that the job is a peripheral scatter-gather transfer rather
+    // than a memory scatter-gather transfer.
+    //
+    bool bPeripheral;
+
+    //
+    // Indicates that a task could not be added to the job.
+    //
+    bool bError;
+}
+tuDMASGJob;
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+//*****************************************************************************
+//
+// Prototypes for the scatter-gather job builder functions.
+//
+//*****************************************************************************
+extern void uDMASGJobInit(tuDMASGJob *psJob, tDMAControlTable *psTasks,
+                          uint32_t ui32MaxTasks, bool bPeripheral);
+extern bool uDMASGJobAdd(tuDMASGJob *psJob, uint32_t ui32ItemSize,
+                         const void *pvSrcAddr, uint32_t ui32SrcIncrement,
+                         void *pvDstAddr, uint32_t ui32DstIncrement,
+                         uint32_t ui32Count, uint32_t ui32ArbSize);
+extern bool uDMASGJobAddToPeripheral(tuDMASGJob *psJob,
+                                     uint32_t ui32ItemSize,
+                                     const void *pvSrcAddr, void *pvReg,
+                                     uint32_t ui32Count,
+                                     uint32_t ui32ArbSize);
+extern bool uDMASGJobAddFromPeripheral(tuDMASGJob *psJob,
+                                       uint32_t ui32ItemSize,
+                                       const void *pvReg, void *pvDstAddr,
+                                       uint32_t ui32Count,
+                                       uint32_t ui32ArbSize);
+extern uint32_t uDMASGJobTaskCountGet(tuDMASGJob *psJob);
+extern bool uDMASGJobStart(tuDMASGJob *psJob, uint32_t ui32ChannelNum);
+
+//*****************************************************************************
+//
+// Mark the end of the C bindings section for C++ compilers.
+//
+//*****************************************************************************
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __UDMA_SG_H__
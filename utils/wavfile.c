@@ -36,6 +36,93 @@
 //******************************************************************************
 #define WAV_FLAG_FILEOPEN       0x00000001
 
+//******************************************************************************
+//
+// The number of sample frames that are converted at a time by WavStreamRead()
+// when the sample rate is being converted.
+//
+//******************************************************************************
+#define WAV_STREAM_CHUNK        32
+
+//******************************************************************************
+//
+// The polyphase filter used by the sample rate converter.  Each row holds the
+// taps of a windowed-sinc interpolator for a fractional position of row/64
+// between the fourth and fifth samples of the history, in 1.15 fixed-point
+// format.  Each row sums to 32768.  The cutoff is 90% of the input Nyquist
+// frequency, which suits conversion up to the DAC rate; large downward ratios
+// should be band-limited before conversion.
+//
+//******************************************************************************
+static const int16_t g_ppi16ResampleFilter[WAV_RESAMPLE_PHASES]
+                                          [WAV_RESAMPLE_TAPS] =
+{
+    {    187,  -1042,   2493,  29492,   2493,  -1042,    187,      0 },
+    {    173,   -953,   2102,  29480,   2898,  -1133,    201,      0 },
+    {    160,   -865,   1723,  29446,   3315,  -1226,    215,      0 },
+    {    148,   -780,   1358,  29389,   3745,  -1321,    229,      0 },
+    {    135,   -697,   1006,  29310,   4187,  -1416,    244,     -1 },
+    {    124,   -616,    668,  29207,   4640,  -1513,    259,     -1 },
+    {    112,   -538,    344,  29082,   5105,  -1610,    274,     -1 },
+    {    101,   -463,     34,  28936,   5581,  -1708,    289,     -2 },
+    {     91,   -390,   -263,  28767,   6067,  -1806,    304,     -2 },
+    {     81,   -320,   -545,  28577,   6563,  -1905,    320,     -3 },
+    {     72,   -252,   -813,  28364,   7069,  -2003,    335,     -4 },
+    {     63,   -188,  -1067,  28132,   7583,  -2101,    350,     -4 },
+    {     55,   -126,  -1307,  27876,   8107,  -2197,    365,     -5 },
+    {     47,    -68,  -1534,  27604,   8638,  -2293,    380,     -6 },
+    {     39,    -12,  -1746,  27312,   9176,  -2388,    394,     -7 },
+    {     33,     41,  -1945,  26998,   9721,  -2480,    408,     -8 },
+    {     26,     90,  -2130,  26668,  10272,  -2571,    422,     -9 },
+    {     20,    137,  -2302,  26319,  10828,  -2659,    435,    -10 },
+    {     15,    181,  -2461,  25951,  11390,  -2744,    447,    -11 },
+    {     10,    222,  -2606,  25567,  11955,  -2827,    459,    -12 },
+    {      5,    260,  -2739,  25166,  12524,  -2905,    470,    -13 },
+    {      1,    295,  -2859,  24750,  13095,  -2980,    480,    -14 },
+    {     -2,    327,  -2967,  24318,  13668,  -3051,    490,    -15 },
+    {     -6,    356,  -3063,  23874,  14242,  -3117,    498,    -16 },
+    {     -9,    383,  -3147,  23414,  14817,  -3178,    505,    -17 },
+    {    -11,    407,  -3220,  22942,  15391,  -3233,    510,    -18 },
+    {    -13,    429,  -3281,  22455,  15964,  -3283,    515,    -18 },
+    {    -15,    448,  -3332,  21959,  16535,  -3326,    518,    -19 },
+    {    -17,    464,  -3372,  21454,  17103,  -3363,    519,    -20 },
+    {    -18,    478,  -3403,  20937,  17668,  -3393,    519,    -20 },
+    {    -19,    490,  -3423,  20410,  18228,  -3415,    517,    -20 },
+    {    -19,    500,  -3434,  19874,  18784,  -3430,    513,    -20 },
+    {    -20,    508,  -3436,  19333,  19331,  -3436,    508,    -20 },
+    {    -20,    513,  -3430,  18784,  19874,  -3434,    500,    -19 },
+    {    -20,    517,  -3415,  18228,  20410,  -3423,    490,    -19 },
+    {    -20,    519,  -3393,  17668,  20937,  -3403,    478,    -18 },
+    {    -20,    519,  -3363,  17103,  21454,  -3372,    464,    -17 },
+    {    -19,    518,  -3326,  16535,  21959,  -3332,    448,    -15 },
+    {    -18,    515,  -3283,  15964,  22455,  -3281,    429,    -13 },
+    {    -18,    510,  -3233,  15391,  22942,  -3220,    407,    -11 },
+    {    -17,    505,  -3178,  14817,  23414,  -3147,    383,     -9 },
+    {    -16,    498,  -3117,  14242,  23874,  -3063,    356,     -6 },
+    {    -15,    490,  -3051,  13668,  24318,  -2967,    327,     -2 },
+    {    -14,    480,  -2980,  13095,  24750,  -2859,    295,      1 },
+    {    -13,    470,  -2905,  12524,  25166,  -2739,    260,      5 },
+    {    -12,    459,  -2827,  11955,  25567,  -2606,    222,     10 },
+    {    -11,    447,  -2744,  11390,  25951,  -2461,    181,     15 },
+    {    -10,    435,  -2659,  10828,  26319,  -2302,    137,     20 },
+    {     -9,    422,  -2571,  10272,  26668,  -2130,     90,     26 },
+    {     -8,    408,  -2480,   9721,  26998,  -1945,     41,     33 },
+    {     -7,    394,  -2388,   9176,  27312,  -1746,    -12,     39 },
+    {     -6,    380,  -2293,   8638,  27604,  -1534,    -68,     47 },
+    {     -5,    365,  -2197,   8107,  27876,  -1307,   -126,     55 },
+    {     -4,    350,  -2101,   7583,  28132,  -1067,   -188,     63 },
+    {     -4,    335,  -2003,   7069,  28364,   -813,   -252,     72 },
+    {     -3,    320,  -1905,   6563,  28577,   -545,   -320,     81 },
+    {     -2,    304,  -1806,   6067,  28767,   -263,   -390,     91 },
+    {     -2,    289,  -1708,   5581,  28936,     34,   -463,    101 },
+    {     -1,    274,  -1610,   5105,  29082,    344,   -538,    112 },
+    {     -1,    259,  -1513,   4640,  29207,    668,   -616,    124 },
+    {     -1,    244,  -1416,   4187,  29310,   1006,   -697,    135 },
+    {      0,    229,  -1321,   3745,  29389,   1358,   -780,    148 },
+    {      0,    215,  -1226,   3315,  29446,   1723,   -865,    160 },
+    {      0,    201,  -1133,   2898,  29480,   2102,   -953,    173 }
+};
+
 //******************************************************************************
 //
 // Basic wav file RIFF header information used to open and read a wav file.
@@ -289,3 +376,498 @@ WavRead(tWavFile *psWavData, unsigned char *pucBuffer, uint32_t ui32Size)
 
     return(ui32Count);
 }
+
+//******************************************************************************
+//
+// This function converts a block of PCM audio to signed 16-bit samples.
+//
+// \param pui8Src is the PCM data, as stored in a .wav file.
+// \param ui32Frames is the number of sample frames to convert.
+// \param ui16SrcBits is the number of bits per sample of the source data,
+// either 8 or 16.
+// \param ui16SrcChannels is the number of channels in the source data.
+// \param pi16Dst is the buffer to fill with the converted samples.
+// \param ui16DstChannels is the number of channels to produce.
+//
+// This function converts unsigned 8-bit or signed little-endian 16-bit PCM
+// data, which is mono or interleaved stereo, into signed 16-bit samples that
+// are either mono or interleaved stereo.  Mono data is duplicated into both
+// output channels and stereo data is mixed down by averaging the channels.
+// Each combination of formats is handled by a dedicated loop.
+//
+// \return None.
+//
+//******************************************************************************
+void
+WavConvert(const uint8_t *pui8Src, uint32_t ui32Frames, uint16_t ui16SrcBits,
+           uint16_t ui16SrcChannels, int16_t *pi16Dst,
+           uint16_t ui16DstChannels)
+{
+    int32_t i32Left, i32Right;
+
+    if(ui16SrcBits == 16)
+    {
+        if(ui16SrcChannels == ui16DstChannels)
+        {
+            //
+            // Same number of channels, so only the byte order is handled.
+            //
+            for(ui32Frames *= ui16SrcChannels; ui32Frames; ui32Frames--)
+            {
+                *pi16Dst++ = (int16_t)(pui8Src[0] | (pui8Src[1] << 8));
+                pui8Src += 2;
+            }
+        }
+        else if(ui16SrcChannels == 1)
+        {
+            //
+            // Mono to stereo.
+            //
+            for(; ui32Frames; ui32Frames--)
+            {
+                i32Left = (int16_t)(pui8Src[0] | (pui8Src[1] << 8));
+                *pi16Dst++ = i32Left;
+                *pi16Dst++ = i32Left;
+                pui8Src += 2;
+            }
+        }
+        else
+        {
+            //
+            // Stereo to mono.
+            //
+            for(; ui32Frames; ui32Frames--)
+            {
+                i32Left = (int16_t)(pui8Src[0] | (pui8Src[1] << 8));
+                i32Right = (int16_t)(pui8Src[2] | (pui8Src[3] << 8));
+                *pi16Dst++ = (i32Left + i32Right) >> 1;
+                pui8Src += 4;
+            }
+        }
+    }
+    else
+    {
+        if(ui16SrcChannels == ui16DstChannels)
+        {
+            //
+            // Same number of channels, so only the sample size is handled.
+            //
+            for(ui32Frames *= ui16SrcChannels; ui32Frames; ui32Frames--)
+            {
+                *pi16Dst++ = (*pui8Src++ - 128) << 8;
+            }
+        }
+        else if(ui16SrcChannels == 1)
+        {
+            //
+            // Mono to stereo.
+            //
+            for(; ui32Frames; ui32Frames--)
+            {
+                i32Left = (*pui8Src++ - 128) << 8;
+                *pi16Dst++ = i32Left;
+                *pi16Dst++ = i32Left;
+            }
+        }
+        else
+        {
+            //
+            // Stereo to mono.
+            //
+            for(; ui32Frames; ui32Frames--)
+            {
+                *pi16Dst++ = (pui8Src[0] + pui8Src[1] - 256) << 7;
+                pui8Src += 2;
+            }
+        }
+    }
+}
+
+//******************************************************************************
+//
+// This function initializes a sample rate converter.
+//
+// \param psResampler is the sample rate converter state.
+// \param ui32InRate is the sample rate of the input data.
+// \param ui32OutRate is the sample rate of the output data.
+// \param ui16NumChannels is the number of interleaved channels, either 1 or 2.
+//
+// This function prepares a polyphase sample rate converter for use by
+// WavResample().  Any pair of rates may be used, as the position of each
+// output sample is tracked with a 16.16 fixed-point accumulator and the
+// nearest of the filter phases is applied.
+//
+// \return None.
+//
+//******************************************************************************
+void
+WavResampleInit(tWavResampler *psResampler, uint32_t ui32InRate,
+                uint32_t ui32OutRate, uint16_t ui16NumChannels)
+{
+    uint32_t ui32Idx;
+
+    //
+    // Compute the distance between output samples in input samples, rounded
+    // to the nearest 1/65536th of a sample.
+    //
+    psResampler->ui32Step = (uint32_t)((((uint64_t)ui32InRate << 16) +
+                                        (ui32OutRate / 2)) / ui32OutRate);
+    psResampler->ui32Position = 0;
+    psResampler->ui16NumChannels = ui16NumChannels;
+
+    //
+    // Start with silence in the history.
+    //
+    for(ui32Idx = 0; ui32Idx < WAV_RESAMPLE_TAPS; ui32Idx++)
+    {
+        psResampler->ppi16History[0][ui32Idx] = 0;
+        psResampler->ppi16History[1][ui32Idx] = 0;
+    }
+}
+
+//******************************************************************************
+//
+// This function converts the sample rate of a block of audio.
+//
+// \param psResampler is the sample rate converter state.
+// \param pi16In is the input samples.
+// \param ui32InFrames is the number of input sample frames available.
+// \param pui32Used is filled with the number of input frames consumed.
+// \param pi16Out is the buffer to fill with output samples.
+// \param ui32OutFrames is the number of output sample frames requested.
+//
+// This function produces output samples until either the output buffer is
+// full or all of the input has been consumed.  Any input that is not consumed
+// must be passed in again on the next call.  The filter history is carried
+// from call to call, so a stream can be converted in blocks of any size.
+//
+// \return This function returns the number of output frames produced.
+//
+//******************************************************************************
+uint32_t
+WavResample(tWavResampler *psResampler, const int16_t *pi16In,
+            uint32_t ui32InFrames, uint32_t *pui32Used, int16_t *pi16Out,
+            uint32_t ui32OutFrames)
+{
+    const int16_t *pi16Coef;
+    uint32_t ui32Used, ui32Count, ui32Chan, ui32Idx, ui32Position;
+    int32_t i32Acc;
+    int16_t *pi16History;
+
+    ui32Used = 0;
+    ui32Position = psResampler->ui32Position;
+
+    for(ui32Count = 0; ui32Count < ui32OutFrames; ui32Count++)
+    {
+        //
+        // Move the history forward until the next output sample lies
+        // between the two middle samples.
+        //
+        while(ui32Position >= 0x10000)
+        {
+            if(ui32Used == ui32InFrames)
+            {
+                goto done;
+            }
+            for(ui32Chan = 0; ui32Chan < psResampler->ui16NumChannels;
+                ui32Chan++)
+            {
+                pi16History = psResampler->ppi16History[ui32Chan];
+                for(ui32Idx = 0; ui32Idx < (WAV_RESAMPLE_TAPS - 1); ui32Idx++)
+                {
+                    pi16History[ui32Idx] = pi16History[ui32Idx + 1];
+                }
+                pi16History[WAV_RESAMPLE_TAPS - 1] = *pi16In++;
+            }
+            ui32Used++;
+            ui32Position -= 0x10000;
+        }
+
+        //
+        // Apply the filter phase nearest to the output sample's position.
+        //
+        pi16Coef = g_ppi16ResampleFilter[ui32Position >> 10];
+        for(ui32Chan = 0; ui32Chan < psResampler->ui16NumChannels; ui32Chan++)
+        {
+            pi16History = psResampler->ppi16History[ui32Chan];
+            for(i32Acc = 16384, ui32Idx = 0; ui32Idx < WAV_RESAMPLE_TAPS;
+                ui32Idx++)
+            {
+                i32Acc += pi16History[ui32Idx] * pi16Coef[ui32Idx];
+            }
+            i32Acc >>= 15;
+
+            //
+            // Saturate the result, since the filter can overshoot.
+            //
+            if(i32Acc > 32767)
+            {
+                i32Acc = 32767;
+            }
+            else if(i32Acc < -32768)
+            {
+                i32Acc = -32768;
+            }
+            *pi16Out++ = i32Acc;
+        }
+
+        //
+        // Advance to the position of the next output sample.
+        //
+        ui32Position += psResampler->ui32Step;
+    }
+
+done:
+    psResampler->ui32Position = ui32Position;
+    *pui32Used = ui32Used;
+    return(ui32Count);
+}
+
+//******************************************************************************
+//
+// This function prepares a .wav file for double-buffered streaming.
+//
+// \param psStream is the structure used to hold the stream state.
+// \param psWavData is a file that was opened with WavOpen().
+// \param pui8Buffer is the memory used for the two stream buffers.
+// \param ui32Size is the size of each of the two buffers in bytes, so
+// \e pui8Buffer must be twice this size.
+// \param ui16OutChannels is the number of channels to produce, either 1 or 2.
+// \param ui32OutRate is the sample rate to produce.
+//
+// This function sets up streaming of a PCM .wav file to a fixed output
+// format.  WavStreamFill() reads the file into whichever of the two buffers
+// is empty and should be called regularly from the main loop, while
+// WavStreamRead() converts the buffered data into signed 16-bit samples at
+// the output rate and can be called from the audio interrupt handler.  With
+// one buffer being played while the other is refilled, reading from the file
+// system never stalls playback.
+//
+// \return A value of zero indicates success and any other value indicates
+// that the file's format is not supported.
+//
+//******************************************************************************
+int
+WavStreamInit(tWavStream *psStream, tWavFile *psWavData, uint8_t *pui8Buffer,
+              uint32_t ui32Size, uint16_t ui16OutChannels,
+              uint32_t ui32OutRate)
+{
+    tWavHeader *psHeader;
+
+    psHeader = &psWavData->sWavHeader;
+
+    //
+    // Only 8 and 16-bit PCM, mono or stereo, is supported.
+    //
+    if((psHeader->ui16Format != RIFF_FORMAT_PCM) ||
+       ((psHeader->ui16BitsPerSample != 8) &&
+        (psHeader->ui16BitsPerSample != 16)) ||
+       (psHeader->ui16NumChannels < 1) || (psHeader->ui16NumChannels > 2) ||
+       (ui16OutChannels < 1) || (ui16OutChannels > 2) ||
+       (psHeader->ui32SampleRate == 0) || (ui32OutRate == 0))
+    {
+        return(-1);
+    }
+
+    //
+    // Each buffer holds a whole number of frames, and no more than can be
+    // returned by a single call to WavRead().
+    //
+    psStream->ui16FrameBytes = ((psHeader->ui16BitsPerSample / 8) *
+                                psHeader->ui16NumChannels);
+    if(ui32Size > 0xffff)
+    {
+        ui32Size = 0xffff;
+    }
+    ui32Size -= ui32Size % psStream->ui16FrameBytes;
+    if(ui32Size == 0)
+    {
+        return(-1);
+    }
+
+    psStream->psWavFile = psWavData;
+    psStream->ppui8Buffer[0] = pui8Buffer;
+    psStream->ppui8Buffer[1] = pui8Buffer + ui32Size;
+    psStream->ui32BufferSize = ui32Size;
+    psStream->pui32Fill[0] = 0;
+    psStream->pui32Fill[1] = 0;
+    psStream->ui32Current = 0;
+    psStream->ui32Offset = 0;
+    psStream->ui32FillIndex = 0;
+    psStream->ui32DataRemaining = psHeader->ui32DataSize;
+    psStream->ui16OutChannels = ui16OutChannels;
+
+    //
+    // Set up the sample rate converter if the file is not at the output
+    // rate.
+    //
+    psStream->ui32Resample = (psHeader->ui32SampleRate != ui32OutRate);
+    if(psStream->ui32Resample)
+    {
+        WavResampleInit(&psStream->sResampler, psHeader->ui32SampleRate,
+                        ui32OutRate, ui16OutChannels);
+    }
+
+    return(0);
+}
+
+//******************************************************************************
+//
+// This function refills the empty buffers of a wav stream.
+//
+// \param psStream is the stream state.
+//
+// This function reads the next block of the file into each buffer that has
+// been fully played, in playback order.  It must not be called from the audio
+// interrupt handler since it reads from the file system.
+//
+// \return None.
+//
+//******************************************************************************
+void
+WavStreamFill(tWavStream *psStream)
+{
+    uint32_t ui32Count;
+
+    while((psStream->pui32Fill[psStream->ui32FillIndex] == 0) &&
+          (psStream->ui32DataRemaining != 0))
+    {
+        //
+        // Read the next block, stopping at the end of the data chunk.
+        //
+        ui32Count = psStream->ui32BufferSize;
+        if(ui32Count > psStream->ui32DataRemaining)
+        {
+            ui32Count = psStream->ui32DataRemaining;
+        }
+        ui32Count = WavRead(psStream->psWavFile,
+                            psStream->ppui8Buffer[psStream->ui32FillIndex],
+                            ui32Count);
+        ui32Count -= ui32Count % psStream->ui16FrameBytes;
+
+        //
+        // Treat a failed or short read as the end of the file.
+        //
+        if(ui32Count == 0)
+        {
+            psStream->ui32DataRemaining = 0;
+            break;
+        }
+        psStream->ui32DataRemaining -= ui32Count;
+
+        //
+        // Hand the buffer over to WavStreamRead().
+        //
+        psStream->pui32Fill[psStream->ui32FillIndex] = ui32Count;
+        psStream->ui32FillIndex ^= 1;
+    }
+}
+
+//******************************************************************************
+//
+// This function reads converted samples from a wav stream.
+//
+// \param psStream is the stream state.
+// \param pi16Out is the buffer to fill with signed 16-bit samples.
+// \param ui32Frames is the number of sample frames requested.
+//
+// This function converts buffered data from the file to the output format
+// and sample rate chosen in WavStreamInit().  Buffers are released for
+// refilling by WavStreamFill() as soon as they have been consumed.
+//
+// \return This function returns the number of frames written to
+// \e pi16Out, which is less than \e ui32Frames if the buffers have run dry.
+//
+//******************************************************************************
+uint32_t
+WavStreamRead(tWavStream *psStream, int16_t *pi16Out, uint32_t ui32Frames)
+{
+    int16_t pi16Chunk[WAV_STREAM_CHUNK * 2];
+    tWavHeader *psHeader;
+    uint32_t ui32Produced, ui32Avail, ui32In, ui32Used;
+    const uint8_t *pui8Src;
+
+    psHeader = &psStream->psWavFile->sWavHeader;
+    ui32Produced = 0;
+
+    while(ui32Produced < ui32Frames)
+    {
+        //
+        // Stop if the current buffer has not been filled yet.
+        //
+        ui32Avail = psStream->pui32Fill[psStream->ui32Current];
+        if(ui32Avail == 0)
+        {
+            break;
+        }
+        pui8Src = (psStream->ppui8Buffer[psStream->ui32Current] +
+                   psStream->ui32Offset);
+        ui32In = (ui32Avail - psStream->ui32Offset) / psStream->ui16FrameBytes;
+
+        if(psStream->ui32Resample)
+        {
+            //
+            // Convert a chunk of the input and pass it through the sample
+            // rate converter.
+            //
+            if(ui32In > WAV_STREAM_CHUNK)
+            {
+                ui32In = WAV_STREAM_CHUNK;
+            }
+            WavConvert(pui8Src, ui32In, psHeader->ui16BitsPerSample,
+                       psHeader->ui16NumChannels, pi16Chunk,
+                       psStream->ui16OutChannels);
+            ui32Produced += WavResample(&psStream->sResampler, pi16Chunk,
+                                        ui32In, &ui32Used,
+                                        (pi16Out + (ui32Produced *
+                                                    psStream->ui16OutChannels)),
+                                        ui32Frames - ui32Produced);
+        }
+        else
+        {
+            //
+            // Convert directly into the output buffer.
+            //
+            ui32Used = ui32Frames - ui32Produced;
+            if(ui32Used > ui32In)
+            {
+                ui32Used = ui32In;
+            }
+            WavConvert(pui8Src, ui32Used, psHeader->ui16BitsPerSample,
+                       psHeader->ui16NumChannels,
+                       pi16Out + (ui32Produced * psStream->ui16OutChannels),
+                       psStream->ui16OutChannels);
+            ui32Produced += ui32Used;
+        }
+
+        //
+        // Release the buffer once all of it has been consumed.
+        //
+        psStream->ui32Offset += ui32Used * psStream->ui16FrameBytes;
+        if(psStream->ui32Offset == ui32Avail)
+        {
+            psStream->ui32Offset = 0;
+            psStream->pui32Fill[psStream->ui32Current] = 0;
+            psStream->ui32Current ^= 1;
+        }
+    }
+
+    return(ui32Produced);
+}
+
+//******************************************************************************
+//
+// This function determines whether a wav stream has finished.
+//
+// \param psStream is the stream state.
+//
+// \return A non-zero value if all of the audio data has been read from the
+// file and played, or zero otherwise.
+//
+//******************************************************************************
+int
+WavStreamDone(tWavStream *psStream)
+{
+    return((psStream->ui32DataRemaining == 0) &&
+           (psStream->pui32Fill[0] == 0) && (psStream->pui32Fill[1] == 0));
+}
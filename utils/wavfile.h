@@ -88,10 +88,132 @@ typedef struct
     uint32_t ui32Flags;
 } tWavFile;
 
+//*****************************************************************************
+//
+// The number of filter taps and phases used by the sample rate converter.
+//
+//*****************************************************************************
+#define WAV_RESAMPLE_TAPS       8
+#define WAV_RESAMPLE_PHASES     64
+
+//*****************************************************************************
+//
+// The structure used to hold the state of the sample rate converter.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The distance between output samples, measured in input samples, in
+    // 16.16 fixed-point format.
+    //
+    uint32_t ui32Step;
+
+    //
+    // The position of the next output sample relative to the newest input
+    // sample in the history, in 16.16 fixed-point format.
+    //
+    uint32_t ui32Position;
+
+    //
+    // The number of interleaved audio channels.
+    //
+    uint16_t ui16NumChannels;
+
+    //
+    // The most recent input samples for each channel, oldest first.
+    //
+    int16_t ppi16History[2][WAV_RESAMPLE_TAPS];
+}
+tWavResampler;
+
+//*****************************************************************************
+//
+// The structure used to hold the state of a double-buffered wav stream.
+//
+//*****************************************************************************
+typedef struct
+{
+    //
+    // The wav file that is being streamed.
+    //
+    tWavFile *psWavFile;
+
+    //
+    // The two buffers holding raw data read from the file.
+    //
+    uint8_t *ppui8Buffer[2];
+
+    //
+    // The size of each of the buffers in bytes, which is a whole number of
+    // sample frames.
+    //
+    uint32_t ui32BufferSize;
+
+    //
+    // The number of bytes held in each buffer, or zero if the buffer is
+    // empty and waiting to be refilled.
+    //
+    volatile uint32_t pui32Fill[2];
+
+    //
+    // The buffer that is currently being played and the offset of the next
+    // byte to be played within it.
+    //
+    uint32_t ui32Current;
+    uint32_t ui32Offset;
+
+    //
+    // The buffer that is to be filled next.
+    //
+    uint32_t ui32FillIndex;
+
+    //
+    // The number of bytes of audio data left to be read from the file.
+    //
+    uint32_t ui32DataRemaining;
+
+    //
+    // The number of bytes in each sample frame of the file.
+    //
+    uint16_t ui16FrameBytes;
+
+    //
+    // The number of channels to produce.
+    //
+    uint16_t ui16OutChannels;
+
+    //
+    // Non-zero if the sample rate of the file must be converted.
+    //
+    uint32_t ui32Resample;
+
+    //
+    // The sample rate converter.
+    //
+    tWavResampler sResampler;
+}
+tWavStream;
+
 void WavGetFormat(tWavFile *psWavData, tWavHeader *psWaveHeader);
 int WavOpen(const char *pcFileName, tWavFile *psWavData);
 void WavClose(tWavFile *psWavData);
 uint16_t WavRead(tWavFile *psWavData, unsigned char *pucBuffer,
                         uint32_t ui32Size);
+void WavConvert(const uint8_t *pui8Src, uint32_t ui32Frames,
+                uint16_t ui16SrcBits, uint16_t ui16SrcChannels,
+                int16_t *pi16Dst, uint16_t ui16DstChannels);
+void WavResampleInit(tWavResampler *psResampler, uint32_t ui32InRate,
+                     uint32_t ui32OutRate, uint16_t ui16NumChannels);
+uint32_t WavResample(tWavResampler *psResampler, const int16_t *pi16In,
+                     uint32_t ui32InFrames, uint32_t *pui32Used,
+                     int16_t *pi16Out, uint32_t ui32OutFrames);
+int WavStreamInit(tWavStream *psStream, tWavFile *psWavData,
+                  uint8_t *pui8Buffer, uint32_t ui32Size,
+                  uint16_t ui16OutChannels, uint32_t ui32OutRate);
+void WavStreamFill(tWavStream *psStream);
+uint32_t WavStreamRead(tWavStream *psStream, int16_t *pi16Out,
+                       uint32_t ui32Frames);
+int WavStreamDone(tWavStream *psStream);
 
 #endif